@@ -2072,8 +2072,11 @@ void _clem_adb_glu_command(struct ClemensDeviceADB *adb) {
 }
 
 void clem_gameport_sync(struct ClemensDeviceGameport *gameport, struct ClemensClock *clocks) {
-    clem_clocks_duration_t dt_clocks = clocks->ts - gameport->ts_last_frame;
-    unsigned delta_ns = (unsigned)(clem_calc_ns_step_from_clocks(dt_clocks));
+    //  with lazy syncs the interval can span seconds, so it's kept in 64 bits and
+    //  clamped to the longest paddle timer
+    uint64_t dt_clocks = clocks->ts - gameport->ts_last_frame;
+    uint64_t dt_ns = (dt_clocks * CLEM_14MHZ_CYCLE_NS) / CLEM_CLOCKS_14MHZ_CYCLE;
+    unsigned delta_ns = dt_ns < UINT32_MAX ? (unsigned)dt_ns : UINT32_MAX;
     int paddle_index;
     uint32_t charge_time;
     for (paddle_index = 0; paddle_index < 4; ++paddle_index) {
@@ -2099,6 +2102,31 @@ void clem_gameport_sync(struct ClemensDeviceGameport *gameport, struct ClemensCl
     gameport->ts_last_frame = clocks->ts;
 }
 
+clem_clocks_time_t clem_gameport_next_event_ts(struct ClemensDeviceGameport *gameport) {
+    uint32_t charge_time = UINT32_MAX;
+    int paddle_index;
+    for (paddle_index = 0; paddle_index < 4; ++paddle_index) {
+        if (!gameport->paddle_timer_state[paddle_index])
+            continue;
+        if (gameport->paddle_timer_ns[paddle_index] < charge_time) {
+            charge_time = gameport->paddle_timer_ns[paddle_index];
+        }
+    }
+    if (charge_time == UINT32_MAX) {
+        return CLEM_TIME_NEVER;
+    }
+    //  +1 ns accounts for truncation when sync() converts clocks back to ns
+    return gameport->ts_last_frame + clem_calc_clocks_step_from_ns(charge_time + 1);
+}
+
+uint32_t clem_adb_glu_next_event_us(struct ClemensDeviceADB *adb) {
+    //  command data is consumed one byte per sync
+    if (adb->state == CLEM_ADB_STATE_CMD_DATA || adb->irq_dispatch) {
+        return 0;
+    }
+    return CLEM_MEGA2_CYCLES_PER_60TH - adb->poll_timer_us;
+}
+
 void clem_adb_glu_sync(struct ClemensDeviceADB *adb, struct ClemensDeviceMega2Memory *m2mem,
                        uint32_t delta_us) {
     adb->poll_timer_us += delta_us;
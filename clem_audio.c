@@ -6,6 +6,13 @@
 #include <math.h>
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLEM_AUDIO_SSE2 1
+#include <emmintrin.h>
+#else
+#define CLEM_AUDIO_SSE2 0
+#endif
+
 /**
  * @brief Sound GLU emulation
  *
@@ -103,6 +110,8 @@
 */
 
 #define CLEM_ENSONIQ_OSC_LIMIT        32
+/* syncs shorter than this many passes through the oscillators run cycle by cycle */
+#define CLEM_ENSONIQ_ANALYTIC_PASSES 4
 #define CLEM_ENSONIQ_REG_OSC_OIR_MASK 0xbe // ~(01000001) are always on and unchanged
 
 static uint16_t s_ensoniq_ptr_bits_mask[8] = {0xff00, 0xfe00, 0xfc00, 0xf800,
@@ -186,10 +195,9 @@ void _clem_ensoniq_reset_osc(struct ClemensDeviceEnsoniq *doc, unsigned osc_inde
     doc->osc_flags[osc_index] &= ~CLEM_ENSONIQ_OSC_FLAG_CYCLE;
 }
 
-static inline uint16_t _clem_ensoniq_calc_waveform_ptr(struct ClemensDeviceEnsoniq *doc,
-                                                       unsigned osc_index) {
-
-    unsigned acc = doc->acc[osc_index] & 0x00ffffff; // 24-bit
+static inline uint16_t _clem_ensoniq_calc_waveform_ptr_acc(struct ClemensDeviceEnsoniq *doc,
+                                                           unsigned osc_index, unsigned acc) {
+    acc &= 0x00ffffff; // 24-bit
     unsigned size = ((doc->reg[CLEM_ENSONIQ_REG_OSC_SIZE + osc_index] >> 3) & 0x07);
     unsigned resolution = (doc->reg[CLEM_ENSONIQ_REG_OSC_SIZE + osc_index] & 0x07) + 1;
     uint16_t ptr = ((uint16_t)doc->reg[CLEM_ENSONIQ_REG_OSC_PTR + osc_index]) << 8;
@@ -204,6 +212,11 @@ static inline uint16_t _clem_ensoniq_calc_waveform_ptr(struct ClemensDeviceEnson
     return ptr;
 }
 
+static inline uint16_t _clem_ensoniq_calc_waveform_ptr(struct ClemensDeviceEnsoniq *doc,
+                                                       unsigned osc_index) {
+    return _clem_ensoniq_calc_waveform_ptr_acc(doc, osc_index, doc->acc[osc_index]);
+}
+
 uint8_t clem_ensoniq_oscillator_cycle(struct ClemensDeviceEnsoniq *doc, unsigned osc_index,
                                       unsigned osc_limit, uint8_t ctl) {
     //  Data is read from sound RAM and sent to one of up to eight output channels
@@ -254,37 +267,266 @@ uint8_t clem_ensoniq_oscillator_cycle(struct ClemensDeviceEnsoniq *doc, unsigned
     return ctl;
 }
 
-uint32_t clem_ensoniq_sync(struct ClemensDeviceEnsoniq *doc, clem_clocks_duration_t dt_clocks) {
-    // 1 oscillator x 2 at minimum enabled - i.e. we always enable 2 by default
+static void _clem_ensoniq_cycle(struct ClemensDeviceEnsoniq *doc, unsigned osc_cycle,
+                                unsigned osc_cnt) {
+    uint8_t ctl = doc->reg[CLEM_ENSONIQ_REG_OSC_CTRL + osc_cycle];
+    if (ctl & CLEM_ENSONIQ_OSC_CTL_HALT) {
+        if (ctl & CLEM_ENSONIQ_OSC_CTL_M0) {
+            //  Pg. 7 Cortland spec (M0 = HALT = 1)
+            _clem_ensoniq_reset_osc(doc, osc_cycle);
+        }
+    } else {
+        ctl = clem_ensoniq_oscillator_cycle(doc, osc_cycle, osc_cnt, ctl);
+        //  Pg. 6 Cortland spec (IE = 1, CYCLE DONE)
+        if (ctl & CLEM_ENSONIQ_OSC_CTL_IE) {
+            if (doc->osc_flags[osc_cycle] & CLEM_ENSONIQ_OSC_FLAG_CYCLE) {
+                _clem_ensoniq_set_irq(doc, osc_cycle);
+            }
+        }
+    }
+    doc->reg[CLEM_ENSONIQ_REG_OSC_CTRL + osc_cycle] = ctl;
+}
+
+//  The waveform pointer is the table base OR'd with bits of the accumulator.  Within
+//  the accumulator's period (2^(16 + resolution)) the pointer only increases, so a
+//  running oscillator wraps exactly once per period.
+static inline unsigned _clem_ensoniq_acc_period(struct ClemensDeviceEnsoniq *doc,
+                                                unsigned osc_index) {
+    return 1U << ((doc->reg[CLEM_ENSONIQ_REG_OSC_SIZE + osc_index] & 0x07) + 17);
+}
+
+static inline unsigned _clem_ensoniq_freq(struct ClemensDeviceEnsoniq *doc, unsigned osc_index) {
+    return (((unsigned)doc->reg[CLEM_ENSONIQ_REG_OSC_FCHI + osc_index]) << 8) |
+           doc->reg[CLEM_ENSONIQ_REG_OSC_FCLOW + osc_index];
+}
+
+//  the waveform pointer after 'visits' more cycles
+static inline uint16_t _clem_ensoniq_calc_waveform_ptr_at(struct ClemensDeviceEnsoniq *doc,
+                                                          unsigned osc_index, uint64_t visits) {
+    return _clem_ensoniq_calc_waveform_ptr_acc(
+        doc, osc_index,
+        (unsigned)(doc->acc[osc_index] + visits * _clem_ensoniq_freq(doc, osc_index)));
+}
+
+//  Returns the number of cycles an oscillator runs until the cycle that wraps its
+//  waveform (1 = the next cycle) or 0 if it never wraps
+static uint64_t _clem_ensoniq_cycles_to_wrap(struct ClemensDeviceEnsoniq *doc,
+                                             unsigned osc_index) {
+    unsigned freq = _clem_ensoniq_freq(doc, osc_index);
+    unsigned period, phase;
+    if (_clem_ensoniq_calc_waveform_ptr(doc, osc_index) < doc->ptr[osc_index])
+        return 1;
+    if (!freq)
+        return 0;
+    //  after the first cycle, the pointer wraps on the cycle after the accumulator
+    //  crosses its period
+    period = _clem_ensoniq_acc_period(doc, osc_index);
+    phase = doc->acc[osc_index] & (period - 1);
+    return 1 + (period - phase + freq - 1) / freq;
+}
+
+//  Returns the first of the next 'limit' cycles of an oscillator that can't be
+//  stepped analytically (1 = the next cycle) or 0 if none.  These are wraps, reads of
+//  a zero byte from the wavetable (halt), interrupts and M0 + HALT resets.
+static uint64_t _clem_ensoniq_next_event(struct ClemensDeviceEnsoniq *doc, unsigned osc_index,
+                                         uint64_t limit) {
+    uint8_t ctl = doc->reg[CLEM_ENSONIQ_REG_OSC_CTRL + osc_index];
+    const uint8_t *zero;
+    uint64_t wrap, last, visit;
+    unsigned freq, phase, size, shift, zero_phase;
+    uint16_t ptr, ptr_last;
+
+    if (!limit)
+        return 0;
+    if (ctl & CLEM_ENSONIQ_OSC_CTL_HALT) {
+        if ((ctl & CLEM_ENSONIQ_OSC_CTL_M0) &&
+            (doc->acc[osc_index] || doc->ptr[osc_index] ||
+             (doc->osc_flags[osc_index] & CLEM_ENSONIQ_OSC_FLAG_CYCLE)))
+            return 1;
+        return 0;
+    }
+    if ((ctl & CLEM_ENSONIQ_OSC_CTL_IE) &&
+        (doc->osc_flags[osc_index] & CLEM_ENSONIQ_OSC_FLAG_CYCLE))
+        return 1;
+    ptr = _clem_ensoniq_calc_waveform_ptr(doc, osc_index);
+    if (ptr < doc->ptr[osc_index] || !doc->sound_ram[ptr])
+        return 1;
+    freq = _clem_ensoniq_freq(doc, osc_index);
+    if (!freq)
+        return 0;
+
+    //  cycles up to the wrap read an ascending range of the wavetable - a zero byte
+    //  in that range halts the oscillator if a cycle lands on it
+    wrap = _clem_ensoniq_cycles_to_wrap(doc, osc_index);
+    last = wrap - 1 < limit ? wrap - 1 : limit;
+    ptr_last = _clem_ensoniq_calc_waveform_ptr_at(doc, osc_index, last - 1);
+    phase = doc->acc[osc_index] & (_clem_ensoniq_acc_period(doc, osc_index) - 1);
+    size = (doc->reg[CLEM_ENSONIQ_REG_OSC_SIZE + osc_index] >> 3) & 0x07;
+    shift = (doc->reg[CLEM_ENSONIQ_REG_OSC_SIZE + osc_index] & 0x07) + 9 - size;
+    while ((zero = memchr(doc->sound_ram + ptr, 0, ptr_last - ptr + 1)) != NULL) {
+        //  the first cycle whose pointer is at or past the zero byte
+        zero_phase = ((unsigned)(zero - doc->sound_ram) & ((1U << (8 + size)) - 1)) << shift;
+        visit = 1 + (zero_phase - phase + freq - 1) / freq;
+        ptr = _clem_ensoniq_calc_waveform_ptr_at(doc, osc_index, visit - 1);
+        if (!doc->sound_ram[ptr])
+            return visit;
+    }
+    return wrap <= limit ? wrap : 0;
+}
+
+//  Steps an oscillator through 'visits' cycles that have no events (see
+//  _clem_ensoniq_next_event)
+static void _clem_ensoniq_advance(struct ClemensDeviceEnsoniq *doc, unsigned osc_index,
+                                  uint64_t visits) {
+    uint16_t ptr;
+    if (!visits || (doc->reg[CLEM_ENSONIQ_REG_OSC_CTRL + osc_index] & CLEM_ENSONIQ_OSC_CTL_HALT))
+        return;
+    ptr = _clem_ensoniq_calc_waveform_ptr_at(doc, osc_index, visits - 1);
+    doc->ptr[osc_index] = ptr;
+    doc->reg[CLEM_ENSONIQ_REG_OSC_DATA + osc_index] = doc->sound_ram[ptr];
+    doc->acc[osc_index] = (unsigned)((doc->acc[osc_index] +
+                                      visits * _clem_ensoniq_freq(doc, osc_index)) &
+                                     0x00ffffff);
+}
+
+static inline uint64_t _clem_ensoniq_visits_before(uint64_t next_visit, uint64_t cycle,
+                                                   unsigned osc_cnt_2) {
+    return next_visit < cycle ? (cycle - next_visit + osc_cnt_2 - 1) / osc_cnt_2 : 0;
+}
+
+//  the cycle of the oscillator's next event before 'cycles' or UINT64_MAX
+static uint64_t _clem_ensoniq_event_cycle(struct ClemensDeviceEnsoniq *doc, unsigned osc_index,
+                                          uint64_t next_visit, unsigned cycles,
+                                          unsigned osc_cnt_2) {
+    uint64_t event = _clem_ensoniq_next_event(
+        doc, osc_index, _clem_ensoniq_visits_before(next_visit, cycles, osc_cnt_2));
+    return event ? next_visit + (event - 1) * osc_cnt_2 : UINT64_MAX;
+}
+
+//  Runs 'cycles' DOC cycles (one oscillator per cycle.)  Oscillators are stepped
+//  analytically between events, which are run in cycle order so that interrupts are
+//  stacked and swap/sync modes affect their partner as if cycled one at a time.
+static void _clem_ensoniq_run(struct ClemensDeviceEnsoniq *doc, unsigned cycles) {
     unsigned osc_cnt = (doc->reg[CLEM_ENSONIQ_REG_OSC_ENABLE] >> 1) + 1;
     unsigned osc_cnt_2 = osc_cnt + 2;
+    unsigned osc_first = doc->cycle % osc_cnt_2;
+    uint64_t next_visit[CLEM_ENSONIQ_OSC_LIMIT];
+    uint64_t next_event[CLEM_ENSONIQ_OSC_LIMIT];
+    uint64_t event, visits;
+    unsigned osc_index, osc_event, osc_other;
+
+    //  an enable value of 64 adds a cycle without a 33rd oscillator
+    if (osc_cnt > CLEM_ENSONIQ_OSC_LIMIT) {
+        osc_cnt = CLEM_ENSONIQ_OSC_LIMIT;
+    }
+    //  a few passes through the oscillators are cheaper to run one cycle at a time
+    if (cycles < osc_cnt_2 * CLEM_ENSONIQ_ANALYTIC_PASSES) {
+        for (; cycles > 0; --cycles) {
+            osc_index = doc->cycle % osc_cnt_2;
+            if (osc_index < osc_cnt) {
+                _clem_ensoniq_cycle(doc, osc_index, osc_cnt);
+            }
+            ++doc->cycle;
+        }
+        return;
+    }
+    //  cycle positions are relative to doc->cycle
+    for (osc_index = 0; osc_index < osc_cnt; ++osc_index) {
+        next_visit[osc_index] = (osc_index + osc_cnt_2 - osc_first) % osc_cnt_2;
+        next_event[osc_index] =
+            _clem_ensoniq_event_cycle(doc, osc_index, next_visit[osc_index], cycles, osc_cnt_2);
+    }
+    for (;;) {
+        event = UINT64_MAX;
+        osc_event = 0;
+        for (osc_index = 0; osc_index < osc_cnt; ++osc_index) {
+            if (next_event[osc_index] < event) {
+                event = next_event[osc_index];
+                osc_event = osc_index;
+            }
+        }
+        if (event == UINT64_MAX)
+            break;
+        //  the partner oscillator is brought up to this cycle since the event may
+        //  halt, restart or reset it
+        _clem_ensoniq_advance(doc, osc_event, (event - next_visit[osc_event]) / osc_cnt_2);
+        osc_other = osc_event ^ 1;
+        if (osc_other < osc_cnt) {
+            visits = _clem_ensoniq_visits_before(next_visit[osc_other], event, osc_cnt_2);
+            _clem_ensoniq_advance(doc, osc_other, visits);
+            next_visit[osc_other] += visits * osc_cnt_2;
+        }
+        _clem_ensoniq_cycle(doc, osc_event, osc_cnt);
+        next_visit[osc_event] = event + osc_cnt_2;
+        next_event[osc_event] =
+            _clem_ensoniq_event_cycle(doc, osc_event, next_visit[osc_event], cycles, osc_cnt_2);
+        if (osc_other < osc_cnt) {
+            next_event[osc_other] = _clem_ensoniq_event_cycle(doc, osc_other,
+                                                              next_visit[osc_other], cycles,
+                                                              osc_cnt_2);
+        }
+    }
+    for (osc_index = 0; osc_index < osc_cnt; ++osc_index) {
+        visits = _clem_ensoniq_visits_before(next_visit[osc_index], cycles, osc_cnt_2);
+        _clem_ensoniq_advance(doc, osc_index, visits);
+    }
+    doc->cycle += cycles;
+}
 
-    doc->dt_budget += dt_clocks;
+//  Returns the number of passes through the oscillators, starting at the beginning
+//  of a pass, until the pass that may change the mix (1 = the next pass) or 0 if
+//  none will.  An oscillator's DATA only changes when its waveform pointer moves
+//  (wraps included) or on its next cycle if its byte in sound RAM changed.  Halted
+//  oscillators are silent until the pointer of a partner in swap mode wraps.
+static unsigned _clem_ensoniq_passes_to_change(struct ClemensDeviceEnsoniq *doc) {
+    unsigned osc_cnt = (doc->reg[CLEM_ENSONIQ_REG_OSC_ENABLE] >> 1) + 1;
+    unsigned passes = 0;
+    unsigned osc_index, freq, shift, phase, visits;
+    uint16_t ptr;
 
-    while (doc->dt_budget >= CLEM_ENSONIQ_CLOCKS_PER_CYCLE) {
-        // 2 extra cycles after running through all active oscillators
-        unsigned osc_cycle = doc->cycle % osc_cnt_2;
-        if (osc_cycle < osc_cnt) {
-            uint8_t ctl = doc->reg[CLEM_ENSONIQ_REG_OSC_CTRL + osc_cycle];
-            if (ctl & CLEM_ENSONIQ_OSC_CTL_HALT) {
-                if (ctl & CLEM_ENSONIQ_OSC_CTL_M0) {
-                    //  Pg. 7 Cortland spec (M0 = HALT = 1)
-                    _clem_ensoniq_reset_osc(doc, osc_cycle);
-                }
-            } else {
-                ctl = clem_ensoniq_oscillator_cycle(doc, osc_cycle, osc_cnt, ctl);
-                //  Pg. 6 Cortland spec (IE = 1, CYCLE DONE)
-                if (ctl & CLEM_ENSONIQ_OSC_CTL_IE) {
-                    if (doc->osc_flags[osc_cycle] & CLEM_ENSONIQ_OSC_FLAG_CYCLE) {
-                        _clem_ensoniq_set_irq(doc, osc_cycle);
-                    }
-                }
-            }
-            doc->reg[CLEM_ENSONIQ_REG_OSC_CTRL + osc_cycle] = ctl;
+    if (osc_cnt > CLEM_ENSONIQ_OSC_LIMIT) {
+        osc_cnt = CLEM_ENSONIQ_OSC_LIMIT;
+    }
+    for (osc_index = 0; osc_index < osc_cnt; ++osc_index) {
+        if (doc->reg[CLEM_ENSONIQ_REG_OSC_CTRL + osc_index] & CLEM_ENSONIQ_OSC_CTL_HALT)
+            continue;
+        ptr = _clem_ensoniq_calc_waveform_ptr(doc, osc_index);
+        if (ptr != doc->ptr[osc_index] ||
+            doc->sound_ram[ptr] != doc->reg[CLEM_ENSONIQ_REG_OSC_DATA + osc_index])
+            return 1;
+        freq = _clem_ensoniq_freq(doc, osc_index);
+        if (!freq)
+            continue;
+        //  the pointer moves on the cycle after the accumulator crosses the next
+        //  multiple of the pointer's lowest bit
+        shift = (doc->reg[CLEM_ENSONIQ_REG_OSC_SIZE + osc_index] & 0x07) + 9 -
+                ((doc->reg[CLEM_ENSONIQ_REG_OSC_SIZE + osc_index] >> 3) & 0x07);
+        phase = doc->acc[osc_index] & ((1U << shift) - 1);
+        visits = 1 + ((1U << shift) - phase + freq - 1) / freq;
+        if (!passes || visits < passes) {
+            passes = visits;
         }
+    }
+    return passes;
+}
 
-        ++doc->cycle;
-        doc->dt_budget -= CLEM_ENSONIQ_CLOCKS_PER_CYCLE;
+uint32_t clem_ensoniq_sync(struct ClemensDeviceEnsoniq *doc, clem_clocks_duration_t dt_clocks) {
+    unsigned cycles, cycles_to_wrap;
+
+    doc->dt_budget += dt_clocks;
+    cycles = doc->dt_budget / CLEM_ENSONIQ_CLOCKS_PER_CYCLE;
+    doc->dt_budget -= cycles * CLEM_ENSONIQ_CLOCKS_PER_CYCLE;
+
+    //  the oscillator order restarts when the cycle counter wraps
+    while (cycles > 0) {
+        cycles_to_wrap = 0U - doc->cycle;
+        if (cycles_to_wrap && cycles_to_wrap < cycles) {
+            _clem_ensoniq_run(doc, cycles_to_wrap);
+            cycles -= cycles_to_wrap;
+        } else {
+            _clem_ensoniq_run(doc, cycles);
+            cycles = 0;
+        }
     }
 
     return (doc->reg[CLEM_ENSONIQ_REG_OSC_OIR] & 0x80) ? 0 : CLEM_IRQ_AUDIO_OSC;
@@ -342,21 +584,75 @@ unsigned clem_ensoniq_voices(struct ClemensDeviceEnsoniq *doc) {
     return osc_max_channels;
 }
 
-//  down convert voices output into 2 channel mono
-void clem_ensoniq_mono(struct ClemensDeviceEnsoniq *doc, unsigned osc_max_channels, float *left,
-                       float *right) {
-    unsigned active_osc = 0;
-    *left = 0.0f;
-    *right = 0.0f;
-
-    for (unsigned channel_idx = 0; channel_idx < osc_max_channels; ++channel_idx) {
-        *left += doc->voice[channel_idx];
+//  Mixes the current output of all oscillators down to one level, which is the sum
+//  of (2 * DATA - 255) * VOLUME / 255^2 for each running oscillator (matching
+//  clem_ensoniq_voices.)  The 32 oscillators' registers are contiguous, so they're
+//  mixed 16 at a time with SSE2 or by a branch free loop that compilers vectorize.
+static float _clem_ensoniq_mix(const struct ClemensDeviceEnsoniq *doc) {
+    unsigned osc_cnt = (doc->reg[CLEM_ENSONIQ_REG_OSC_ENABLE] >> 1) + 1;
+    int32_t level = 0;
+#if CLEM_AUDIO_SSE2
+    const __m128i halt = _mm_set1_epi8(CLEM_ENSONIQ_OSC_CTL_HALT);
+    const __m128i mode = _mm_set1_epi8(CLEM_ENSONIQ_OSC_CTL_SWAP);
+    const __m128i am_mode = _mm_set1_epi8(CLEM_ENSONIQ_OSC_CTL_HALT + CLEM_ENSONIQ_OSC_CTL_SWAP);
+    const __m128i sync = _mm_set1_epi8(CLEM_ENSONIQ_OSC_CTL_SYNC);
+    const __m128i odd = _mm_set1_epi16((short)0xff00);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(255);
+    const __m128i limit = _mm_set1_epi8((char)osc_cnt);
+    __m128i osc_index = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i sum = _mm_setzero_si128();
+    __m128i data, ctl, gain, mute, wave_lo, wave_hi;
+    unsigned osc_base;
+
+    for (osc_base = 0; osc_base < CLEM_ENSONIQ_OSC_LIMIT; osc_base += 16) {
+        const uint8_t *reg = doc->reg + osc_base;
+        data = _mm_loadu_si128((const __m128i *)(reg + CLEM_ENSONIQ_REG_OSC_DATA));
+        ctl = _mm_loadu_si128((const __m128i *)(reg + CLEM_ENSONIQ_REG_OSC_CTRL));
+        //  even oscillators use the odd oscillator's data as volume in AM (sync) mode
+        gain = _mm_loadu_si128((const __m128i *)(reg + CLEM_ENSONIQ_REG_OSC_CTRL + 1));
+        gain = _mm_andnot_si128(odd, _mm_cmpeq_epi8(_mm_and_si128(gain, am_mode), sync));
+        gain = _mm_or_si128(
+            _mm_and_si128(gain,
+                          _mm_loadu_si128((const __m128i *)(reg + CLEM_ENSONIQ_REG_OSC_DATA + 1))),
+            _mm_andnot_si128(
+                gain, _mm_loadu_si128((const __m128i *)(reg + CLEM_ENSONIQ_REG_OSC_VOLUME))));
+        //  halted, silent and disabled oscillators and odd oscillators in sync mode are muted
+        mute = _mm_cmpeq_epi8(_mm_and_si128(ctl, halt), halt);
+        mute = _mm_or_si128(mute, _mm_cmpeq_epi8(data, zero));
+        mute = _mm_or_si128(mute, _mm_andnot_si128(_mm_cmplt_epi8(osc_index, limit),
+                                                   _mm_cmpeq_epi8(zero, zero)));
+        mute = _mm_or_si128(mute,
+                            _mm_and_si128(odd, _mm_cmpeq_epi8(_mm_and_si128(ctl, mode), sync)));
+        //  widen to 16-bits for (2 * DATA - 255) * VOLUME
+        wave_lo = _mm_sub_epi16(_mm_slli_epi16(_mm_unpacklo_epi8(data, zero), 1), bias);
+        wave_hi = _mm_sub_epi16(_mm_slli_epi16(_mm_unpackhi_epi8(data, zero), 1), bias);
+        wave_lo = _mm_andnot_si128(_mm_unpacklo_epi8(mute, mute), wave_lo);
+        wave_hi = _mm_andnot_si128(_mm_unpackhi_epi8(mute, mute), wave_hi);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(wave_lo, _mm_unpacklo_epi8(gain, zero)));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(wave_hi, _mm_unpackhi_epi8(gain, zero)));
+        osc_index = _mm_add_epi8(osc_index, _mm_set1_epi8(16));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    level = _mm_cvtsi128_si32(sum);
+#else
+    unsigned osc_idx;
+    for (osc_idx = 0; osc_idx < CLEM_ENSONIQ_OSC_LIMIT; ++osc_idx) {
+        const uint8_t *reg = doc->reg + osc_idx;
+        int32_t data = reg[CLEM_ENSONIQ_REG_OSC_DATA];
+        uint8_t ctl = reg[CLEM_ENSONIQ_REG_OSC_CTRL];
+        bool am = !(osc_idx & 1) && (reg[CLEM_ENSONIQ_REG_OSC_CTRL + 1] &
+                                     (CLEM_ENSONIQ_OSC_CTL_HALT + CLEM_ENSONIQ_OSC_CTL_SWAP)) ==
+                                        CLEM_ENSONIQ_OSC_CTL_SYNC;
+        bool mute = (ctl & CLEM_ENSONIQ_OSC_CTL_HALT) || !data || osc_idx >= osc_cnt ||
+                    ((osc_idx & 1) &&
+                     (ctl & CLEM_ENSONIQ_OSC_CTL_SWAP) == CLEM_ENSONIQ_OSC_CTL_SYNC);
+        int32_t gain = am ? reg[CLEM_ENSONIQ_REG_OSC_DATA + 1] : reg[CLEM_ENSONIQ_REG_OSC_VOLUME];
+        level += (mute ? 0 : 2 * data - 255) * gain;
     }
-    if (*left > 1.0f)
-        *left = 1.0f;
-    else if (*left < -1.0f)
-        *left = -1.0f;
-    *right = *left;
+#endif
+    return level / (255.0f * 255.0f);
 }
 
 void clem_ensoniq_write_ctl(struct ClemensDeviceEnsoniq *doc, uint8_t value) {
@@ -460,6 +756,155 @@ uint8_t clem_ensoniq_read_data(struct ClemensDeviceEnsoniq *doc, uint8_t flags)
     return result;
 }
 
+/*  Band-limited synthesis
+
+    The DOC's output changes once per pass through its oscillators (at 894886 /
+    (oscillators + 2) Hz) and the speaker changes on each $C030 access.  Both are
+    steps from one level to the next, so rather than sampling them at the output
+    rate (which aliases), each change is added as a band-limited step: an
+    integrated windowed sinc with its cutoff below the output Nyquist frequency.
+
+    The step is tabulated for CLEM_AUDIO_BLEP_PHASES positions between two output
+    frames (a polyphase table) and spans CLEM_AUDIO_BLEP_TAPS frames.  The table
+    holds the step minus one, so that a frame is the current level plus the
+    pending corrections of the steps from the last CLEM_AUDIO_BLEP_TAPS frames.
+    The output lags the input by half the taps.
+
+    Cost per output frame: one pass of the DOC and a mix of its oscillators per
+    DOC sample, and CLEM_AUDIO_BLEP_TAPS multiply-adds per change in level.  The
+    DOC runs at most 298295 passes a second (one oscillator), so at 44.1KHz there
+    are at most 7 DOC samples per frame (1 with all 32 oscillators enabled) - at
+    most 7 * 16 multiply-adds, plus one step per speaker toggle.
+*/
+
+static float s_audio_blep_kernel[CLEM_AUDIO_BLEP_PHASES + 1][CLEM_AUDIO_BLEP_TAPS];
+static bool s_audio_blep_kernel_ready = false;
+
+static void _clem_sound_blep_init(void) {
+    //  the cutoff as a fraction of the output Nyquist frequency
+    const double cutoff = 0.9;
+    const unsigned step_count = CLEM_AUDIO_BLEP_TAPS * CLEM_AUDIO_BLEP_PHASES;
+    double step[CLEM_AUDIO_BLEP_TAPS * CLEM_AUDIO_BLEP_PHASES + 1];
+    double x, t, h, h_last = 0.0, sum = 0.0;
+    unsigned i, phase, tap;
+
+    if (s_audio_blep_kernel_ready)
+        return;
+    //  integrate the Blackman windowed sinc by trapezoids at each phase
+    for (i = 0; i <= step_count; ++i) {
+        x = (double)i / step_count;
+        t = CLEM_PI * cutoff * (x - 0.5) * CLEM_AUDIO_BLEP_TAPS;
+        h = (t != 0.0) ? sin(t) / t : 1.0;
+        h *= 0.42 - 0.5 * cos(CLEM_PI_2 * x) + 0.08 * cos(2 * CLEM_PI_2 * x);
+        if (i > 0) {
+            sum += 0.5 * (h + h_last);
+        }
+        step[i] = sum;
+        h_last = h;
+    }
+    //  phase is the distance from the step to the next frame
+    for (phase = 0; phase <= CLEM_AUDIO_BLEP_PHASES; ++phase) {
+        for (tap = 0; tap < CLEM_AUDIO_BLEP_TAPS; ++tap) {
+            s_audio_blep_kernel[phase][tap] =
+                (float)(step[tap * CLEM_AUDIO_BLEP_PHASES + phase] / sum - 1.0);
+        }
+    }
+    s_audio_blep_kernel_ready = true;
+}
+
+//  Adds a step of 'delta' that occurs dt_to_frame clocks before the next frame
+static void _clem_sound_blep_add(struct ClemensDeviceAudio *glu, float delta,
+                                 clem_clocks_duration_t dt_to_frame) {
+    unsigned phase = (unsigned)(((uint64_t)dt_to_frame * CLEM_AUDIO_BLEP_PHASES +
+                                 glu->dt_mix_sample / 2) /
+                                glu->dt_mix_sample);
+    const float *kernel = s_audio_blep_kernel[phase];
+    float *frames = glu->blep_frames + glu->blep_frame_pos;
+    unsigned tap;
+#if CLEM_AUDIO_SSE2
+    const __m128 scale = _mm_set1_ps(delta);
+    for (tap = 0; tap < CLEM_AUDIO_BLEP_TAPS; tap += 4) {
+        _mm_storeu_ps(frames + tap, _mm_add_ps(_mm_loadu_ps(frames + tap),
+                                               _mm_mul_ps(scale, _mm_loadu_ps(kernel + tap))));
+    }
+#else
+    for (tap = 0; tap < CLEM_AUDIO_BLEP_TAPS; ++tap) {
+        frames[tap] += delta * kernel[tap];
+    }
+#endif
+}
+
+//  Returns the level of the next frame.  Steps are added to the frames from
+//  blep_frame_pos, so pending frames are kept contiguous by shifting them down
+//  once the first half has been consumed.
+static float _clem_sound_blep_frame(struct ClemensDeviceAudio *glu) {
+    float level =
+        glu->doc_level + glu->a2_speaker_level + glu->blep_frames[glu->blep_frame_pos];
+    if (++glu->blep_frame_pos == CLEM_AUDIO_BLEP_TAPS) {
+        memcpy(glu->blep_frames, glu->blep_frames + CLEM_AUDIO_BLEP_TAPS,
+               CLEM_AUDIO_BLEP_TAPS * sizeof(float));
+        memset(glu->blep_frames + CLEM_AUDIO_BLEP_TAPS, 0, CLEM_AUDIO_BLEP_TAPS * sizeof(float));
+        glu->blep_frame_pos = 0;
+    }
+    return level;
+}
+
+//  Runs the DOC from dt_doc to dt_end clocks into the sync, adding a step for each
+//  change in the mix at the end of the pass that changed it.  Passes that can't
+//  change the mix are run together, so that the DOC steps through them
+//  analytically.  dt_frame is the time of the next frame.  Returns dt_end.
+static clem_clocks_duration_t _clem_sound_doc_run(struct ClemensDeviceAudio *glu,
+                                                  clem_clocks_duration_t dt_doc,
+                                                  clem_clocks_duration_t dt_end,
+                                                  clem_clocks_duration_t dt_frame) {
+    struct ClemensDeviceEnsoniq *doc = &glu->doc;
+    clem_clocks_duration_t dt_pass, dt_pass_full;
+    unsigned osc_cnt_2, cycles, passes, passes_left;
+    float level;
+
+    for (;;) {
+        osc_cnt_2 = (doc->reg[CLEM_ENSONIQ_REG_OSC_ENABLE] >> 1) + 3;
+        dt_pass_full = osc_cnt_2 * CLEM_ENSONIQ_CLOCKS_PER_CYCLE;
+        //  the pass also ends where the cycle counter wraps, so that passes end at
+        //  the same cycles however the syncs are split
+        cycles = osc_cnt_2 - doc->cycle % osc_cnt_2;
+        if (0U - doc->cycle && 0U - doc->cycle < cycles) {
+            cycles = 0U - doc->cycle;
+        }
+        dt_pass = cycles * CLEM_ENSONIQ_CLOCKS_PER_CYCLE - doc->dt_budget;
+        if (dt_pass > dt_end - dt_doc)
+            break;
+        if (doc->cycle % osc_cnt_2 == 0) {
+            //  whole passes left before dt_end, and before the cycle counter wraps
+            //  (which restarts the oscillator order)
+            passes_left = 1 + (unsigned)((dt_end - dt_doc - dt_pass) / dt_pass_full);
+            if (0U - doc->cycle && (0U - doc->cycle) / osc_cnt_2 < passes_left) {
+                passes_left = (0U - doc->cycle) / osc_cnt_2;
+            }
+            passes = _clem_ensoniq_passes_to_change(doc);
+            if (!passes || passes > passes_left) {
+                passes = passes_left;
+            }
+            if (passes > 1) {
+                dt_pass += (passes - 1) * dt_pass_full;
+            }
+        }
+        clem_ensoniq_sync(doc, dt_pass);
+        dt_doc += dt_pass;
+        level = _clem_ensoniq_mix(doc);
+        if (level > 1.0f)
+            level = 1.0f;
+        else if (level < -1.0f)
+            level = -1.0f;
+        if (level != glu->doc_level) {
+            _clem_sound_blep_add(glu, level - glu->doc_level, dt_frame - dt_doc);
+            glu->doc_level = level;
+        }
+    }
+    clem_ensoniq_sync(doc, dt_end - dt_doc);
+    return dt_end;
+}
+
 void clem_sound_reset(struct ClemensDeviceAudio *glu) {
     /* some GLU reset */
 
@@ -471,6 +916,11 @@ void clem_sound_reset(struct ClemensDeviceAudio *glu) {
     glu->a2_speaker_frame_threshold = glu->mix_buffer.frames_per_second / 20;
     glu->a2_speaker_level = 0.0f;
 
+    _clem_sound_blep_init();
+    memset(glu->blep_frames, 0, sizeof(glu->blep_frames));
+    glu->blep_frame_pos = 0;
+    glu->doc_level = 0.0f;
+
     /* other config - i.e. test tone */
     glu->tone_frequency = 0;
     glu->irq_line = 0;
@@ -517,71 +967,74 @@ void _clem_sound_do_tone(struct ClemensDeviceAudio *glu, float *samples) {
 
 void clem_sound_glu_sync(struct ClemensDeviceAudio *glu, struct ClemensClock *clocks) {
     clem_clocks_duration_t dt_clocks = clocks->ts - glu->ts_last_frame;
-
-    glu->irq_line = clem_ensoniq_sync(&glu->doc, dt_clocks);
+    clem_clocks_duration_t dt_doc = 0;
 
     glu->dt_mix_frame += dt_clocks;
 
     if (glu->dt_mix_sample > 0) {
         unsigned delta_frames = (glu->dt_mix_frame / glu->dt_mix_sample);
-        if (delta_frames > 0) {
-            uint8_t *mix_out = glu->mix_buffer.data;
-            // note we only support 2 channels max output
-            float doc_out[2];
-            //  TODO: stereo
-            unsigned ensoniq_voice_cnt = clem_ensoniq_voices(&glu->doc);
-            clem_ensoniq_mono(&glu->doc, ensoniq_voice_cnt, &doc_out[0], &doc_out[1]);
-            if (glu->mix_frame_index + delta_frames > glu->mix_buffer.frame_count) {
-                delta_frames = glu->mix_buffer.frame_count - glu->mix_frame_index;
+        unsigned frame_limit = 0;
+        uint8_t *mix_out = glu->mix_buffer.data;
+        //  clocks from the last sync to the next frame
+        clem_clocks_duration_t dt_frame = glu->dt_mix_sample - (glu->dt_mix_frame - dt_clocks);
+        float level;
+        if (glu->mix_frame_index < glu->mix_buffer.frame_count) {
+            frame_limit = glu->mix_buffer.frame_count - glu->mix_frame_index;
+        }
+        for (unsigned i = 0; i < delta_frames; ++i) {
+            unsigned frame_index;
+            float *samples;
+            dt_doc = _clem_sound_doc_run(glu, dt_doc, dt_frame, dt_frame);
+            if (glu->a2_speaker_frame_count >= 0 &&
+                ++glu->a2_speaker_frame_count > glu->a2_speaker_frame_threshold) {
+                //  the speaker relaxes after a while without clicks
+                glu->a2_speaker_frame_count = -1;
+                _clem_sound_blep_add(glu, -glu->a2_speaker_level, 0);
+                glu->a2_speaker_level = 0.0f;
             }
-            for (unsigned i = 0; i < delta_frames; ++i) {
-                unsigned frame_index = (glu->mix_frame_index + i) % glu->mix_buffer.frame_count;
-                float *samples = (float *)(&mix_out[frame_index * glu->mix_buffer.stride]);
-                /* test tone support */
-                if (glu->tone_frame_delta > 0) {
-                    _clem_sound_do_tone(glu, samples);
-                }
-                if (glu->a2_speaker_frame_count >= 0) {
-                    glu->a2_speaker_frame_count += delta_frames;
-                }
-                if (glu->a2_speaker_frame_count > glu->a2_speaker_frame_threshold) {
-                    glu->a2_speaker_frame_count = -1;
-                    glu->a2_speaker_level = 0.0f;
-                }
-                if (glu->a2_speaker) {
-                    /* click! - two speaker pulses = 1 complete wave */
-                    glu->a2_speaker_frame_count = 0;
-                    if (!glu->a2_speaker_tense) {
-                        glu->a2_speaker_level = 0.50f;
-                    } else {
-                        glu->a2_speaker_level = -0.50f;
-                    }
-                    glu->a2_speaker_tense = !glu->a2_speaker_tense;
-                    glu->a2_speaker = false;
-                }
-                // TODO: stereo DOC
-                samples[0] = CLEM_AUDIO_SAMPLE_AMPLITUDE_SCALAR *
-                             ((doc_out[0] + glu->a2_speaker_level) * glu->volume / 15.0f);
-                if (samples[0] > 1.0f)
-                    samples[0] = 1.0f;
-                else if (samples[0] < -1.0f)
-                    samples[0] = -1.0f;
-                samples[1] = CLEM_AUDIO_SAMPLE_AMPLITUDE_SCALAR *
-                             ((doc_out[1] + glu->a2_speaker_level) * glu->volume / 15.0f);
-                if (samples[1] > 1.0f)
-                    samples[1] = 1.0f;
-                else if (samples[1] < -1.0f)
-                    samples[1] = -1.0f;
+            level = _clem_sound_blep_frame(glu);
+            dt_frame += glu->dt_mix_sample;
+            //  frames past the end of a full mix buffer are dropped
+            if (i >= frame_limit)
+                continue;
+            frame_index = (glu->mix_frame_index + i) % glu->mix_buffer.frame_count;
+            samples = (float *)(&mix_out[frame_index * glu->mix_buffer.stride]);
+            /* test tone support */
+            if (glu->tone_frame_delta > 0) {
+                _clem_sound_do_tone(glu, samples);
             }
-            glu->mix_frame_index =
-                (glu->mix_frame_index + delta_frames); // % (glu->mix_buffer.frame_count);
+            // TODO: stereo DOC
+            samples[0] = CLEM_AUDIO_SAMPLE_AMPLITUDE_SCALAR * (level * glu->volume / 15.0f);
+            if (samples[0] > 1.0f)
+                samples[0] = 1.0f;
+            else if (samples[0] < -1.0f)
+                samples[0] = -1.0f;
+            samples[1] = samples[0];
+        }
+        if (delta_frames > 0) {
+            //  per channel levels for the debugger
+            clem_ensoniq_voices(&glu->doc);
+            glu->mix_frame_index += (delta_frames < frame_limit) ? delta_frames : frame_limit;
             glu->dt_mix_frame = glu->dt_mix_frame % glu->dt_mix_sample;
 #if CLEM_AUDIO_DIAGNOSTICS
             glu->diag_delta_frames += delta_frames;
 #endif
         }
+        dt_doc = _clem_sound_doc_run(glu, dt_doc, dt_clocks, dt_frame);
+        //  a toggle is seen by the sync following the instruction that accessed $C030
+        if (glu->a2_speaker) {
+            /* click! - two speaker pulses = 1 complete wave */
+            level = glu->a2_speaker_tense ? -0.50f : 0.50f;
+            _clem_sound_blep_add(glu, level - glu->a2_speaker_level, dt_frame - dt_clocks);
+            glu->a2_speaker_level = level;
+            glu->a2_speaker_frame_count = 0;
+            glu->a2_speaker_tense = !glu->a2_speaker_tense;
+            glu->a2_speaker = false;
+        }
     }
 
+    glu->irq_line = clem_ensoniq_sync(&glu->doc, dt_clocks - dt_doc);
+
 #if CLEM_AUDIO_DIAGNOSTICS
     glu->diag_dt_ns += clem_calc_ns_step_from_clocks(dt_clocks);
     glu->diag_dt += dt_clocks;
@@ -598,6 +1051,54 @@ void clem_sound_glu_sync(struct ClemensDeviceAudio *glu, struct ClemensClock *cl
     glu->ts_last_frame = clocks->ts;
 }
 
+clem_clocks_time_t clem_sound_glu_next_event_ts(struct ClemensDeviceAudio *glu) {
+    struct ClemensDeviceEnsoniq *doc = &glu->doc;
+    unsigned osc_cnt = (doc->reg[CLEM_ENSONIQ_REG_OSC_ENABLE] >> 1) + 1;
+    unsigned osc_cnt_2 = osc_cnt + 2;
+    unsigned osc_first = doc->cycle % osc_cnt_2;
+    unsigned osc_index, cycles_to_wrap;
+    uint64_t visits, cycle;
+    uint8_t ctl;
+    clem_clocks_time_t next_ts = CLEM_TIME_NEVER;
+    clem_clocks_time_t doc_ts;
+
+    //  frames are rendered in bulk by the next sync, which only has to come before
+    //  the mix buffer fills.  consuming frames reschedules the mixer.
+    if (glu->dt_mix_sample > 0 && glu->mix_frame_index < glu->mix_buffer.frame_count) {
+        next_ts = glu->ts_last_frame + (glu->dt_mix_sample - glu->dt_mix_frame) +
+                  (clem_clocks_time_t)(glu->mix_buffer.frame_count - glu->mix_frame_index - 1) *
+                      glu->dt_mix_sample;
+    }
+    //  the next wrap of a running oscillator that can interrupt (IE set) or that can
+    //  start or reset its partner (sync and swap modes)
+    for (osc_index = 0; osc_index < osc_cnt && osc_index < CLEM_ENSONIQ_OSC_LIMIT; ++osc_index) {
+        ctl = doc->reg[CLEM_ENSONIQ_REG_OSC_CTRL + osc_index];
+        if (ctl & CLEM_ENSONIQ_OSC_CTL_HALT)
+            continue;
+        if (!(ctl & (CLEM_ENSONIQ_OSC_CTL_IE | CLEM_ENSONIQ_OSC_CTL_SYNC)))
+            continue;
+        if ((ctl & CLEM_ENSONIQ_OSC_CTL_IE) &&
+            (doc->osc_flags[osc_index] & CLEM_ENSONIQ_OSC_FLAG_CYCLE)) {
+            visits = 1;
+        } else {
+            visits = _clem_ensoniq_cycles_to_wrap(doc, osc_index);
+            if (!visits)
+                continue;
+        }
+        cycle = (osc_index + osc_cnt_2 - osc_first) % osc_cnt_2 + (visits - 1) * osc_cnt_2;
+        //  the oscillator order restarts when the cycle counter wraps
+        cycles_to_wrap = 0U - doc->cycle;
+        if (cycles_to_wrap && cycle >= cycles_to_wrap) {
+            cycle = cycles_to_wrap;
+        }
+        doc_ts = glu->ts_last_frame + (cycle + 1) * CLEM_ENSONIQ_CLOCKS_PER_CYCLE - doc->dt_budget;
+        if (doc_ts < next_ts) {
+            next_ts = doc_ts;
+        }
+    }
+    return next_ts;
+}
+
 void clem_sound_write_switch(struct ClemensDeviceAudio *glu, uint8_t ioreg, uint8_t value) {
     switch (ioreg) {
     case CLEM_MMIO_REG_AUDIO_CTL:
@@ -4,6 +4,27 @@
 //  inlined header
 #include "clem_cycle.h"
 
+/*  Opcode handler variants are generated for every reachable (emulation, m, x)
+    mode.  Emulation mode forces m and x to 1, so it has a single variant.  The
+    dispatch index for a native mode is (m << 1) | x, and emulation is index 4,
+    which matches the order of this list.
+*/
+#define CLEM_CPU_EXECUTE_MODES(_X_)                                                              \
+    _X_(0, 0, 0)                                                                                 \
+    _X_(0, 0, 1)                                                                                 \
+    _X_(0, 1, 0)                                                                                 \
+    _X_(0, 1, 1)                                                                                 \
+    _X_(1, 1, 1)
+
+#define CLEM_CPU_EXECUTE_MODE_COUNT 5
+
+static inline unsigned _cpu_execute_mode_index(const struct Clemens65C816 *cpu) {
+    if (cpu->pins.emulation)
+        return 0x4;
+    return ((cpu->regs.P & kClemensCPUStatus_MemoryAccumulator) ? 0x2 : 0x0) |
+           ((cpu->regs.P & kClemensCPUStatus_Index) ? 0x1 : 0x0);
+}
+
 static inline void _cpu_p_flags_n_data(struct Clemens65C816 *cpu, uint8_t data) {
     if (data & 0x80) {
         cpu->regs.P |= kClemensCPUStatus_Negative;
@@ -413,62 +434,97 @@ static inline void _cpu_adc(struct Clemens65C816 *cpu, uint16_t value, bool is8)
     cpu->regs.P = p;
 }
 
+/*  Decimal mode lookup tables, one lookup per byte of the operands.  These
+    follow the nibble-by-nibble +6 correction so that invalid BCD digits behave
+    as they did before, see
+    https://math.stackexchange.com/questions/945320/why-do-we-add-6-in-bcd-addition
+
+    ADC is indexed by [low digit sum + carry][high digit sum]:
+        bits 0-7:   the corrected byte
+        bit 8:      carry out
+        bit 9:      bit 7 of the uncorrected sum (for overflow)
+        bit 10:     carry into the next byte
+    SBC is indexed by [low digit difference - borrow + 16][high digit difference + 16]:
+        bits 0-7:   the corrected byte
+        bit 8:      borrow into the next byte
+*/
+#define CLEM_BCD_ADC_LO(_l_)      ((_l_) > 9 ? (_l_) + 6 : (_l_))
+#define CLEM_BCD_ADC_HI(_l_, _h_) ((_h_) + (CLEM_BCD_ADC_LO(_l_) > 0x0f))
+#define CLEM_BCD_ADC_HI_ADJ(_l_, _h_)                                                              \
+    (CLEM_BCD_ADC_HI(_l_, _h_) > 9 ? CLEM_BCD_ADC_HI(_l_, _h_) + 6 : CLEM_BCD_ADC_HI(_l_, _h_))
+#define CLEM_BCD_ADC_ENTRY(_l_, _h_)                                                               \
+    (((CLEM_BCD_ADC_HI_ADJ(_l_, _h_) << 4) & 0xf0) | (CLEM_BCD_ADC_LO(_l_) & 0x0f) |               \
+     ((CLEM_BCD_ADC_HI_ADJ(_l_, _h_) & 0x10) << 4) |                                               \
+     ((CLEM_BCD_ADC_HI(_l_, _h_) & 0x08) << 6) | ((CLEM_BCD_ADC_HI_ADJ(_l_, _h_) > 0x0f) << 10))
+
+#define CLEM_BCD_SBC_LO(_l_)      ((_l_) < 16 ? ((_l_) + 10) & 0x0f : (_l_) & 0x0f)
+#define CLEM_BCD_SBC_HI(_l_, _h_) ((_h_) - 16 - ((_l_) < 16))
+#define CLEM_BCD_SBC_ENTRY(_l_, _h_)                                                               \
+    (((CLEM_BCD_SBC_HI(_l_, _h_) < 0 ? CLEM_BCD_SBC_HI(_l_, _h_) + 26                              \
+                                     : CLEM_BCD_SBC_HI(_l_, _h_)) &                                \
+      0x0f) << 4 |                                                                                 \
+     CLEM_BCD_SBC_LO(_l_) | ((CLEM_BCD_SBC_HI(_l_, _h_) < 0) << 8))
+
+#define CLEM_BCD_X4(_E_, _l_, _h_)                                                                 \
+    _E_(_l_, _h_), _E_(_l_, _h_ + 1), _E_(_l_, _h_ + 2), _E_(_l_, _h_ + 3)
+#define CLEM_BCD_ROW(_E_, _l_)                                                                     \
+    {CLEM_BCD_X4(_E_, _l_, 0),  CLEM_BCD_X4(_E_, _l_, 4),  CLEM_BCD_X4(_E_, _l_, 8),               \
+     CLEM_BCD_X4(_E_, _l_, 12), CLEM_BCD_X4(_E_, _l_, 16), CLEM_BCD_X4(_E_, _l_, 20),              \
+     CLEM_BCD_X4(_E_, _l_, 24), CLEM_BCD_X4(_E_, _l_, 28)}
+#define CLEM_BCD_ROW4(_E_, _l_)                                                                    \
+    CLEM_BCD_ROW(_E_, _l_), CLEM_BCD_ROW(_E_, _l_ + 1), CLEM_BCD_ROW(_E_, _l_ + 2),                \
+        CLEM_BCD_ROW(_E_, _l_ + 3)
+#define CLEM_BCD_TABLE(_E_)                                                                        \
+    {CLEM_BCD_ROW4(_E_, 0),  CLEM_BCD_ROW4(_E_, 4),  CLEM_BCD_ROW4(_E_, 8),                        \
+     CLEM_BCD_ROW4(_E_, 12), CLEM_BCD_ROW4(_E_, 16), CLEM_BCD_ROW4(_E_, 20),                       \
+     CLEM_BCD_ROW4(_E_, 24), CLEM_BCD_ROW4(_E_, 28)}
+
+static const uint16_t s_cpu_bcd_adc[32][32] = CLEM_BCD_TABLE(CLEM_BCD_ADC_ENTRY);
+static const uint16_t s_cpu_bcd_sbc[32][32] = CLEM_BCD_TABLE(CLEM_BCD_SBC_ENTRY);
+
+static inline uint16_t _cpu_bcd_adc_byte(uint8_t a, uint8_t b, unsigned carry) {
+    return s_cpu_bcd_adc[(a & 0x0f) + (b & 0x0f) + carry][(a >> 4) + (b >> 4)];
+}
+
+static inline uint16_t _cpu_bcd_sbc_byte(uint8_t a, uint8_t b, unsigned borrow) {
+    return s_cpu_bcd_sbc[(a & 0x0f) + 16 - (b & 0x0f) - borrow][(a >> 4) + 16 - (b >> 4)];
+}
+
 static inline void _cpu_adc_bcd(struct Clemens65C816 *cpu, uint16_t value, bool is8) {
-    /* note, invalid BCD should still function according to specific rules. see
-       https://math.stackexchange.com/questions/945320/why-do-we-add-6-in-bcd-addition
-    */
-    uint32_t adc;
+    uint16_t lo, hi;
+    uint8_t sum_hi;
     uint8_t p;
-    bool carry = (cpu->regs.P & kClemensCPUStatus_Carry) != 0;
+    unsigned carry = (cpu->regs.P & kClemensCPUStatus_Carry) ? 1 : 0;
     if (is8) {
-        value = value & 0xff;
-        adc = (cpu->regs.A & 0x0f) + (value & 0x0f) + carry;
-        if (adc > 0x09)
-            adc += 0x06;
-        carry = adc > 0x0f;
-        adc = (cpu->regs.A & 0xf0) + (value & 0xf0) + (carry << 4) + (adc & 0x0f);
+        lo = _cpu_bcd_adc_byte((uint8_t)cpu->regs.A, (uint8_t)value, carry);
+        sum_hi = (uint8_t)(lo >> 2);
+        _cpu_p_flags_n_z_data(cpu, (uint8_t)lo);
         p = cpu->regs.P;
-        if (((cpu->regs.A & 0xff) ^ adc) & (value ^ adc) & 0x80)
+        if ((cpu->regs.A ^ sum_hi) & (value ^ sum_hi) & 0x80)
             p |= kClemensCPUStatus_Overflow;
         else
             p &= ~kClemensCPUStatus_Overflow;
-        if (adc > 0x9f)
-            adc += 0x60;
-        _cpu_p_flags_n_z_data(cpu, (uint8_t)adc);
-        p = cpu->regs.P;
-        if (adc & 0x100)
+        if (lo & 0x100)
             p |= kClemensCPUStatus_Carry;
         else
             p &= ~kClemensCPUStatus_Carry;
-        cpu->regs.A = CLEM_UTIL_set16_lo(cpu->regs.A, adc);
+        cpu->regs.A = CLEM_UTIL_set16_lo(cpu->regs.A, lo);
     } else {
-        adc = (cpu->regs.A & 0x0f) + (value & 0x0f) + carry;
-        if (adc > 0x09)
-            adc += 0x06;
-        carry = adc > 0x0f;
-        adc = (cpu->regs.A & 0xf0) + (value & 0xf0) + (carry << 4) + (adc & 0x0f);
-        if (adc > 0x9f)
-            adc += 0x60;
-        carry = adc > 0xff;
-        adc = (cpu->regs.A & 0xf00) + (value & 0xf00) + (carry << 8) + (adc & 0xff);
-        if (adc > 0x9ff)
-            adc += 0x600;
-        carry = adc > 0xfff;
-        adc = (cpu->regs.A & 0xf000) + (value & 0xf000) + (carry << 12) + (adc & 0xfff);
+        lo = _cpu_bcd_adc_byte((uint8_t)cpu->regs.A, (uint8_t)value, carry);
+        hi = _cpu_bcd_adc_byte((uint8_t)(cpu->regs.A >> 8), (uint8_t)(value >> 8),
+                               (lo >> 10) & 1);
+        sum_hi = (uint8_t)(hi >> 2);
+        _cpu_p_flags_n_z_data_16(cpu, (uint16_t)((hi << 8) | (lo & 0xff)));
         p = cpu->regs.P;
-        if ((cpu->regs.A ^ adc) & (value ^ adc) & 0x8000)
+        if (((cpu->regs.A >> 8) ^ sum_hi) & ((value >> 8) ^ sum_hi) & 0x80)
             p |= kClemensCPUStatus_Overflow;
         else
             p &= ~kClemensCPUStatus_Overflow;
-        if (adc > 0x9fff)
-            adc += 0x6000;
-        _cpu_p_flags_n_z_data_16(cpu, (uint16_t)adc);
-        p = cpu->regs.P;
-        if (adc & 0x10000)
+        if (hi & 0x100)
             p |= kClemensCPUStatus_Carry;
         else
             p &= ~kClemensCPUStatus_Carry;
-        cpu->regs.A = (uint16_t)adc;
+        cpu->regs.A = (uint16_t)((hi << 8) | (lo & 0xff));
     }
     cpu->regs.P = p;
 }
@@ -513,28 +569,19 @@ static inline void _cpu_sbc(struct Clemens65C816 *cpu, uint16_t value, bool is8)
 }
 
 static inline void _cpu_sbc_bcd(struct Clemens65C816 *cpu, uint16_t value, bool is8) {
-    /* note, invalid BCD should still function according to specific rules. see
-       https://math.stackexchange.com/questions/945320/why-do-we-add-6-in-bcd-addition
+    /* flags are taken from the binary difference, and the decimal result from the
+       lookup tables above
     */
     uint32_t a_tmp;
     uint32_t sbc;
     uint32_t sbc_2comp;
+    uint16_t lo, hi;
     uint8_t p;
     bool carry = (cpu->regs.P & kClemensCPUStatus_Carry) != 0;
     if (is8) {
         a_tmp = (cpu->regs.A & 0x00ff);
         value = value & 0xff;
-        sbc = (a_tmp & 0x0f) - (value & 0x0f) - !carry;
-        if (sbc & 0x10) {
-            /* borrow */
-            sbc = (sbc - 0x06) & 0x0f;
-            sbc |= ((a_tmp & 0xf0) - (value & 0xf0) - 0x10);
-        } else {
-            sbc = (sbc & 0x0f);
-            sbc |= ((a_tmp & 0xf0) - (value & 0xf0));
-        }
-        if (sbc & 0x100)
-            sbc -= 0x60;
+        sbc = _cpu_bcd_sbc_byte((uint8_t)a_tmp, (uint8_t)value, !carry) & 0xff;
         sbc_2comp = a_tmp - value - !carry;
         carry = (sbc_2comp < 0x100);
         _cpu_p_flags_n_z_data(cpu, (uint8_t)(sbc_2comp & 0xff));
@@ -549,27 +596,12 @@ static inline void _cpu_sbc_bcd(struct Clemens65C816 *cpu, uint16_t value, bool
         } else {
             p &= ~kClemensCPUStatus_Carry;
         }
-        cpu->regs.A = CLEM_UTIL_set16_lo(cpu->regs.A, (uint16_t)(sbc & 0xff));
+        cpu->regs.A = CLEM_UTIL_set16_lo(cpu->regs.A, (uint16_t)sbc);
     } else {
         a_tmp = cpu->regs.A;
-        sbc = (a_tmp & 0x0f) - (value & 0x0f) - !carry;
-        if (sbc & 0x10) {
-            /* borrow */
-            sbc = (sbc - 0x06) & 0x0f;
-            sbc |= ((a_tmp & 0xf0) - (value & 0xf0) - 0x10);
-        } else {
-            sbc = (sbc & 0x0f);
-            sbc |= ((a_tmp & 0xf0) - (value & 0xf0));
-        }
-        if (sbc & 0x100) {
-            sbc = (sbc - 0x60) & 0xff;
-            sbc |= ((a_tmp & 0xf00) - (value & 0xf00) - 0x100);
-        } else {
-            sbc = (sbc & 0xff);
-            sbc |= ((a_tmp & 0xf00) - (value & 0xf00));
-        }
-        if (sbc & 0x1000)
-            sbc -= 0x600;
+        lo = _cpu_bcd_sbc_byte((uint8_t)a_tmp, (uint8_t)value, !carry);
+        hi = _cpu_bcd_sbc_byte((uint8_t)(a_tmp >> 8), (uint8_t)(value >> 8), lo >> 8);
+        sbc = ((hi & 0xff) << 8) | (lo & 0xff);
         sbc_2comp = a_tmp - value - !carry;
         carry = (sbc_2comp < 0x10000);
         _cpu_p_flags_n_z_data_16(cpu, (uint16_t)sbc_2comp);
@@ -0,0 +1,2112 @@
+/*  65816 opcode handlers
+
+    Included by emulator.c once for each cpu_execute variant with these defined:
+
+    CLEM_CPU_EXECUTE_FN         name of the generated function
+    CLEM_CPU_EXECUTE_TRACED     builds the instruction description for the
+                                opcode callback and logging
+    CLEM_CPU_EXECUTE_EMULATION  the emulation, m and x modes that this variant
+    CLEM_CPU_EXECUTE_M          runs, which fold into constants in the handlers
+    CLEM_CPU_EXECUTE_X
+
+    The modes reflect the CPU state at the start of the instruction - opcodes
+    that change them (REP, SEP, XCE, PLP, RTI) take effect on the next
+    instruction's dispatch.  The traced variant evaluates them at runtime and
+    isn't specialized.
+
+    When step_count is non-NULL, untraced variants run instructions in a batch
+    until _clem_cpu_step_end() returns true (and then return true), or until the
+    mode changes (returning false.)
+
+    There is intentionally no include guard.
+*/
+
+//  TODO: Okay, we enter native mode but PBR is still 0x00 though we are
+//        reading code from ROM.  research what to do during the switch to
+//        native mode!   do the I/O memory registers still tell us to read
+//        from ROM though we are at PBR bank 0x00?  Or should PBR change to
+//        0xff?
+//
+//  Fetches the opcode.  Its simple define may be overwritten by the handler.
+#define CLEM_CPU_INSTRUCTION_BEGIN()                                                           \
+    assert(cpu->state_type == kClemensCPUStateType_Execute);                                   \
+    tmp_pc = cpu->regs.PC;                                                                     \
+    opc_pbr = cpu->regs.PBR;                                                                   \
+    opc_addr = tmp_pc;                                                                         \
+    if (traced) {                                                                              \
+        opc_inst.cycles_spent = cpu->cycles_spent;                                             \
+    }                                                                                          \
+    clem_read(clem, &cpu->regs.IR, tmp_pc++, cpu->regs.PBR, CLEM_MEM_FLAG_OPCODE_FETCH);       \
+    IR = cpu->regs.IR;                                                                         \
+    _opcode_instruction_define_simple(opc_trace, IR);                                          \
+    carry = (cpu->regs.P & kClemensCPUStatus_Carry) != 0;                                      \
+    zero_flag = (cpu->regs.P & kClemensCPUStatus_Zero) != 0
+
+//  A batch continues with the next instruction until the host needs to sync or
+//  the CPU mode no longer matches this variant
+#define CLEM_CPU_INSTRUCTION_END()                                                             \
+    cpu->regs.PC = tmp_pc;                                                                     \
+    if (traced) {                                                                              \
+        opc_inst.pbr = opc_pbr;                                                                \
+        opc_inst.addr = opc_addr;                                                              \
+        opc_inst.cycles_spent = cpu->cycles_spent - opc_inst.cycles_spent;                     \
+        _opcode_print(clem, &opc_inst);                                                        \
+    }                                                                                          \
+    if (traced || !step_count)                                                                 \
+        return false;                                                                          \
+    ++*step_count;                                                                             \
+    if (_clem_cpu_step_end(clem, opc_addr, opc_pbr, clocks))                                   \
+        return true;                                                                           \
+    if (_cpu_execute_mode_index(cpu) != mode_index)                                            \
+        return false;                                                                          \
+    clem->dev_debug.pc = cpu->regs.PC;                                                         \
+    clem->dev_debug.pbr = cpu->regs.PBR
+
+static bool CLEM_CPU_EXECUTE_FN(struct Clemens65C816 *cpu, ClemensMachine *clem,
+                                clem_clocks_time_t clocks, unsigned *step_count) {
+    uint16_t tmp_addr;
+    uint16_t tmp_eaddr;
+    uint16_t tmp_value;
+    uint16_t tmp_pc;
+    uint8_t tmp_data;
+    uint8_t tmp_bnk0;
+    uint8_t tmp_bnk1;
+    uint8_t IR;
+
+    const bool traced = CLEM_CPU_EXECUTE_TRACED;
+    const bool emulation = CLEM_CPU_EXECUTE_EMULATION;
+    const bool m_status = CLEM_CPU_EXECUTE_M;
+    const bool x_status = CLEM_CPU_EXECUTE_X;
+    const unsigned mode_index =
+        emulation ? 0x4 : ((m_status ? 0x2 : 0x0) | (x_status ? 0x1 : 0x0));
+
+    struct ClemensInstruction opc_inst;
+    struct ClemensInstruction *opc_trace = traced ? &opc_inst : NULL;
+    uint16_t opc_addr;
+    uint8_t opc_pbr;
+
+    uint8_t carry;
+    bool zero_flag;
+    bool overflow_flag;
+    bool neg_flag;
+
+next_instruction:
+    CLEM_CPU_INSTRUCTION_BEGIN();
+    switch (IR) {
+    //
+    // Start ADC
+    case CLEM_OPC_ADC_IMM:
+        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define(opc_trace, IR, tmp_value, m_status);
+        break;
+    case CLEM_OPC_ADC_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_ADC_ABSL:
+        //  TODO: emulation mode
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_ADC_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem,  &tmp_value, tmp_addr, 0x00, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ADC_DP_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ADC_DP_INDIRECTL:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ADC_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    m_status, x_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_ADC_ABSL_IDX:
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
+                                    x_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_ADC_ABS_IDY: // $addr + Y
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_ADC_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ADC_DP_IDX_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO for (d, X)
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ADC_DP_INDIRECT_IDY:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ADC_DP_INDIRECTL_IDY:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
+                                    x_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ADC_STACK_REL:
+        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    case CLEM_OPC_ADC_STACK_REL_INDIRECT_IDY:
+        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_adc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    //  End ADC
+    //
+    //  Start AND
+    case CLEM_OPC_AND_IMM:
+        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_value, m_status);
+        break;
+    case CLEM_OPC_AND_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_AND_ABSL:
+        //  TODO: emulation mode
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_AND_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_AND_DP_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_AND_DP_INDIRECTL:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_AND_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_AND_ABSL_IDX:
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
+                                    x_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_AND_ABS_IDY: // $addr + Y
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_AND_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_AND_DP_IDX_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO for (d, X)
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_AND_DP_INDIRECT_IDY:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_AND_DP_INDIRECTL_IDY:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
+                                    x_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_AND_STACK_REL:
+        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    case CLEM_OPC_AND_STACK_REL_INDIRECT_IDY:
+        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_and(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    //  End ADC
+    //
+    //  Start ASL
+    case CLEM_OPC_ASL_A:
+        _cpu_asl(cpu, &cpu->regs.A, m_status);
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_ASL_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_asl(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_ASL_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_asl(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ASL_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_cycle(clem);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_asl(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_indexed_816(clem, tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
+                                x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_ASL_ABS_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_asl(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    //  End ASL
+    //
+    //  Start BIT
+    case CLEM_OPC_BIT_IMM:
+        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
+        _cpu_bit_imm(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_value, m_status);
+        break;
+    case CLEM_OPC_BIT_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_bit(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_BIT_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_bit(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_BIT_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_bit(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_BIT_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_bit(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    //  End BIT
+    //
+    //  Start Branch
+    case CLEM_OPC_BCC:
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        _clem_branch(clem, &tmp_pc, tmp_data, !carry);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, false);
+        break;
+    case CLEM_OPC_BCS:
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        _clem_branch(clem, &tmp_pc, tmp_data, carry);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, false);
+        break;
+    case CLEM_OPC_BEQ:
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        _clem_branch(clem, &tmp_pc, tmp_data, zero_flag);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, false);
+        break;
+    case CLEM_OPC_BMI:
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        _clem_branch(clem, &tmp_pc, tmp_data, cpu->regs.P & kClemensCPUStatus_Negative);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, false);
+        break;
+    case CLEM_OPC_BNE:
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        _clem_branch(clem, &tmp_pc, tmp_data, !zero_flag);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, false);
+        break;
+    case CLEM_OPC_BPL:
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        _clem_branch(clem, &tmp_pc, tmp_data, !(cpu->regs.P & kClemensCPUStatus_Negative));
+        _opcode_instruction_define(opc_trace, IR, tmp_data, false);
+        break;
+    case CLEM_OPC_BRA:
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        _clem_branch(clem, &tmp_pc, tmp_data, true);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, false);
+        break;
+    case CLEM_OPC_BRL:
+        _clem_read_pba_16(clem, &tmp_value, &tmp_pc);
+        tmp_addr = tmp_pc + (int16_t)tmp_value;
+        _clem_cycle(clem);
+        tmp_pc = tmp_addr;
+        _opcode_instruction_define(opc_trace, IR, tmp_value, false);
+        break;
+    case CLEM_OPC_BVC:
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        _clem_branch(clem, &tmp_pc, tmp_data, !(cpu->regs.P & kClemensCPUStatus_Overflow));
+        _opcode_instruction_define(opc_trace, IR, tmp_data, false);
+        break;
+    case CLEM_OPC_BVS:
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        _clem_branch(clem, &tmp_pc, tmp_data, cpu->regs.P & kClemensCPUStatus_Overflow);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, false);
+        break;
+    //  End Branch
+    //
+    case CLEM_OPC_CLC:
+        cpu->regs.P &= ~kClemensCPUStatus_Carry;
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_CLD:
+        cpu->regs.P &= ~kClemensCPUStatus_Decimal;
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_CLI:
+        cpu->regs.P &= ~kClemensCPUStatus_IRQDisable;
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_CLV:
+        cpu->regs.P &= ~kClemensCPUStatus_Overflow;
+        _clem_cycle(clem);
+        break;
+    //
+    //  Start CMP
+    case CLEM_OPC_CMP_IMM:
+        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_value, m_status);
+        break;
+    case CLEM_OPC_CMP_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_CMP_ABSL:
+        //  TODO: emulation mode
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_CMP_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_CMP_DP_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_CMP_DP_INDIRECTL:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_CMP_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_CMP_ABSL_IDX:
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
+                                    x_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_CMP_ABS_IDY: // $addr + Y
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_CMP_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_CMP_DP_IDX_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO for (d, X)
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_CMP_DP_INDIRECT_IDY:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_CMP_DP_INDIRECTL_IDY:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
+                                    x_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_CMP_STACK_REL:
+        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    case CLEM_OPC_CMP_STACK_REL_INDIRECT_IDY:
+        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    //  End CMP
+    //
+    case CLEM_OPC_CPX_IMM:
+        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, x_status);
+        _cpu_cmp(cpu, cpu->regs.X, tmp_value, x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_value, x_status);
+        break;
+    case CLEM_OPC_CPX_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, x_status);
+        _cpu_cmp(cpu, cpu->regs.X, tmp_value, x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, x_status);
+        break;
+    case CLEM_OPC_CPX_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, x_status);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, x_status);
+        _cpu_cmp(cpu, cpu->regs.X, tmp_value, x_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_CPY_IMM:
+        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, x_status);
+        _cpu_cmp(cpu, cpu->regs.Y, tmp_value, x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_value, x_status);
+        break;
+    case CLEM_OPC_CPY_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, x_status);
+        _cpu_cmp(cpu, cpu->regs.Y, tmp_value, x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, x_status);
+        break;
+    case CLEM_OPC_CPY_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, x_status);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, x_status);
+        _cpu_cmp(cpu, cpu->regs.Y, tmp_value, x_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    //
+    //  Start DEC
+    case CLEM_OPC_DEC_A:
+        _cpu_dec(cpu, &cpu->regs.A, m_status);
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_DEC_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_dec(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_DEC_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_dec(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_DEC_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_cycle(clem);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_dec(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_indexed_816(clem, tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
+                                x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_DEC_ABS_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_dec(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    //  End DEC
+    //
+    case CLEM_OPC_DEX:
+        tmp_value = cpu->regs.X - 1;
+        if (x_status) {
+            cpu->regs.X = CLEM_UTIL_set16_lo(cpu->regs.X, tmp_value);
+            _cpu_p_flags_n_z_data(cpu, (uint8_t)tmp_value);
+        } else {
+            cpu->regs.X = tmp_value;
+            _cpu_p_flags_n_z_data_16(cpu, tmp_value);
+        }
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_DEY:
+        tmp_value = cpu->regs.Y - 1;
+        if (x_status) {
+            cpu->regs.Y = CLEM_UTIL_set16_lo(cpu->regs.Y, tmp_value);
+            _cpu_p_flags_n_z_data(cpu, (uint8_t)tmp_value);
+        } else {
+            cpu->regs.Y = tmp_value;
+            _cpu_p_flags_n_z_data_16(cpu, tmp_value);
+        }
+        _clem_cycle(clem);
+        break;
+    //
+    //  Start EOR
+    case CLEM_OPC_EOR_IMM:
+        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_value, m_status);
+        break;
+    case CLEM_OPC_EOR_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_EOR_ABSL:
+        //  TODO: emulation mode
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_EOR_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_EOR_DP_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_EOR_DP_INDIRECTL:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_EOR_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_EOR_ABSL_IDX:
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
+                                    x_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_EOR_ABS_IDY: // $addr + Y
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_EOR_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_EOR_DP_IDX_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO for (d, X)
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_EOR_DP_INDIRECT_IDY:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_EOR_DP_INDIRECTL_IDY:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
+                                    x_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_EOR_STACK_REL:
+        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    case CLEM_OPC_EOR_STACK_REL_INDIRECT_IDY:
+        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_eor(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    //  End EOR
+    //
+    //  Start INC
+    case CLEM_OPC_INC_A:
+        _cpu_inc(cpu, &cpu->regs.A, m_status);
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_INC_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_inc(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_INC_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_inc(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_INC_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_cycle(clem);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_inc(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_indexed_816(clem, tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
+                                x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_INC_ABS_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_inc(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    //  End INC
+    //
+    case CLEM_OPC_INX:
+        tmp_value = cpu->regs.X + 1;
+        if (x_status) {
+            cpu->regs.X = CLEM_UTIL_set16_lo(cpu->regs.X, tmp_value);
+            _cpu_p_flags_n_z_data(cpu, (uint8_t)tmp_value);
+        } else {
+            cpu->regs.X = tmp_value;
+            _cpu_p_flags_n_z_data_16(cpu, tmp_value);
+        }
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_INY:
+        tmp_value = cpu->regs.Y + 1;
+        if (x_status) {
+            cpu->regs.Y = CLEM_UTIL_set16_lo(cpu->regs.Y, tmp_value);
+            _cpu_p_flags_n_z_data(cpu, (uint8_t)tmp_value);
+        } else {
+            cpu->regs.Y = tmp_value;
+            _cpu_p_flags_n_z_data_16(cpu, tmp_value);
+        }
+        _clem_cycle(clem);
+        break;
+    //
+    //  Start JMP
+    case CLEM_OPC_JMP_ABS:
+        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
+        tmp_pc = tmp_addr;
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_JMP_INDIRECT:
+        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
+        _clem_read_16_wrap(clem, &tmp_eaddr, tmp_addr, 0x00, CLEM_MEM_FLAG_DATA);
+        tmp_pc = tmp_eaddr;
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_JMP_INDIRECT_IDX:
+        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
+        if (x_status) {
+            tmp_eaddr = tmp_addr + (cpu->regs.X & 0x00ff);
+        } else {
+            tmp_eaddr = tmp_addr + cpu->regs.X;
+        }
+        _clem_cycle(clem);
+        _clem_read_16_wrap(clem, &tmp_pc, tmp_eaddr, cpu->regs.PBR, CLEM_MEM_FLAG_DATA);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, x_status);
+        break;
+    case CLEM_OPC_JMP_ABSL:
+        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
+        _clem_read_pba(clem, &tmp_bnk0, &tmp_pc);
+        tmp_pc = tmp_addr;
+        cpu->regs.PBR = tmp_bnk0;
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_JMP_ABSL_INDIRECT:
+        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
+        _clem_read_16_wrap(clem, &tmp_eaddr, tmp_addr, 0x00, CLEM_MEM_FLAG_DATA);
+        clem_read(clem, &tmp_bnk0, tmp_addr + 2, 0x00, CLEM_MEM_FLAG_DATA);
+        tmp_pc = tmp_eaddr;
+        cpu->regs.PBR = tmp_bnk0;
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    //  End JMP
+    //
+    //  Start LDA
+    case CLEM_OPC_LDA_IMM:
+        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_value, m_status);
+        break;
+    case CLEM_OPC_LDA_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_LDA_ABSL:
+        //  TODO: emulation mode
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_LDA_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_LDA_DP_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_LDA_DP_INDIRECTL:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_LDA_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_LDA_ABSL_IDX:
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
+                                    x_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_LDA_ABS_IDY: // $addr + Y
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_LDA_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_LDA_DP_IDX_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO for (d, X)
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_LDA_DP_INDIRECT_IDY:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_LDA_DP_INDIRECTL_IDY:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
+                                    x_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_LDA_STACK_REL:
+        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    case CLEM_OPC_LDA_STACK_REL_INDIRECT_IDY:
+        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_lda(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    //  End LDA
+    //
+    case CLEM_OPC_LDX_IMM:
+        _clem_read_pba_816(clem, &tmp_value, &tmp_pc, x_status);
+        _cpu_ldxy(cpu, &cpu->regs.X, tmp_value, x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_value, x_status);
+        break;
+    case CLEM_OPC_LDX_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, x_status);
+        _cpu_ldxy(cpu, &cpu->regs.X, tmp_value, x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, x_status);
+        break;
+    case CLEM_OPC_LDX_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, x_status);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, x_status);
+        _cpu_ldxy(cpu, &cpu->regs.X, tmp_value, x_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_LDX_ABS_IDY:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    x_status, x_status);
+        _cpu_ldxy(cpu, &cpu->regs.X, tmp_value, x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, x_status);
+        break;
+    case CLEM_OPC_LDX_DP_IDY:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.Y, x_status);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, x_status);
+        _cpu_ldxy(cpu, &cpu->regs.X, tmp_value, x_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_LDY_IMM:
+        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, x_status);
+        _cpu_ldxy(cpu, &cpu->regs.Y, tmp_value, x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_value, x_status);
+        break;
+    case CLEM_OPC_LDY_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, x_status);
+        _cpu_ldxy(cpu, &cpu->regs.Y, tmp_value, x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, x_status);
+        break;
+    case CLEM_OPC_LDY_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, x_status);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, x_status);
+        _cpu_ldxy(cpu, &cpu->regs.Y, tmp_value, x_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_LDY_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    x_status, x_status);
+        _cpu_ldxy(cpu, &cpu->regs.Y, tmp_value, x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, x_status);
+        break;
+    case CLEM_OPC_LDY_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, x_status);
+        _cpu_ldxy(cpu, &cpu->regs.Y, tmp_value, x_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    //
+    //  Start ASL
+    case CLEM_OPC_LSR_A:
+        _cpu_lsr(cpu, &cpu->regs.A, m_status);
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_LSR_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_lsr(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_LSR_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_lsr(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_LSR_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_cycle(clem);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_lsr(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_indexed_816(clem, tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
+                                x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_LSR_ABS_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_lsr(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    //  End LSR
+    //
+    case CLEM_OPC_MVN:
+        //  copy X -> Y, incrementing X, Y, decrement C
+        _clem_read_pba(clem, &tmp_bnk1, &tmp_pc); // dest
+        _clem_read_pba(clem, &tmp_bnk0, &tmp_pc); // src
+        clem_read(clem, &tmp_data, cpu->regs.X, tmp_bnk0, CLEM_MEM_FLAG_DATA);
+        clem_write(clem, tmp_data, cpu->regs.Y, tmp_bnk1, CLEM_MEM_FLAG_DATA);
+        if (x_status) {
+            cpu->regs.X = CLEM_UTIL_set16_lo(cpu->regs.X, cpu->regs.X + 1);
+            cpu->regs.Y = CLEM_UTIL_set16_lo(cpu->regs.Y, cpu->regs.Y + 1);
+        } else {
+            ++cpu->regs.X;
+            ++cpu->regs.Y;
+        }
+        _clem_cycle_2(clem);
+        --cpu->regs.A;
+        if (cpu->regs.A != 0xffff) {
+            tmp_pc = cpu->regs.PC; // repeat
+        }
+        cpu->regs.DBR = tmp_bnk1;
+        _opcode_instruction_define_mvn(opc_trace, IR, tmp_bnk1, tmp_bnk0);
+        break;
+    case CLEM_OPC_MVP:
+        //  copy X -> Y, decrementing X, Y, decrement C
+        _clem_read_pba(clem, &tmp_bnk1, &tmp_pc); // dest
+        _clem_read_pba(clem, &tmp_bnk0, &tmp_pc); // src
+        clem_read(clem, &tmp_data, cpu->regs.X, tmp_bnk0, CLEM_MEM_FLAG_DATA);
+        clem_write(clem, tmp_data, cpu->regs.Y, tmp_bnk1, CLEM_MEM_FLAG_DATA);
+        if (x_status) {
+            cpu->regs.X = CLEM_UTIL_set16_lo(cpu->regs.X, cpu->regs.X - 1);
+            cpu->regs.Y = CLEM_UTIL_set16_lo(cpu->regs.Y, cpu->regs.Y - 1);
+        } else {
+            --cpu->regs.X;
+            --cpu->regs.Y;
+        }
+        _clem_cycle_2(clem);
+        --cpu->regs.A;
+        if (cpu->regs.A != 0xffff) {
+            tmp_pc = cpu->regs.PC; // repeat
+        }
+        cpu->regs.DBR = tmp_bnk1;
+        _opcode_instruction_define_mvn(opc_trace, IR, tmp_bnk1, tmp_bnk0);
+        break;
+    case CLEM_OPC_NOP:
+        _clem_cycle(clem);
+        break;
+    //
+    //  Start ORA
+    case CLEM_OPC_ORA_IMM:
+        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_value, m_status);
+        break;
+    case CLEM_OPC_ORA_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_ORA_ABSL:
+        //  TODO: emulation mode
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_ORA_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ORA_DP_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ORA_DP_INDIRECTL:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ORA_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_ORA_ABSL_IDX:
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
+                                    x_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_ORA_ABS_IDY: // $addr + Y
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_ORA_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ORA_DP_IDX_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO for (d, X)
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ORA_DP_INDIRECT_IDY:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        /* TODO: timing check for io cycle? */
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ORA_DP_INDIRECTL_IDY:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
+                                    x_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ORA_STACK_REL:
+        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    case CLEM_OPC_ORA_STACK_REL_INDIRECT_IDY:
+        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_ora(cpu, tmp_value, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    //  End ORA
+    //
+    case CLEM_OPC_PEA_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _cpu_sp_dec2(cpu);
+        _clem_write_16_wrap(clem, tmp_addr, cpu->regs.S + 1, 0x00);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_PEI_DP_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _cpu_sp_dec2(cpu);
+        _clem_write_16_wrap(clem, tmp_addr, cpu->regs.S + 1, 0x00);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_PER:
+        _clem_read_pba_16(clem, &tmp_value, &tmp_pc);
+        tmp_addr = tmp_pc + (int16_t)tmp_value;
+        _clem_cycle(clem);
+        _cpu_sp_dec2(cpu);
+        _clem_write_16_wrap(clem, tmp_addr, cpu->regs.S + 1, 0x00);
+        _opcode_instruction_define(opc_trace, IR, tmp_value, m_status);
+        break;
+    case CLEM_OPC_PHA:
+        _clem_opc_push_reg_816(clem, cpu->regs.A, m_status);
+        break;
+    case CLEM_OPC_PHB:
+        _clem_cycle(clem);
+        clem_write(clem, (uint8_t)cpu->regs.DBR, cpu->regs.S, 0x00, CLEM_MEM_FLAG_DATA);
+        _cpu_sp_dec(cpu);
+        break;
+    case CLEM_OPC_PHD:
+        _clem_cycle(clem);
+        //  65816 quirk - PHD can overrun the valid stack range
+        clem_write(clem, (uint8_t)(cpu->regs.D >> 8), cpu->regs.S, 0x00, CLEM_MEM_FLAG_DATA);
+        clem_write(clem, (uint8_t)(cpu->regs.D), cpu->regs.S - 1, 0x00, CLEM_MEM_FLAG_DATA);
+        _cpu_sp_dec2(cpu);
+        break;
+    case CLEM_OPC_PHK:
+        _clem_cycle(clem);
+        clem_write(clem, (uint8_t)cpu->regs.PBR, cpu->regs.S, 0x00, CLEM_MEM_FLAG_DATA);
+        _cpu_sp_dec(cpu);
+        break;
+    case CLEM_OPC_PHP:
+        _clem_cycle(clem);
+        _clem_opc_push_status(clem, false);
+        break;
+    case CLEM_OPC_PHX:
+        _clem_opc_push_reg_816(clem, cpu->regs.X, x_status);
+        break;
+    case CLEM_OPC_PHY:
+        _clem_opc_push_reg_816(clem, cpu->regs.Y, x_status);
+        break;
+    case CLEM_OPC_PLA:
+        _clem_opc_pull_reg_816(clem, &cpu->regs.A, m_status);
+        _cpu_p_flags_n_z_data_816(cpu, cpu->regs.A, m_status);
+        break;
+    case CLEM_OPC_PLB:
+        _clem_opc_pull_reg_8(clem, &cpu->regs.DBR);
+        _cpu_p_flags_n_z_data(cpu, cpu->regs.DBR);
+        break;
+    case CLEM_OPC_PLD:
+        _clem_cycle_2(clem);
+        _clem_read_16_wrap(clem, &cpu->regs.D, cpu->regs.S + 1, 0x00, CLEM_MEM_FLAG_DATA);
+        _cpu_sp_inc2(cpu);
+        _cpu_p_flags_n_z_data_16(cpu, cpu->regs.D);
+        break;
+    case CLEM_OPC_PLP:
+        // In emulation, the B flag is not restored - it should
+        // instead set x_status to 1? (can we set x_status to 0 in
+        // emulation?)
+        _clem_cycle_2(clem);
+        _clem_opc_pull_status(clem);
+        break;
+    case CLEM_OPC_PLX:
+        _clem_opc_pull_reg_816(clem, &cpu->regs.X, x_status);
+        _cpu_p_flags_n_z_data_816(cpu, cpu->regs.X, x_status);
+        break;
+    case CLEM_OPC_PLY:
+        _clem_opc_pull_reg_816(clem, &cpu->regs.Y, x_status);
+        _cpu_p_flags_n_z_data_816(cpu, cpu->regs.Y, x_status);
+        break;
+    case CLEM_OPC_REP:
+        // Reset Status Bits
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        cpu->regs.P &= (~tmp_data); // all 1 bits are turned OFF in P
+        if (emulation) {
+            cpu->regs.P |= kClemensCPUStatus_MemoryAccumulator;
+            cpu->regs.P |= kClemensCPUStatus_Index;
+        }
+        _cpu_p_flags_apply_m_x(cpu);
+        _clem_cycle(clem);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, false);
+        break;
+    //
+    //  Start ROL
+    case CLEM_OPC_ROL_A:
+        _cpu_rol(cpu, &cpu->regs.A, m_status);
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_ROL_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_rol(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_ROL_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_rol(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ROL_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_cycle(clem);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_rol(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_indexed_816(clem, tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
+                                x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_ROL_ABS_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_rol(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    //  End ROL
+    //
+    //  Start ROR
+    case CLEM_OPC_ROR_A:
+        _cpu_ror(cpu, &cpu->regs.A, m_status);
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_ROR_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_ror(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_ROR_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_ror(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_ROR_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_cycle(clem);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    m_status, x_status);
+        _cpu_ror(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_indexed_816(clem, tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
+                                x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_ROR_ABS_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_ror(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    //  End ROR
+    //
+    // Start SBC
+    case CLEM_OPC_SBC_IMM:
+        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define(opc_trace, IR, tmp_value, m_status);
+        break;
+    case CLEM_OPC_SBC_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_SBC_ABSL:
+        //  TODO: emulation mode
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_SBC_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_SBC_DP_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_SBC_DP_INDIRECTL:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_SBC_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
+                                    m_status, x_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_SBC_ABSL_IDX:
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
+                                    x_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_SBC_ABS_IDY: // $addr + Y
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_SBC_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_SBC_DP_IDX_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO for (d, X)
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_SBC_DP_INDIRECT_IDY:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        /* TODO: timing io cycle check? */
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_SBC_DP_INDIRECTL_IDY:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
+                                    x_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_SBC_STACK_REL:
+        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    case CLEM_OPC_SBC_STACK_REL_INDIRECT_IDY:
+        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
+                                    m_status, x_status);
+        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
+            _cpu_sbc(cpu, tmp_value, m_status);
+        } else {
+            _cpu_sbc_bcd(cpu, tmp_value, m_status);
+        }
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    //  End ADC
+    //
+    case CLEM_OPC_SEC:
+        cpu->regs.P |= kClemensCPUStatus_Carry;
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_SED:
+        cpu->regs.P |= kClemensCPUStatus_Decimal;
+        _clem_cycle(clem);
+
+        break;
+    case CLEM_OPC_SEI:
+        cpu->regs.P |= kClemensCPUStatus_IRQDisable;
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_SEP:
+        // Reset Status Bits
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        if (emulation) {
+            tmp_data |= kClemensCPUStatus_MemoryAccumulator;
+            tmp_data |= kClemensCPUStatus_Index;
+        }
+        cpu->regs.P |= tmp_data; // all 1 bits are turned ON in P
+        _cpu_p_flags_apply_m_x(cpu);
+        _clem_cycle(clem);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, false);
+        break;
+    //
+    //  Start STA
+    case CLEM_OPC_STA_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_write_816(clem, cpu->regs.A, tmp_addr, cpu->regs.DBR, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_STA_ABSL:
+        //  absolute long read
+        //  TODO: what about emulation mode?
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_write_816(clem, cpu->regs.A, tmp_addr, tmp_bnk0, m_status);
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_STA_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_write_816(clem, cpu->regs.A, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_STA_DP_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_write_816(clem, cpu->regs.A, tmp_addr, cpu->regs.DBR, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_STA_DP_INDIRECTL:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_write_816(clem, cpu->regs.A, tmp_addr, tmp_bnk0, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_STA_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_cycle(clem);
+        //_clem_read_indexed_null_io(clem, tmp_addr, cpu->regs.X, cpu->regs.DBR);
+        _clem_write_indexed_816(clem, cpu->regs.A, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
+                                x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_STA_ABSL_IDX:
+        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
+        _clem_write_indexed_816(clem, cpu->regs.A, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
+                                x_status);
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        break;
+    case CLEM_OPC_STA_ABS_IDY: // $addr + Y
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_cycle(clem); // extra IO
+        _clem_write_indexed_816(clem, cpu->regs.A, tmp_addr, cpu->regs.Y, cpu->regs.DBR, m_status,
+                                x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_STA_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_write_816(clem, cpu->regs.A, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_STA_DP_IDX_INDIRECT:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO for (d, X)
+        _clem_write_816(clem, cpu->regs.A, tmp_addr, cpu->regs.DBR, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_STA_DP_INDIRECT_IDY:
+        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+
+        _clem_io_read_cycle(clem, tmp_addr, cpu->regs.Y, cpu->regs.DBR);
+        _clem_write_indexed_816(clem, cpu->regs.A, tmp_addr, cpu->regs.Y, cpu->regs.DBR, m_status,
+                                x_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_STA_DP_INDIRECTL_IDY:
+        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
+        _clem_write_indexed_816(clem, cpu->regs.A, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
+                                x_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_STA_STACK_REL:
+        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_write_816(clem, cpu->regs.A, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    case CLEM_OPC_STA_STACK_REL_INDIRECT_IDY:
+        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
+        _clem_write_indexed_816(clem, cpu->regs.A, tmp_addr, cpu->regs.Y, cpu->regs.DBR, m_status,
+                                x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_data, m_status);
+        break;
+    //  End STA
+    //
+    //  Start STX,STY,STZ
+    case CLEM_OPC_STX_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_write_816(clem, cpu->regs.X, tmp_addr, cpu->regs.DBR, x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, x_status);
+        break;
+    case CLEM_OPC_STX_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, x_status);
+        _clem_write_816(clem, cpu->regs.X, tmp_addr, 0x00, x_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_STX_DP_IDY:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.Y, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_write_816(clem, cpu->regs.X, tmp_addr, 0x00, x_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_STY_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_write_816(clem, cpu->regs.Y, tmp_addr, cpu->regs.DBR, x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, x_status);
+        break;
+    case CLEM_OPC_STY_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, x_status);
+        _clem_write_816(clem, cpu->regs.Y, tmp_addr, 0x00, x_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_STY_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_write_816(clem, cpu->regs.Y, tmp_addr, 0x00, x_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_STZ_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_write_816(clem, 0x0000, tmp_addr, cpu->regs.DBR, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_STZ_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_write_816(clem, 0x0000, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_STZ_ABS_IDX:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_cycle(clem);
+        _clem_write_indexed_816(clem, 0x0000, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
+                                x_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_STZ_DP_IDX:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
+        _clem_cycle(clem); // extra IO cycle for d,x
+        _clem_write_816(clem, 0x0000, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    //  End STX,STY,STZ
+    //
+    //  Start Transfer
+    case CLEM_OPC_TAX:
+        if (x_status) {
+            cpu->regs.X = CLEM_UTIL_set16_lo(cpu->regs.X, cpu->regs.A);
+            _cpu_p_flags_n_z_data(cpu, (uint8_t)cpu->regs.X);
+        } else {
+            cpu->regs.X = cpu->regs.A;
+            _cpu_p_flags_n_z_data_16(cpu, cpu->regs.X);
+        }
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_TAY:
+        if (x_status) {
+            cpu->regs.Y = CLEM_UTIL_set16_lo(cpu->regs.Y, cpu->regs.A);
+            _cpu_p_flags_n_z_data(cpu, (uint8_t)cpu->regs.Y);
+        } else {
+            cpu->regs.Y = cpu->regs.A;
+            _cpu_p_flags_n_z_data_16(cpu, cpu->regs.Y);
+        }
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_TCD:
+        cpu->regs.D = cpu->regs.A;
+        _cpu_p_flags_n_z_data_16(cpu, cpu->regs.D);
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_TDC:
+        cpu->regs.A = cpu->regs.D;
+        _cpu_p_flags_n_z_data_16(cpu, cpu->regs.A);
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_TCS:
+        if (emulation) {
+            cpu->regs.S = CLEM_UTIL_set16_lo(cpu->regs.S, cpu->regs.A);
+        } else {
+            cpu->regs.S = cpu->regs.A;
+        }
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_TSC:
+        cpu->regs.A = cpu->regs.S;
+        _cpu_p_flags_n_z_data_16(cpu, cpu->regs.A);
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_TSX:
+        if (!emulation && !x_status) {
+            cpu->regs.X = cpu->regs.S;
+            _cpu_p_flags_n_z_data_16(cpu, cpu->regs.X);
+        } else if (x_status) {
+            cpu->regs.X = CLEM_UTIL_set16_lo(cpu->regs.X, cpu->regs.S);
+            _cpu_p_flags_n_z_data(cpu, (uint8_t)cpu->regs.X);
+        }
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_TXA:
+        if (m_status) {
+            cpu->regs.A = CLEM_UTIL_set16_lo(cpu->regs.A, cpu->regs.X);
+            _cpu_p_flags_n_z_data(cpu, (uint8_t)cpu->regs.A);
+        } else {
+            cpu->regs.A = x_status ? (uint8_t)cpu->regs.X : cpu->regs.X;
+            _cpu_p_flags_n_z_data_16(cpu, cpu->regs.A);
+        }
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_TXS:
+        //  no n,z flags set
+        if (emulation) {
+            cpu->regs.S = CLEM_UTIL_set16_lo(cpu->regs.S, cpu->regs.X);
+        } else if (x_status) {
+            cpu->regs.S = cpu->regs.X & 0x00ff;
+        } else {
+            cpu->regs.S = cpu->regs.X;
+        }
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_TXY:
+        if (x_status) {
+            cpu->regs.Y = CLEM_UTIL_set16_lo(cpu->regs.Y, cpu->regs.X);
+            _cpu_p_flags_n_z_data(cpu, (uint8_t)cpu->regs.Y);
+        } else {
+            cpu->regs.Y = cpu->regs.X;
+            _cpu_p_flags_n_z_data_16(cpu, cpu->regs.Y);
+        }
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_TYA:
+        if (m_status) {
+            cpu->regs.A = CLEM_UTIL_set16_lo(cpu->regs.A, cpu->regs.Y);
+            _cpu_p_flags_n_z_data(cpu, (uint8_t)cpu->regs.A);
+        } else {
+            cpu->regs.A = x_status ? (uint8_t)cpu->regs.Y : cpu->regs.Y;
+            _cpu_p_flags_n_z_data_16(cpu, cpu->regs.A);
+        }
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_TYX:
+        if (x_status) {
+            cpu->regs.X = CLEM_UTIL_set16_lo(cpu->regs.X, cpu->regs.Y);
+            _cpu_p_flags_n_z_data(cpu, (uint8_t)cpu->regs.X);
+        } else {
+            cpu->regs.X = cpu->regs.Y;
+            _cpu_p_flags_n_z_data_16(cpu, cpu->regs.X);
+        }
+        _clem_cycle(clem);
+        break;
+    //  End Transfer
+    //
+    case CLEM_OPC_TRB_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_trb(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_TRB_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_trb(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_TSB_ABS:
+        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _cpu_tsb(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, m_status);
+        break;
+    case CLEM_OPC_TSB_DP:
+        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
+        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
+        _cpu_tsb(cpu, &tmp_value, m_status);
+        _clem_cycle(clem);
+        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
+        _opcode_instruction_define_dp(opc_trace, IR, tmp_data);
+        break;
+    case CLEM_OPC_XBA:
+        tmp_value = cpu->regs.A;
+        cpu->regs.A = (tmp_value & 0xff00) >> 8;
+        cpu->regs.A = (tmp_value & 0x00ff) << 8 | cpu->regs.A;
+        _cpu_p_flags_n_z_data(cpu, (uint8_t)(cpu->regs.A & 0x00ff));
+        _clem_cycle_2(clem);
+        break;
+    case CLEM_OPC_XCE:
+        tmp_value = cpu->pins.emulation;
+        cpu->pins.emulation = (cpu->regs.P & kClemensCPUStatus_Carry) != 0;
+        if (tmp_value != cpu->pins.emulation) {
+            cpu->regs.P |= kClemensCPUStatus_Index;
+            cpu->regs.P |= kClemensCPUStatus_MemoryAccumulator;
+            if (tmp_value) {
+                // TODO: log internally
+            } else {
+                // switch to emulation, and emulation stack
+                cpu->regs.S = CLEM_UTIL_set16_lo(0x0100, cpu->regs.S);
+            }
+            _cpu_p_flags_apply_m_x(cpu);
+        }
+        if (tmp_value) {
+            cpu->regs.P |= kClemensCPUStatus_Carry;
+        } else {
+            cpu->regs.P &= ~kClemensCPUStatus_Carry;
+        }
+        _clem_cycle(clem);
+        break;
+    case CLEM_OPC_WDM:
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        //  TODO: add option for wdm custom ops vs NOP
+        //        right now, always a custom op
+        if (tmp_data == 0x01) {
+            // memory dump
+            // byte 0 = pages to print (0-255)
+            // byte 1 = bank
+            // byte 2,3 = adrlo, hi
+            _clem_read_pba(clem, &tmp_data, &tmp_pc);
+            _clem_read_pba(clem, &tmp_bnk0, &tmp_pc);
+            _clem_read_pba(clem, &tmp_bnk1, &tmp_pc);
+            _clem_debug_memory_dump(clem, tmp_bnk1, tmp_bnk0, tmp_data);
+        } else if (tmp_data == 0x02) {
+            //  Instruction with data pushed onto the stack: 
+            //  [type]
+            //  [adrhi]
+            //  [adrlo]
+            //_clem_opc_pull_reg_8(clem,)
+            //  passed to the appropriate handler
+        }
+        break;
+    //  Jump, JSR,
+    case CLEM_OPC_JSR:
+        // Stack [PCH, PCL]
+        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
+        --tmp_pc; // point to last byte in operand
+        _clem_cycle(clem);
+        _clem_opc_push_pc16(clem, tmp_pc);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, false);
+        CLEM_CPU_I_JSR_LOG(cpu, tmp_addr);
+        tmp_pc = tmp_addr; // set next PC to the JSR routine
+        break;
+    case CLEM_OPC_JSR_INDIRECT_IDX:
+        // +2 cycles accounted for by the extra 16-bit read from the index
+        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
+        --tmp_pc; // point to last byte in operand
+        _clem_cycle(clem);
+        _clem_opc_push_pc16(clem, tmp_pc);
+        if (x_status) {
+            tmp_eaddr = tmp_addr + (cpu->regs.X & 0x00ff);
+        } else {
+            tmp_eaddr = tmp_addr + cpu->regs.X;
+        }
+        _clem_read_16_wrap(clem, &tmp_pc, tmp_eaddr, cpu->regs.PBR, CLEM_MEM_FLAG_DATA);
+        CLEM_CPU_I_JSR_LOG(cpu, tmp_eaddr);
+        _opcode_instruction_define(opc_trace, IR, tmp_addr, x_status);
+        break;
+    case CLEM_OPC_RTS:
+        //  Stack [PCH, PCL]
+        _clem_cycle_2(clem);
+        tmp_value = cpu->regs.S + 1;
+        if (emulation) {
+            tmp_value = CLEM_UTIL_set16_lo(cpu->regs.S, tmp_value);
+        }
+        clem_read(clem, &tmp_data, tmp_value, 0x00, CLEM_MEM_FLAG_DATA);
+        tmp_addr = tmp_data;
+        ++tmp_value;
+        if (emulation) {
+            tmp_value = CLEM_UTIL_set16_lo(cpu->regs.S, tmp_value);
+        }
+        clem_read(clem, &tmp_data, tmp_value, 0x00, CLEM_MEM_FLAG_DATA);
+        tmp_addr = ((uint16_t)tmp_data << 8) | tmp_addr;
+        _clem_cycle(clem);
+        _cpu_sp_inc2(cpu);
+        tmp_pc = tmp_addr + 1; //  point to next instruction
+        CLEM_CPU_I_RTS_LOG(cpu, tmp_pc);
+        break;
+    case CLEM_OPC_JSL:
+        // Stack [PBR, PCH, PCL]
+        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
+        //  push old PBR
+        clem_write(clem, cpu->regs.PBR, cpu->regs.S, 0x0, CLEM_MEM_FLAG_DATA);
+        _clem_cycle(clem);
+        //  new PBR
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        --tmp_pc; // point to last byte in operand
+        tmp_bnk0 = tmp_data;
+        //  JSL stack overrun will not wrap to 0x1ff (65816 quirk)
+        //  SP will still wrap
+        //  tmp_pc will be tha address of the last operand
+        clem_write(clem, (uint8_t)(tmp_pc >> 8), cpu->regs.S - 1, 0x00, CLEM_MEM_FLAG_DATA);
+        tmp_value = cpu->regs.S - 1;
+        clem_write(clem, (uint8_t)tmp_pc, cpu->regs.S - 2, 0x00, CLEM_MEM_FLAG_DATA);
+        _cpu_sp_dec3(cpu);
+        _opcode_instruction_define_long(opc_trace, IR, tmp_bnk0, tmp_addr);
+        CLEM_CPU_I_JSL_LOG(cpu, tmp_addr, tmp_bnk0);
+        tmp_pc = tmp_addr; // set next PC to the JSL routine
+        cpu->regs.PBR = tmp_bnk0;
+        break;
+    case CLEM_OPC_RTL:
+        _clem_cycle_2(clem);
+        //  again, 65816 quirk where RTL will read from over the top
+        //  in emulation mode even
+        clem_read(clem, &tmp_data, cpu->regs.S + 1, 0x00, CLEM_MEM_FLAG_DATA);
+        tmp_addr = tmp_data;
+        clem_read(clem, &tmp_data, cpu->regs.S + 2, 0x00, CLEM_MEM_FLAG_DATA);
+        tmp_addr = ((uint16_t)tmp_data << 8) | tmp_addr;
+        clem_read(clem, &tmp_data, cpu->regs.S + 3, 0x00, CLEM_MEM_FLAG_DATA);
+        _cpu_sp_inc3(cpu);
+        tmp_pc = tmp_addr + 1;
+        CLEM_CPU_I_RTL_LOG(cpu, tmp_pc, tmp_data);
+        cpu->regs.PBR = tmp_data;
+        break;
+
+    //  interrupt opcodes (RESET is handled separately)
+    case CLEM_OPC_BRK:
+        //  BRK ignores irq disable
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        CLEM_CPU_I_INTR_LOG(cpu, "BRK");
+        tmp_value = tmp_data;
+        if (emulation) {
+            _clem_irq_brk_setup(clem, &cpu->regs.PBR, &tmp_pc, CLEM_6502_IRQBRK_VECTOR_LO_ADDR,
+                                CLEM_6502_IRQBRK_VECTOR_HI_ADDR, true);
+
+        } else {
+            _clem_irq_brk_setup(clem, &cpu->regs.PBR, &tmp_pc, CLEM_65816_BRK_VECTOR_LO_ADDR,
+                                CLEM_65816_BRK_VECTOR_HI_ADDR, true);
+        }
+        _opcode_instruction_define(opc_trace, IR, tmp_value, true);
+        break;
+    case CLEM_OPC_COP:
+        //  ignore irq disable
+        _clem_read_pba(clem, &tmp_data, &tmp_pc);
+        CLEM_CPU_I_INTR_LOG(cpu, "COP");
+        tmp_value = tmp_data;
+        if (emulation) {
+            _clem_irq_brk_setup(clem, &cpu->regs.PBR, &tmp_pc, CLEM_6502_COP_VECTOR_LO_ADDR,
+                                CLEM_6502_COP_VECTOR_LO_ADDR, true);
+
+        } else {
+            _clem_irq_brk_setup(clem, &cpu->regs.PBR, &tmp_pc, CLEM_65816_COP_VECTOR_LO_ADDR,
+                                CLEM_65816_COP_VECTOR_HI_ADDR, true);
+        }
+        _opcode_instruction_define(opc_trace, IR, tmp_value, true);
+        break;
+    case CLEM_OPC_RTI:
+        _clem_cycle_2(clem);
+        tmp_pc = _clem_irq_brk_return(clem);
+        break;
+    case CLEM_OPC_WAI:
+        //  the calling application could interpret ReadyOut
+        _clem_cycle_2(clem);
+        cpu->pins.readyOut = false;
+        break;
+    case CLEM_OPC_STP:
+        _clem_cycle_2(clem);
+        cpu->enabled = false;
+        break;
+    default:
+        CLEM_WARN("Unknown IR = %x\n", IR);
+        assert(false);
+        break;
+    }
+    CLEM_CPU_INSTRUCTION_END();
+    goto next_instruction;
+}
+
+#undef CLEM_CPU_EXECUTE_FN
+#undef CLEM_CPU_EXECUTE_TRACED
+#undef CLEM_CPU_EXECUTE_EMULATION
+#undef CLEM_CPU_EXECUTE_M
+#undef CLEM_CPU_EXECUTE_X
+#undef CLEM_CPU_INSTRUCTION_BEGIN
+#undef CLEM_CPU_INSTRUCTION_END
@@ -28,17 +28,21 @@ static inline void _clem_timespec_init(struct ClemensTimeSpec *tspec,
     _clem_timespec_reset(tspec);
 }
 
+static inline void _clem_timespec_next_phi0(struct ClemensTimeSpec *tspec) {
+    tspec->mega2_scanline_ctr = (tspec->mega2_scanline_ctr + 1) % 65;
+    tspec->phi0_current_step = CLEM_CLOCKS_PHI0_CYCLE;
+    if (tspec->mega2_scanline_ctr == 64) {
+        tspec->phi0_current_step += tspec->phi0_clocks_stretch;
+    }
+    tspec->clocks_next_phi0 += tspec->phi0_current_step;
+}
+
 static inline void _clem_timespec_next_step(struct ClemensTimeSpec *tspec,
                                             clem_clocks_duration_t clocks) {
     tspec->clocks_spent += clocks;
     //  next phi0 edge calculated below, accounting for the stretch cycle
     if (tspec->clocks_spent >= tspec->clocks_next_phi0) {
-        tspec->mega2_scanline_ctr = (tspec->mega2_scanline_ctr + 1) % 65;
-        tspec->phi0_current_step = CLEM_CLOCKS_PHI0_CYCLE;
-        if (tspec->mega2_scanline_ctr == 64) {
-            tspec->phi0_current_step += tspec->phi0_clocks_stretch;
-        }
-        tspec->clocks_next_phi0 += tspec->phi0_current_step;
+        _clem_timespec_next_phi0(tspec);
     }
 }
 
@@ -59,6 +63,36 @@ static inline void _clem_wait(struct ClemensMachine *clem) {
     _clem_timespec_cycle(&clem->tspec, clem->tspec.clocks_step == CLEM_CLOCKS_PHI0_CYCLE);
 }
 
+//  Equivalent to calling _clem_wait() until the clock reaches 'clocks', but
+//  without stepping through each cycle.  Only the PHI0 edges crossed are
+//  visited so that the stretch cycle lands exactly where it would have.
+//  CLEM_TIME_NEVER has no cycle to reach and so waits for nothing.
+static inline void _clem_wait_until(struct ClemensMachine *clem, clem_clocks_time_t clocks) {
+    struct ClemensTimeSpec *tspec = &clem->tspec;
+    if (tspec->clocks_spent >= clocks || clocks == CLEM_TIME_NEVER)
+        return;
+    if (tspec->clocks_step == CLEM_CLOCKS_PHI0_CYCLE) {
+        //  after the first cycle syncs to PHI0, every cycle is one PHI0 step
+        _clem_timespec_cycle(tspec, true);
+        while (tspec->clocks_spent < clocks) {
+            _clem_timespec_next_step(tspec, tspec->phi0_current_step);
+        }
+    } else if (tspec->clocks_step <= CLEM_CLOCKS_PHI0_CYCLE) {
+        //  fast cycles cross at most one PHI0 edge each, so the edges can be
+        //  caught up after advancing the clock by whole cycles
+        clem_clocks_time_t cycles =
+            (clocks - tspec->clocks_spent + tspec->clocks_step - 1) / tspec->clocks_step;
+        tspec->clocks_spent += cycles * tspec->clocks_step;
+        while (tspec->clocks_spent >= tspec->clocks_next_phi0) {
+            _clem_timespec_next_phi0(tspec);
+        }
+    } else {
+        while (tspec->clocks_spent < clocks) {
+            _clem_timespec_cycle(tspec, false);
+        }
+    }
+}
+
 static inline void _clem_cycle(struct ClemensMachine *clem) {
     _clem_timespec_cycle(&clem->tspec, clem->tspec.clocks_step == CLEM_CLOCKS_PHI0_CYCLE);
     ++clem->cpu.cycles_spent;
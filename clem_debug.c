@@ -50,7 +50,61 @@ void clem_debug_trace_flush() {
     s_clem_debug_cnt = 0;
 }
 
-void clem_debug_reset(struct ClemensDeviceDebugger *dbg) { memset(dbg, 0, sizeof(*dbg)); }
+//  Breakpoints are owned by the host and survive a machine reset
+void clem_debug_reset(struct ClemensDeviceDebugger *dbg) {
+    dbg->log_message = NULL;
+    dbg->pc = 0;
+    dbg->pbr = 0;
+    dbg->watch_hit = 0;
+}
+
+static inline unsigned _clem_debug_breakpoint_slot(uint32_t key) {
+    //  Fibonacci hashing spreads out breakpoints set on neighboring addresses
+    return (unsigned)((key * 2654435769u) >> 24) & (CLEM_DEBUG_BREAKPOINT_HASH_SIZE - 1);
+}
+
+bool clem_debug_add_breakpoint(struct ClemensDeviceDebugger *dbg, unsigned type,
+                               uint32_t address) {
+    uint32_t key = CLEM_DEBUG_BREAKPOINT_KEY(type, (address >> 16) & 0xff, address & 0xffff);
+    unsigned slot = _clem_debug_breakpoint_slot(key);
+
+    if (type == kClemensDebugBreakpoint_None)
+        return false;
+    while (dbg->breakpoints[slot]) {
+        if (dbg->breakpoints[slot] == key)
+            return true;
+        slot = (slot + 1) & (CLEM_DEBUG_BREAKPOINT_HASH_SIZE - 1);
+    }
+    if (dbg->breakpoint_count >= CLEM_DEBUG_BREAKPOINT_LIMIT)
+        return false;
+    dbg->breakpoints[slot] = key;
+    dbg->breakpoint_count++;
+    dbg->breakpoint_types |= (1 << type);
+    if (type == kClemensDebugBreakpoint_DataRead || type == kClemensDebugBreakpoint_Write) {
+        dbg->watch_pages[(address >> 11) & 0x1f] |= (1 << ((address >> 8) & 0x7));
+        dbg->watch_generation++;
+    }
+    return true;
+}
+
+void clem_debug_clear_breakpoints(struct ClemensDeviceDebugger *dbg) {
+    memset(dbg->breakpoints, 0, sizeof(dbg->breakpoints));
+    memset(dbg->watch_pages, 0, sizeof(dbg->watch_pages));
+    dbg->breakpoint_count = 0;
+    dbg->breakpoint_types = 0;
+    dbg->watch_generation++;
+    dbg->watch_hit = 0;
+}
+
+bool clem_debug_has_breakpoint(const struct ClemensDeviceDebugger *dbg, uint32_t key) {
+    unsigned slot = _clem_debug_breakpoint_slot(key);
+    while (dbg->breakpoints[slot]) {
+        if (dbg->breakpoints[slot] == key)
+            return true;
+        slot = (slot + 1) & (CLEM_DEBUG_BREAKPOINT_HASH_SIZE - 1);
+    }
+    return false;
+}
 
 void clem_debug_break(struct ClemensDeviceDebugger *dbg, unsigned debug_reason, unsigned param0,
                       unsigned param1) {
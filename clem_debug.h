@@ -3,6 +3,8 @@
 
 /* TODO: something a little less reliant on clib */
 #include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #define CLEM_ASSERT(_cond_)                                                                        \
@@ -41,6 +43,11 @@ void clem_debug_reset(struct ClemensDeviceDebugger *dbg);
 void clem_debug_break(struct ClemensDeviceDebugger *dbg, unsigned debug_reason, unsigned param0,
                       unsigned param1);
 
+bool clem_debug_add_breakpoint(struct ClemensDeviceDebugger *dbg, unsigned type,
+                               uint32_t address);
+void clem_debug_clear_breakpoints(struct ClemensDeviceDebugger *dbg);
+bool clem_debug_has_breakpoint(const struct ClemensDeviceDebugger *dbg, uint32_t key);
+
 void clem_debug_context(ClemensMachine *context);
 
 void clem_debug_log(int log_level, const char *fmt, ...);
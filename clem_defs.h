@@ -304,6 +304,14 @@
 
 //  support read or write operations
 #define CLEM_MEM_PAGE_WRITEOK_FLAG 0x00000001
+//  host_read/host_write accesses take Mega2 cycles
+#define CLEM_MEM_PAGE_HOST_MEGA2_READ_FLAG  0x00000002
+#define CLEM_MEM_PAGE_HOST_MEGA2_WRITE_FLAG 0x00000004
+//  direct pages are shared by many banks, so their host memory is the requested
+//  bank's in fpi_bank_map rather than host_read/host_write
+#define CLEM_MEM_PAGE_HOST_DIRECT_READ_FLAG  0x00000008
+#define CLEM_MEM_PAGE_HOST_DIRECT_WRITE_FLAG 0x00000010
+#define CLEM_MEM_PAGE_HOST_DIRECT_MASK       0x00000018
 //  use the original bank register
 #define CLEM_MEM_PAGE_DIRECT_FLAG 0x10000000
 //  use a mask of the requested bank and the 17th address bit of the read/write
@@ -80,6 +80,14 @@ uint8_t *clem_adb_ascii_from_a2code(unsigned input);
  */
 void clem_gameport_sync(struct ClemensDeviceGameport *gameport, struct ClemensClock *clocks);
 
+/**
+ * @brief Returns when the next paddle timer expires
+ *
+ * @param gameport
+ * @return clem_clocks_time_t CLEM_TIME_NEVER if no paddle timers are running
+ */
+clem_clocks_time_t clem_gameport_next_event_ts(struct ClemensDeviceGameport *gameport);
+
 /**
  * @brief Executed frequently enough to emulate the GLU Microcontroller
  *
@@ -89,6 +97,14 @@ void clem_gameport_sync(struct ClemensDeviceGameport *gameport, struct ClemensCl
 void clem_adb_glu_sync(struct ClemensDeviceADB *adb, struct ClemensDeviceMega2Memory* m2mem, 
                        uint32_t delta_us);
 
+/**
+ * @brief Microseconds until the GLU Microcontroller must be synced again
+ *
+ * @param adb ADB device data
+ * @return uint32_t 0 if a command is in progress, otherwise the time until the next poll
+ */
+uint32_t clem_adb_glu_next_event_us(struct ClemensDeviceADB *adb);
+
 /**
  * @brief Executed from the memory subsystem for MMIO
  *
@@ -149,6 +165,14 @@ void clem_sound_consume_frames(struct ClemensDeviceAudio *glu, unsigned consumed
  */
 void clem_sound_glu_sync(struct ClemensDeviceAudio *glu, struct ClemensClock *clocks);
 
+/**
+ * @brief Returns when the GLU must be synced next (mixer frame or DOC interrupt)
+ *
+ * @param glu device data
+ * @return clem_clocks_time_t CLEM_TIME_NEVER if there is no scheduled event
+ */
+clem_clocks_time_t clem_sound_glu_next_event_ts(struct ClemensDeviceAudio *glu);
+
 /**
  * @brief Executed from the memory subsystem for MMIO
  *
@@ -225,6 +249,14 @@ struct ClemensNibbleDisk *clem_iwm_eject_disk(struct ClemensDeviceIWM *iwm,
 void clem_iwm_glu_sync(struct ClemensDeviceIWM *iwm, struct ClemensDriveBay *drives,
                        struct ClemensTimeSpec *tspec);
 
+/**
+ * @brief Returns the end of the current bit cell while the drive motor is on
+ *
+ * @param iwm device data
+ * @return clem_clocks_time_t CLEM_TIME_NEVER if the drive is off
+ */
+clem_clocks_time_t clem_iwm_glu_next_event_ts(struct ClemensDeviceIWM *iwm);
+
 /**
  * @brief Returns if the IWM is actively in read or write mode to a specific drive
  *
@@ -716,6 +716,13 @@ void clem_iwm_glu_sync(struct ClemensDeviceIWM *iwm, struct ClemensDriveBay *dri
     _clem_iwm_step(iwm, drives, tspec->clocks_spent);
 }
 
+clem_clocks_time_t clem_iwm_glu_next_event_ts(struct ClemensDeviceIWM *iwm) {
+    if (!(iwm->io_flags & CLEM_IWM_FLAG_DRIVE_ON)) {
+        return CLEM_TIME_NEVER;
+    }
+    return iwm->cur_clocks_ts + (iwm->clocks_this_step - iwm->clocks_used_this_step);
+}
+
 /*
     Reading IWM addresses only returns data based on the state of Q6, Q7, and
     only if reading from even io addresses.  The few exceptions are addresses
@@ -2,6 +2,12 @@
 #include "clem_debug.h"
 #include "clem_shared.h"
 
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 //  these are inlined headers
 #include "clem_cycle.h"
 #include "clem_util.h"
@@ -13,15 +19,180 @@ void clem_mem_create_page_mapping(struct ClemensMemoryPageInfo *page, uint8_t pa
     page->read = page_idx;
     page->bank_write = bank_write_idx;
     page->write = page_idx;
+    page->host_read = NULL;
+    page->host_write = NULL;
+}
+
+void clem_mem_page_map_clear_host(struct ClemensMemoryPageMap *page_map) {
+    unsigned page_idx;
+    for (page_idx = 0; page_idx < 256; ++page_idx) {
+        page_map->pages[page_idx].host_read = NULL;
+        page_map->pages[page_idx].host_write = NULL;
+        page_map->pages[page_idx].flags &= ~CLEM_MEM_PAGE_HOST_DIRECT_MASK;
+    }
+}
+
+//  Records a write to a page of bank $E0 or $E1 for the host's video renderer
+static inline void _clem_mem_mega2_dirty(struct ClemensMemory *mem, uint8_t bank_actual,
+                                         uint8_t page_idx) {
+    mem->mega2_dirty_pages[bank_actual & 0x1][page_idx >> 3] |= (1 << (page_idx & 0x7));
+}
+
+#if defined(_MSC_VER)
+static inline uint32_t _clem_mem_load_acquire(uint32_t *value) {
+    return (uint32_t)_InterlockedOr((volatile long *)value, 0);
+}
+static inline void _clem_mem_store_release(uint32_t *value, uint32_t v) {
+    _InterlockedExchange((volatile long *)value, (long)v);
+}
+#else
+static inline uint32_t _clem_mem_load_acquire(uint32_t *value) {
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+static inline void _clem_mem_store_release(uint32_t *value, uint32_t v) {
+    __atomic_store_n(value, v, __ATOMIC_RELEASE);
+}
+#endif
+
+//  Records are published to the consumer once per batch to keep the shared
+//  index off the emulator's path
+#define CLEM_MEM_BUS_TRACE_BATCH 256
+
+void clem_mem_bus_trace_publish(struct ClemensBusTrace *trace) {
+    _clem_mem_store_release(&trace->head, trace->write);
+}
+
+unsigned clem_mem_bus_trace_read(struct ClemensBusTrace *trace,
+                                 struct ClemensBusTraceRecord *records, unsigned limit) {
+    uint32_t head = _clem_mem_load_acquire(&trace->head);
+    uint32_t tail = trace->tail;
+    unsigned count = 0;
+    while (tail != head && count < limit) {
+        records[count++] = trace->records[tail & trace->capacity_mask];
+        ++tail;
+    }
+    _clem_mem_store_release(&trace->tail, tail);
+    return count;
+}
+
+//  The ring never blocks the emulator.  When full, cycles are dropped and the
+//  next record is flagged so that the consumer can see the gap.
+static void _clem_mem_bus_trace(struct ClemensBusTrace *trace, const struct ClemensCPUPins *pins,
+                                clem_clocks_time_t ts, bool mega2_access) {
+    struct ClemensBusTraceRecord *record;
+    uint8_t flags = 0;
+
+    if (trace->write - trace->tail_cached > trace->capacity_mask) {
+        clem_mem_bus_trace_publish(trace);
+        trace->tail_cached = _clem_mem_load_acquire(&trace->tail);
+        if (trace->write - trace->tail_cached > trace->capacity_mask) {
+            ++trace->dropped;
+            trace->gap = true;
+            return;
+        }
+    }
+    if (!pins->rwbOut)
+        flags |= CLEM_BUS_TRACE_FLAG_WRITE;
+    if (pins->vdaOut)
+        flags |= CLEM_BUS_TRACE_FLAG_VDA;
+    if (pins->vpaOut)
+        flags |= CLEM_BUS_TRACE_FLAG_VPA;
+    if (pins->ioOut)
+        flags |= CLEM_BUS_TRACE_FLAG_IO;
+    if (mega2_access)
+        flags |= CLEM_BUS_TRACE_FLAG_MEGA2;
+    if (trace->gap) {
+        flags |= CLEM_BUS_TRACE_FLAG_GAP;
+        trace->gap = false;
+    }
+    record = &trace->records[trace->write & trace->capacity_mask];
+    record->ts = ts;
+    record->adr = pins->adr;
+    record->bank = pins->bank;
+    record->data = pins->data;
+    record->flags = flags;
+    record->reserved[0] = record->reserved[1] = record->reserved[2] = 0;
+    ++trace->write;
+    if (!(trace->write & (CLEM_MEM_BUS_TRACE_BATCH - 1))) {
+        clem_mem_bus_trace_publish(trace);
+    }
+}
+
+//  Every CPU bus cycle issued by this module goes through here, after the pins
+//  describe the access
+static inline void _clem_mem_bus_cycle(ClemensMachine *clem, bool mega2_access) {
+    //  opcode fetches assert both VDA and VPA and are not data accesses
+    if (clem->cpu.pins.vdaOut && !clem->cpu.pins.vpaOut && clem->mem.last_data_address) {
+        *clem->mem.last_data_address = ((uint32_t)clem->cpu.pins.bank << 16) | clem->cpu.pins.adr;
+    }
+    _clem_mem_cycle(clem, mega2_access);
+    if (clem->mem.bus_trace) {
+        _clem_mem_bus_trace(clem->mem.bus_trace, &clem->cpu.pins, clem->tspec.clocks_spent,
+                            mega2_access);
+    }
+}
+
+static inline bool _clem_mem_is_watched_page(ClemensMachine *clem, uint16_t adr) {
+    return (clem->dev_debug.watch_pages[adr >> 11] & (1 << ((adr >> 8) & 0x7))) != 0;
+}
+
+//  Data accesses to pages with watchpoints are checked against the exact
+//  addresses.  A hit is picked up by the debug break check after the instruction.
+static void _clem_mem_watch_check(ClemensMachine *clem, unsigned type, uint8_t bank,
+                                  uint16_t adr) {
+    uint32_t key = CLEM_DEBUG_BREAKPOINT_KEY(type, bank, adr);
+    if (clem_debug_has_breakpoint(&clem->dev_debug, key)) {
+        clem->dev_debug.watch_hit = key;
+    }
+}
+
+//  Polling and status registers that can be read without side effects.  Reads
+//  of any other I/O register count as a mutation for idle loop detection.
+static bool _clem_mem_is_io_read_pure(uint16_t offset) {
+    uint8_t ioreg = (uint8_t)(offset & 0xff);
+    if (ioreg < 0x10 || (ioreg > 0x10 && ioreg < 0x20))
+        return true; // keyboard data and soft switch status
+    switch (ioreg) {
+    case 0x23: // VGC interrupt status
+    case 0x2E: // vertical counter
+    case 0x35: // shadow register
+    case 0x36: // speed register
+    case 0x61: // buttons
+    case 0x62:
+    case 0x63:
+    case 0x68: // state register
+        return true;
+    }
+    return false;
 }
 
 void clem_read(ClemensMachine *clem, uint8_t *data, uint16_t adr, uint8_t bank, uint8_t flags) {
     struct ClemensMemoryPageMap *bank_page_map = clem->mem.bank_page_map[bank];
     struct ClemensMemoryPageInfo *page = &bank_page_map->pages[adr >> 8];
     uint16_t offset = ((uint16_t)page->read << 8) | (adr & 0xff);
+    uint8_t *host_read = page->host_read;
     bool read_only = (flags == CLEM_MEM_FLAG_NULL);
     bool mega2_access = false;
     bool io_access = false;
+    bool io_sync = false;
+
+    if (!host_read && (page->flags & CLEM_MEM_PAGE_HOST_DIRECT_READ_FLAG)) {
+        host_read = clem->mem.fpi_bank_map[bank] + (adr & 0xff00);
+    }
+    if (host_read) {
+        *data = host_read[adr & 0xff];
+        if (!read_only) {
+            clem->cpu.pins.adr = adr;
+            clem->cpu.pins.bank = bank;
+            clem->cpu.pins.data = *data;
+            clem->cpu.pins.vpaOut = (flags & CLEM_MEM_FLAG_PROGRAM) != 0;
+            clem->cpu.pins.vdaOut = (flags & CLEM_MEM_FLAG_DATA) != 0;
+            clem->cpu.pins.rwbOut = true;
+            clem->cpu.pins.ioOut = false;
+            _clem_mem_bus_cycle(clem, (page->flags & CLEM_MEM_PAGE_HOST_MEGA2_READ_FLAG) != 0);
+        }
+        return;
+    }
 
     // TODO: store off if read_reg has a read_count of 1 here
     //       reset it automatically if true at the end of this function
@@ -35,8 +206,18 @@ void clem_read(ClemensMachine *clem, uint8_t *data, uint16_t adr, uint8_t bank,
             } else {
                 *data = (*clem->mem.mmio_read)(&clem->mem, &clem->tspec, offset,
                                                read_only ? CLEM_OP_IO_NO_OP : 0, &mega2_access);
+                //  device state only changes at MMIO events, so polling reads
+                //  return the same value until then and need no sync
+                if (!read_only && !_clem_mem_is_io_read_pure(offset)) {
+                    ++clem->mem.mutation_count;
+                    io_sync = true;
+                }
             }
         } else if (page->flags & CLEM_MEM_PAGE_CARDMEM_FLAG) {
+            if (!read_only) {
+                ++clem->mem.mutation_count;
+            }
+            io_sync = true;
             *data = (*clem->mem.mmio_read)(
                 &clem->mem, &clem->tspec, ((uint16_t)page->read << 8) | (adr & 0xff),
                 (read_only ? CLEM_OP_IO_NO_OP : 0) | CLEM_OP_IO_CARD, &mega2_access);
@@ -64,6 +245,20 @@ void clem_read(ClemensMachine *clem, uint8_t *data, uint16_t adr, uint8_t bank,
             mega2_access = true;
         }
         *data = bank_mem[offset];
+        //  direct FPI pages come from page maps shared across banks, and so
+        //  can't hold a single host pointer
+        if (!_clem_mem_is_watched_page(clem, adr)) {
+            if (!(page->flags & CLEM_MEM_PAGE_DIRECT_FLAG) || mega2_access) {
+                page->host_read = bank_mem + ((uint16_t)page->read << 8);
+                if (mega2_access) {
+                    page->flags |= CLEM_MEM_PAGE_HOST_MEGA2_READ_FLAG;
+                } else {
+                    page->flags &= ~CLEM_MEM_PAGE_HOST_MEGA2_READ_FLAG;
+                }
+            } else {
+                page->flags |= CLEM_MEM_PAGE_HOST_DIRECT_READ_FLAG;
+            }
+        }
     } else {
         CLEM_ASSERT(false);
     }
@@ -77,7 +272,11 @@ void clem_read(ClemensMachine *clem, uint8_t *data, uint16_t adr, uint8_t bank,
         clem->cpu.pins.vdaOut = (flags & CLEM_MEM_FLAG_DATA) != 0;
         clem->cpu.pins.rwbOut = true;
         clem->cpu.pins.ioOut = io_access;
-        _clem_mem_cycle(clem, mega2_access);
+        clem->mem.mmio_accessed |= io_sync;
+        _clem_mem_bus_cycle(clem, mega2_access);
+        if ((flags & CLEM_MEM_FLAG_DATA) && _clem_mem_is_watched_page(clem, adr)) {
+            _clem_mem_watch_check(clem, kClemensDebugBreakpoint_DataRead, bank, adr);
+        }
     }
 }
 
@@ -85,12 +284,39 @@ void clem_write(ClemensMachine *clem, uint8_t data, uint16_t adr, uint8_t bank,
     struct ClemensMemoryPageMap **bank_map = clem->mem.bank_page_map;
     struct ClemensMemoryPageMap *bank_page_map = bank_map[bank];
     struct ClemensMemoryShadowMap *shadow_map;
-    struct ClemensMemoryPageInfo *page = &bank_page_map->pages[adr >> 8];
+    struct ClemensMemoryPageInfo *src_page = &bank_page_map->pages[adr >> 8];
+    struct ClemensMemoryPageInfo *page = src_page;
+    uint8_t *host_write = page->host_write;
+    uint8_t host_write_bank = page->host_write_bank;
     uint16_t offset;
     uint8_t flags = mem_flags == CLEM_MEM_FLAG_NULL ? CLEM_OP_IO_NO_OP : 0;
     bool mega2_access = false;
     bool io_access = false;
 
+    ++clem->mem.mutation_count;
+
+    if (!host_write && (page->flags & CLEM_MEM_PAGE_HOST_DIRECT_WRITE_FLAG)) {
+        host_write = clem->mem.fpi_bank_map[bank] + (adr & 0xff00);
+        host_write_bank = bank;
+    }
+    if (host_write) {
+        host_write[adr & 0xff] = data;
+        if (page->flags & CLEM_MEM_PAGE_HOST_MEGA2_WRITE_FLAG) {
+            _clem_mem_mega2_dirty(&clem->mem, host_write_bank, page->host_write_page);
+        }
+        if (mem_flags != CLEM_MEM_FLAG_NULL) {
+            clem->cpu.pins.adr = adr;
+            clem->cpu.pins.bank = bank;
+            clem->cpu.pins.data = data;
+            clem->cpu.pins.vpaOut = false;
+            clem->cpu.pins.vdaOut = (mem_flags & CLEM_MEM_FLAG_DATA) != 0;
+            clem->cpu.pins.rwbOut = false;
+            clem->cpu.pins.ioOut = false;
+            _clem_mem_bus_cycle(clem, (page->flags & CLEM_MEM_PAGE_HOST_MEGA2_WRITE_FLAG) != 0);
+        }
+        return;
+    }
+
     if (page->flags & CLEM_MEM_IO_MEMORY_MASK) {
         unsigned slot_idx;
         offset = ((uint16_t)page->write << 8) | (adr & 0xff);
@@ -129,16 +355,37 @@ void clem_write(ClemensMachine *clem, uint8_t data, uint16_t adr, uint8_t bank,
         offset = ((uint16_t)page->write << 8) | (adr & 0xff);
         if (page->flags & CLEM_MEM_PAGE_WRITEOK_FLAG) {
             bank_mem[offset] = data;
+            if (mega2_access) {
+                _clem_mem_mega2_dirty(&clem->mem, bank_actual, page->write);
+            }
         }
         if (shadow_map && shadow_map->pages[page->write]) {
             bank_mem = _clem_get_memory_bank(clem, (0xE0) | (bank_actual & 0x1), &mega2_access);
             if (page->flags & CLEM_MEM_PAGE_WRITEOK_FLAG) {
                 bank_mem[offset] = data;
+                _clem_mem_mega2_dirty(&clem->mem, bank_actual, page->write);
             }
         }
         if (bank_actual == 0xe0 || bank_actual == 0xe1) {
             mega2_access = true;
         }
+        //  only unshadowed, writable pages take the fast path
+        if ((page->flags & CLEM_MEM_PAGE_WRITEOK_FLAG) &&
+            !(shadow_map && shadow_map->pages[page->write]) &&
+            !_clem_mem_is_watched_page(clem, adr)) {
+            src_page->host_write_page = page->write;
+            if (!(src_page->flags & CLEM_MEM_PAGE_DIRECT_FLAG) || mega2_access) {
+                src_page->host_write = bank_mem + ((uint16_t)page->write << 8);
+                src_page->host_write_bank = bank_actual;
+                if (mega2_access) {
+                    src_page->flags |= CLEM_MEM_PAGE_HOST_MEGA2_WRITE_FLAG;
+                } else {
+                    src_page->flags &= ~CLEM_MEM_PAGE_HOST_MEGA2_WRITE_FLAG;
+                }
+            } else {
+                src_page->flags |= CLEM_MEM_PAGE_HOST_DIRECT_WRITE_FLAG;
+            }
+        }
     } else {
         CLEM_ASSERT(false);
     }
@@ -150,6 +397,230 @@ void clem_write(ClemensMachine *clem, uint8_t data, uint16_t adr, uint8_t bank,
         clem->cpu.pins.vdaOut = (mem_flags & CLEM_MEM_FLAG_DATA) != 0;
         clem->cpu.pins.rwbOut = false;
         clem->cpu.pins.ioOut = io_access;
-        _clem_mem_cycle(clem, mega2_access);
+        clem->mem.mmio_accessed |= io_access;
+        _clem_mem_bus_cycle(clem, mega2_access);
+        if ((mem_flags & CLEM_MEM_FLAG_DATA) && _clem_mem_is_watched_page(clem, adr)) {
+            _clem_mem_watch_check(clem, kClemensDebugBreakpoint_Write, bank, adr);
+        }
+    }
+}
+
+//  A plain RAM/ROM page resolved for the block move below
+struct ClemensMemoryBlockPage {
+    uint8_t *mem;    // host memory for the page
+    uint8_t *shadow; // Mega II copy of the page if writes are shadowed
+    uint16_t offset; // page offset within bank_actual
+    uint8_t bank_actual;
+    bool mega2_access;
+};
+
+//  Mirrors the page resolution in clem_read and clem_write.  I/O and card pages
+//  (and read-only pages for writes) are left for the regular access path.
+static bool _clem_mem_block_page(ClemensMachine *clem, struct ClemensMemoryBlockPage *block,
+                                 uint16_t adr, uint8_t bank, bool write) {
+    struct ClemensMemoryPageMap **bank_map = clem->mem.bank_page_map;
+    struct ClemensMemoryPageInfo *page = &bank_map[bank]->pages[adr >> 8];
+    struct ClemensMemoryShadowMap *shadow_map;
+    uint8_t page_bank = write ? page->bank_write : page->bank_read;
+
+    if ((page->flags & CLEM_MEM_IO_MEMORY_MASK) ||
+        ((page->flags & CLEM_MEM_PAGE_TYPE_MASK) && !(page->flags & CLEM_MEM_PAGE_BANK_MASK))) {
+        return false;
+    }
+    if (page->flags & CLEM_MEM_PAGE_DIRECT_FLAG) {
+        block->bank_actual = bank;
+    } else if (page->flags & CLEM_MEM_PAGE_MAINAUX_FLAG) {
+        block->bank_actual = (bank & 0xfe) | (page_bank & 0x1);
+    } else {
+        block->bank_actual = page_bank;
+    }
+    block->mega2_access = false;
+    block->shadow = NULL;
+    if (!write) {
+        block->offset = (uint16_t)page->read << 8;
+        block->mem = _clem_get_memory_bank(clem, block->bank_actual, &block->mega2_access) +
+                     block->offset;
+        return true;
+    }
+    page = &bank_map[block->bank_actual]->pages[adr >> 8];
+    if (!(page->flags & CLEM_MEM_PAGE_WRITEOK_FLAG))
+        return false;
+    block->offset = (uint16_t)page->write << 8;
+    block->mem =
+        _clem_get_memory_bank(clem, block->bank_actual, &block->mega2_access) + block->offset;
+    shadow_map = bank_map[block->bank_actual]->shadow_map;
+    if (shadow_map && shadow_map->pages[page->write]) {
+        block->shadow = _clem_get_memory_bank(clem, 0xe0 | (block->bank_actual & 0x1),
+                                              &block->mega2_access) +
+                        block->offset;
+    }
+    return true;
+}
+
+static bool _clem_mem_block_overlaps(const uint8_t *a, const uint8_t *b, unsigned count) {
+    return a < b + count && b < a + count;
+}
+
+unsigned clem_mem_block_move(ClemensMachine *clem, clem_clocks_time_t clocks) {
+    struct Clemens65C816 *cpu = &clem->cpu;
+    struct ClemensTimeSpec *tspec = &clem->tspec;
+    struct ClemensMemoryBlockPage program, src, dst;
+    const bool decrement = cpu->regs.IR == CLEM_OPC_MVP;
+    const bool x_status = (cpu->regs.P & kClemensCPUStatus_Index) != 0;
+    uint8_t src_bank, dst_bank, data = 0;
+    unsigned moved = 0;
+
+    //  the opcode and both operands must come from the same page
+    if ((cpu->regs.PC & 0xff) > 0xfd)
+        return 0;
+    if (!_clem_mem_block_page(clem, &program, cpu->regs.PC, cpu->regs.PBR, false))
+        return 0;
+    dst_bank = program.mem[(cpu->regs.PC + 1) & 0xff];
+    src_bank = program.mem[(cpu->regs.PC + 2) & 0xff];
+
+    //  the instruction itself moves the last byte and advances the PC
+    while (cpu->regs.A != 0 && tspec->clocks_spent < clocks) {
+        const bool slow = tspec->clocks_step == CLEM_CLOCKS_PHI0_CYCLE;
+        uint8_t src_lo = (uint8_t)cpu->regs.X, dst_lo = (uint8_t)cpu->regs.Y;
+        const uint8_t *src_mem;
+        uint8_t *dst_mem, *shadow_mem;
+        unsigned count, i;
+
+        if (!_clem_mem_block_page(clem, &src, cpu->regs.X, src_bank, false))
+            break;
+        if (!_clem_mem_block_page(clem, &dst, cpu->regs.Y, dst_bank, true))
+            break;
+
+        //  move whole runs up to the nearest page boundary
+        if (decrement) {
+            count = (src_lo < dst_lo ? src_lo : dst_lo) + 1;
+        } else {
+            count = 256 - (src_lo > dst_lo ? src_lo : dst_lo);
+        }
+        if (count > cpu->regs.A) {
+            count = cpu->regs.A;
+        }
+
+        //  each byte is an opcode and two operand fetches, the read, the write and
+        //  two internal cycles - stopping after the byte that reaches the deadline
+        if (!slow && tspec->clocks_step <= CLEM_CLOCKS_PHI0_CYCLE && !program.mega2_access &&
+            !src.mega2_access && !dst.mega2_access) {
+            clem_clocks_time_t byte_clocks = 7 * (clem_clocks_time_t)tspec->clocks_step;
+            clem_clocks_time_t limit =
+                (clocks - tspec->clocks_spent + byte_clocks - 1) / byte_clocks;
+            if (count > limit) {
+                count = (unsigned)limit;
+            }
+            tspec->clocks_spent += count * byte_clocks;
+            while (tspec->clocks_spent >= tspec->clocks_next_phi0) {
+                _clem_timespec_next_phi0(tspec);
+            }
+        } else {
+            for (i = 0; i < count;) {
+                _clem_timespec_cycle(tspec, slow || program.mega2_access);
+                _clem_timespec_cycle(tspec, slow || program.mega2_access);
+                _clem_timespec_cycle(tspec, slow || program.mega2_access);
+                _clem_timespec_cycle(tspec, slow || src.mega2_access);
+                _clem_timespec_cycle(tspec, slow || dst.mega2_access);
+                _clem_timespec_cycle(tspec, slow);
+                _clem_timespec_cycle(tspec, slow);
+                ++i;
+                if (tspec->clocks_spent >= clocks)
+                    break;
+            }
+            count = i;
+        }
+
+        //  byte order matters when the source and destination overlap
+        src_mem = src.mem + (decrement ? src_lo + 1 - count : src_lo);
+        dst_mem = dst.mem + (decrement ? dst_lo + 1 - count : dst_lo);
+        shadow_mem = dst.shadow ? dst.shadow + (dst_mem - dst.mem) : NULL;
+        if (!_clem_mem_block_overlaps(src_mem, dst_mem, count) &&
+            !(shadow_mem && _clem_mem_block_overlaps(src_mem, shadow_mem, count))) {
+            memcpy(dst_mem, src_mem, count);
+            if (shadow_mem) {
+                memcpy(shadow_mem, src_mem, count);
+            }
+        } else {
+            for (i = 0; i < count; ++i) {
+                unsigned s = decrement ? count - 1 - i : i;
+                uint8_t v = src_mem[s];
+                dst_mem[s] = v;
+                if (shadow_mem) {
+                    shadow_mem[s] = v;
+                }
+            }
+        }
+        data = decrement ? dst_mem[0] : dst_mem[count - 1];
+        if (dst.bank_actual == 0xe0 || dst.bank_actual == 0xe1 || shadow_mem) {
+            _clem_mem_mega2_dirty(&clem->mem, dst.bank_actual, (uint8_t)(dst.offset >> 8));
+        }
+
+        //  the bus is left as it would be after the last write
+        cpu->pins.adr = decrement ? cpu->regs.Y - (count - 1) : cpu->regs.Y + (count - 1);
+        cpu->pins.bank = dst_bank;
+        cpu->pins.data = data;
+        cpu->pins.vpaOut = false;
+        cpu->pins.vdaOut = true;
+        cpu->pins.rwbOut = false;
+        cpu->pins.ioOut = false;
+        if (clem->mem.last_data_address) {
+            *clem->mem.last_data_address = ((uint32_t)dst_bank << 16) | cpu->pins.adr;
+        }
+
+        if (decrement) {
+            cpu->regs.X = x_status ? CLEM_UTIL_set16_lo(cpu->regs.X, cpu->regs.X - count)
+                                   : (uint16_t)(cpu->regs.X - count);
+            cpu->regs.Y = x_status ? CLEM_UTIL_set16_lo(cpu->regs.Y, cpu->regs.Y - count)
+                                   : (uint16_t)(cpu->regs.Y - count);
+        } else {
+            cpu->regs.X = x_status ? CLEM_UTIL_set16_lo(cpu->regs.X, cpu->regs.X + count)
+                                   : (uint16_t)(cpu->regs.X + count);
+            cpu->regs.Y = x_status ? CLEM_UTIL_set16_lo(cpu->regs.Y, cpu->regs.Y + count)
+                                   : (uint16_t)(cpu->regs.Y + count);
+        }
+        cpu->regs.A -= count;
+        cpu->cycles_spent += 7 * count;
+        clem->mem.mutation_count += count;
+        moved += count;
+    }
+    return moved;
+}
+
+void clem_mem_dma(ClemensMachine *clem, uint8_t *data, uint16_t adr, uint8_t bank, unsigned count,
+                  bool write) {
+    struct ClemensMemoryBlockPage block;
+    unsigned run, i;
+
+    while (count > 0) {
+        uint8_t lo = (uint8_t)(adr & 0xff);
+        run = 256 - lo;
+        if (run > count) {
+            run = count;
+        }
+        if (!_clem_mem_block_page(clem, &block, adr, bank, write)) {
+            for (i = 0; i < run; ++i) {
+                if (write) {
+                    clem_write(clem, data[i], adr + i, bank, CLEM_MEM_FLAG_NULL);
+                } else {
+                    clem_read(clem, &data[i], adr + i, bank, CLEM_MEM_FLAG_NULL);
+                }
+            }
+        } else if (write) {
+            memcpy(block.mem + lo, data, run);
+            if (block.shadow) {
+                memcpy(block.shadow + lo, data, run);
+            }
+            if (block.bank_actual == 0xe0 || block.bank_actual == 0xe1 || block.shadow) {
+                _clem_mem_mega2_dirty(&clem->mem, block.bank_actual,
+                                      (uint8_t)(block.offset >> 8));
+            }
+            clem->mem.mutation_count += run;
+        } else {
+            memcpy(data, block.mem + lo, run);
+        }
+        data += run;
+        adr += (uint16_t)run;
+        count -= run;
     }
 }
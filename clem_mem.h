@@ -40,10 +40,35 @@ extern "C" {
 
 void clem_mem_create_page_mapping(struct ClemensMemoryPageInfo *page, uint8_t page_idx,
                                   uint8_t bank_read_idx, uint8_t bank_write_idx);
+/* Must be called when a page map's entries change so that clem_read/clem_write
+   re-resolve their host memory pointers */
+void clem_mem_page_map_clear_host(struct ClemensMemoryPageMap *page_map);
 
 void clem_read(ClemensMachine *clem, uint8_t *data, uint16_t adr, uint8_t bank, uint8_t flags);
 void clem_write(ClemensMachine *clem, uint8_t data, uint16_t adr, uint8_t bank, uint8_t flags);
 
+/* Continues the MVN/MVP at the PC in bulk while it moves plain RAM/ROM, with
+   shadowing and the same 7 cycles per byte as repeating the instruction.
+   Stops at I/O, card or read-only pages, once the clock reaches 'clocks' and
+   before the last byte so the instruction itself completes the move.
+   Returns the number of bytes moved. */
+unsigned clem_mem_block_move(ClemensMachine *clem, clem_clocks_time_t clocks);
+
+/* Moves 'count' bytes between 'data' and memory at bank:adr for card DMA.  As with
+   clem_read/clem_write using CLEM_MEM_FLAG_NULL, no CPU bus cycles are issued.
+   Addresses wrap within the bank.  Plain RAM is copied a page at a time with
+   shadowing, and other pages are accessed a byte at a time. */
+void clem_mem_dma(ClemensMachine *clem, uint8_t *data, uint16_t adr, uint8_t bank, unsigned count,
+                  bool write);
+
+/* Bus trace ring - clem_read and clem_write append a record per bus cycle
+   while clem->mem.bus_trace is set.  Records are made visible to the consumer
+   in batches and by clem_mem_bus_trace_publish().  clem_mem_bus_trace_read()
+   may be called from another thread. */
+void clem_mem_bus_trace_publish(struct ClemensBusTrace *trace);
+unsigned clem_mem_bus_trace_read(struct ClemensBusTrace *trace,
+                                 struct ClemensBusTraceRecord *records, unsigned limit);
+
 #ifdef __cplusplus
 }
 #endif
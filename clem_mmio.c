@@ -87,13 +87,16 @@
  */
 
 static void _clem_mmio_memory_map(ClemensMMIO *mmio, uint32_t memory_flags);
-static void _clem_mmio_shadow_map(ClemensMMIO *mmio, uint32_t shadow_flags);
+static void _clem_mmio_shadow_map(struct ClemensMMIOPageMapSet *page_map_set,
+                                  uint32_t shadow_flags);
 
 static void _clem_mmio_create_page_direct_mapping(struct ClemensMemoryPageInfo *page,
                                                   uint8_t page_idx) {
     page->read = page_idx;
     page->write = page_idx;
     page->flags = CLEM_MEM_PAGE_WRITEOK_FLAG | CLEM_MEM_PAGE_DIRECT_FLAG;
+    page->host_read = NULL;
+    page->host_write = NULL;
 }
 
 static void _clem_mmio_create_page_mainaux_mapping(struct ClemensMemoryPageInfo *page,
@@ -103,6 +106,8 @@ static void _clem_mmio_create_page_mainaux_mapping(struct ClemensMemoryPageInfo
     page->read = page_idx;
     page->write = page_idx;
     page->flags = CLEM_MEM_PAGE_WRITEOK_FLAG | CLEM_MEM_PAGE_MAINAUX_FLAG;
+    page->host_read = NULL;
+    page->host_write = NULL;
 }
 
 static void _clem_mmio_clear_irq(ClemensMMIO *mmio, unsigned irq_flags) {
@@ -605,384 +610,167 @@ static uint8_t _clem_mmio_floating_bus(ClemensMMIO *mmio, struct ClemensTimeSpec
     return mmio->e0_bank[scanline->offset + h_counter];
 }
 
-uint8_t clem_mmio_read(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec, uint16_t addr,
-                       uint8_t flags, bool *mega2_access) {
-    struct ClemensClock ref_clock;
-    uint8_t result = 0x00;
-    uint8_t ioreg = addr & 0xff;
-    bool is_noop = (flags & CLEM_OP_IO_NO_OP) != 0;
-
-    //  SHADOW, CYA, DMA are fast
-    //  SLOT, STATE are fast (read-only)
-    *mega2_access = true;
+static void _clem_mmio_card_io_write(ClemensCard *card, struct ClemensClock *clock, uint8_t data,
+                                     uint8_t addr, uint8_t flags) {
+    if (card) {
+        if (!(flags & CLEM_OP_IO_NO_OP)) {
+            (*card->io_sync)(clock, card->context);
+        }
+        (*card->io_write)(clock, data, addr, flags, card->context);
+    }
+}
 
-    ref_clock.ts = tspec->clocks_spent;
-    ref_clock.ref_step = *mega2_access ? CLEM_CLOCKS_PHI0_CYCLE : tspec->clocks_step;
+/*  I/O register handlers
 
-    if (flags & CLEM_OP_IO_CARD) {
-        uint8_t slot_idx;
+    clem_mmio_read() and clem_mmio_write() dispatch on the low byte of the
+    address to the handlers registered by _clem_mmio_init_io_handlers().  The
+    handlers are grouped by device below.  Those that don't return data from a
+    device return the floating bus value where the hardware does.
+*/
 
-        if (addr == 0xCFFF) {
-            /* TODO: CFFF access */
-        } else if (addr < 0xCFFF && addr >= 0xC800) {
-            slot_idx = (uint8_t)(mmio->card_expansion_rom_index & 0xff);
-            if (slot_idx > 0 && slot_idx <= 7) {
-                result = mmio->card_slot_expansion_memory[slot_idx - 1][addr - 0xc800];
-            }
-        } else if (addr >= 0xC100) {
-            slot_idx = (uint8_t)(addr >> 8) - 0xc0 - 1;
-            if (mmio->card_slot[slot_idx]) {
-                result = _clem_mmio_card_io_read(mmio->card_slot[slot_idx], &ref_clock, ioreg,
-                                                 flags | CLEM_OP_IO_DEVSEL);
-            }
-        }
+static uint8_t _clem_mmio_read_unimpl(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                      struct ClemensClock *ref_clock, uint16_t addr, uint8_t flags,
+                                      bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)mega2_access;
+    if (!(flags & CLEM_OP_IO_NO_OP)) {
+        clem_debug_break(mmio->dev_debug, CLEM_DEBUG_BREAK_UNIMPL_IOREAD, addr, 0x0000);
+    }
+    return 0x00;
+}
 
-        return result;
+static void _clem_mmio_write_unimpl(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                    struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                    uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)mega2_access;
+    if (!(flags & CLEM_OP_IO_NO_OP)) {
+        clem_debug_break(mmio->dev_debug, CLEM_DEBUG_BREAK_UNIMPL_IOWRITE, addr, data);
     }
+}
 
-    switch (ioreg) {
-    case CLEM_MMIO_REG_KEYB_READ:
-    case CLEM_MMIO_REG_KEYB_READ + 1:
-    case CLEM_MMIO_REG_KEYB_READ + 2:
-    case CLEM_MMIO_REG_KEYB_READ + 3:
-    case CLEM_MMIO_REG_KEYB_READ + 4:
-    case CLEM_MMIO_REG_KEYB_READ + 5:
-    case CLEM_MMIO_REG_KEYB_READ + 6:
-    case CLEM_MMIO_REG_KEYB_READ + 7:
-    case CLEM_MMIO_REG_KEYB_READ + 8:
-    case CLEM_MMIO_REG_KEYB_READ + 9:
-    case CLEM_MMIO_REG_KEYB_READ + 10:
-    case CLEM_MMIO_REG_KEYB_READ + 11:
-    case CLEM_MMIO_REG_KEYB_READ + 12:
-    case CLEM_MMIO_REG_KEYB_READ + 13:
-    case CLEM_MMIO_REG_KEYB_READ + 14:
-    case CLEM_MMIO_REG_KEYB_READ + 15:
-    case CLEM_MMIO_REG_ANYKEY_STROBE:
-        result = clem_adb_read_mega2_switch(&mmio->dev_adb, ioreg, flags);
-        break;
-    case CLEM_MMIO_REG_ADB_MOUSE_DATA:
-    case CLEM_MMIO_REG_ADB_MODKEY:
-    case CLEM_MMIO_REG_ADB_CMD_DATA:
-    case CLEM_MMIO_REG_ADB_STATUS:
-        result = clem_adb_read_switch(&mmio->dev_adb, ioreg, flags);
-        break;
+//  Registers that are accessed as the other half of a 16-bit access to a
+//  neighboring register (i.e. NEWVIDEO, LANGSEL) and are ignored to avoid the
+//  unimplemented register warning
+static uint8_t _clem_mmio_read_none(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                    struct ClemensClock *ref_clock, uint16_t addr, uint8_t flags,
+                                    bool *mega2_access) {
+    (void)mmio;
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    return 0x00;
+}
+
+static void _clem_mmio_write_none(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                  struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                  uint8_t flags, bool *mega2_access) {
+    (void)mmio;
+    (void)tspec;
+    (void)ref_clock;
+    (void)data;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+}
+
+static uint8_t _clem_mmio_read_none_fast(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                         struct ClemensClock *ref_clock, uint16_t addr,
+                                         uint8_t flags, bool *mega2_access) {
+    (void)mmio;
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    *mega2_access = false;
+    return 0x00;
+}
+
+static void _clem_mmio_write_none_fast(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                       struct ClemensClock *ref_clock, uint8_t data,
+                                       uint16_t addr, uint8_t flags, bool *mega2_access) {
+    (void)mmio;
+    (void)tspec;
+    (void)ref_clock;
+    (void)data;
+    (void)addr;
+    (void)flags;
+    *mega2_access = false;
+}
+
+static uint8_t _clem_mmio_read_floating_bus(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                            struct ClemensClock *ref_clock, uint16_t addr,
+                                            uint8_t flags, bool *mega2_access) {
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    return _clem_mmio_floating_bus(mmio, tspec);
+}
+
+//  Memory mapping (//e soft switches, language card, IIgs registers)
+
+static uint8_t _clem_mmio_read_mmap_test(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                         struct ClemensClock *ref_clock, uint16_t addr,
+                                         uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)flags;
+    (void)mega2_access;
+    uint32_t mmap_flag = 0;
+    switch (addr & 0xff) {
     case CLEM_MMIO_REG_LC_BANK_TEST:
-        result = (mmio->mmap_register & CLEM_MEM_IO_MMAP_LCBANK2) ? 0x80 : 0x00;
+        mmap_flag = CLEM_MEM_IO_MMAP_LCBANK2;
         break;
     case CLEM_MMIO_REG_ROM_RAM_TEST:
-        result = (mmio->mmap_register & CLEM_MEM_IO_MMAP_RDLCRAM) ? 0x80 : 0x00;
+        mmap_flag = CLEM_MEM_IO_MMAP_RDLCRAM;
         break;
     case CLEM_MMIO_REG_RAMRD_TEST:
-        result = (mmio->mmap_register & CLEM_MEM_IO_MMAP_RAMRD) ? 0x80 : 0x00;
+        mmap_flag = CLEM_MEM_IO_MMAP_RAMRD;
         break;
     case CLEM_MMIO_REG_RAMWRT_TEST:
-        result = (mmio->mmap_register & CLEM_MEM_IO_MMAP_RAMWRT) ? 0x80 : 0x00;
-        break;
-    case CLEM_MMIO_REG_READCXROM:
-        result = !(mmio->mmap_register & CLEM_MEM_IO_MMAP_CXROM) ? 0x80 : 0x00;
+        mmap_flag = CLEM_MEM_IO_MMAP_RAMWRT;
         break;
     case CLEM_MMIO_REG_RDALTZP_TEST:
-        result = (mmio->mmap_register & CLEM_MEM_IO_MMAP_ALTZPLC) ? 0x80 : 0x00;
+        mmap_flag = CLEM_MEM_IO_MMAP_ALTZPLC;
         break;
     case CLEM_MMIO_REG_READC3ROM:
-        result = (mmio->mmap_register & CLEM_MEM_IO_MMAP_C3ROM) ? 0x80 : 0x00;
+        mmap_flag = CLEM_MEM_IO_MMAP_C3ROM;
         break;
     case CLEM_MMIO_REG_80COLSTORE_TEST:
-        result = (mmio->mmap_register & CLEM_MEM_IO_MMAP_80COLSTORE) ? 0x80 : 0x00;
-        break;
-    case CLEM_MMIO_REG_VBLBAR:
-    case CLEM_MMIO_REG_VGC_VERTCNT:
-    case CLEM_MMIO_REG_VGC_HORIZCNT:
-        result = clem_vgc_read_switch(&mmio->vgc, &ref_clock, ioreg, flags);
-        break;
-    case CLEM_MMIO_REG_TXT_TEST:
-        result = (mmio->vgc.mode_flags & CLEM_VGC_GRAPHICS_MODE) ? 0x00 : 0x80;
-        break;
-    case CLEM_MMIO_REG_MIXED_TEST:
-        result = (mmio->vgc.mode_flags & CLEM_VGC_MIXED_TEXT) ? 0x80 : 0x00;
+        mmap_flag = CLEM_MEM_IO_MMAP_80COLSTORE;
         break;
     case CLEM_MMIO_REG_TXTPAGE2_TEST:
-        result = (mmio->mmap_register & CLEM_MEM_IO_MMAP_TXTPAGE2) ? 0x80 : 0x00;
-        break;
-    case CLEM_MMIO_REG_ALTCHARSET_TEST:
-        result = (mmio->vgc.mode_flags & CLEM_VGC_ALTCHARSET) ? 0x80 : 0x00;
-        break;
-    case CLEM_MMIO_REG_HIRES_TEST:
-        result = (mmio->vgc.mode_flags & CLEM_VGC_HIRES) ? 0x80 : 0x00;
-        break;
-    case CLEM_MMIO_REG_80COLUMN_TEST:
-        result = (mmio->vgc.mode_flags & CLEM_VGC_80COLUMN_TEXT) ? 0x80 : 0x00;
-        break;
-    case CLEM_MMIO_REG_CASSETTE_PORT_NOP:
-        result = _clem_mmio_floating_bus(mmio, tspec);
-        break;
-    case CLEM_MMIO_REG_VGC_TEXT_COLOR:
-        result = (uint8_t)((mmio->vgc.text_fg_color << 4) | mmio->vgc.text_bg_color);
-        break;
-    case CLEM_MMIO_REG_VGC_IRQ_BYTE:
-        result = _clem_mmio_vgc_irq_c023_get(mmio);
-        break;
-    case CLEM_MMIO_REG_NEWVIDEO:
-        result = _clem_mmio_newvideo_c029(mmio);
-        break;
-    case CLEM_MMIO_REG_NEWVIDEO + 1:
-        // to avoid the uimpl read warning since GS/OS will often set/query NEWVIDEO as a 16-bit (2
-        // byte) operation
-        break;
-    case CLEM_MMIO_REG_LANGSEL:
-        result = clem_vgc_get_region(&mmio->vgc);
-        break;
-    case CLEM_MMIO_REG_CHARROM_TEST:
-        result = 0x00;          // TODO: unsure what to do unless we store the character ROM in memory vs font files
-        break;
-    case CLEM_MMIO_REG_SLOTROMSEL:
-        result = _clem_mmio_slotromsel_c02d(mmio);
-        *mega2_access = false;
-        break;
-    case CLEM_MMIO_REG_SPKR:
-        clem_sound_read_switch(&mmio->dev_audio, ioreg, flags);
-        result = _clem_mmio_floating_bus(mmio, tspec);
-        break;
-    case CLEM_MMIO_REG_DISK_INTERFACE:
-        result = clem_iwm_read_switch(&mmio->dev_iwm, &mmio->active_drives, tspec, ioreg, flags);
-        break;
-    case CLEM_MMIO_REG_RTC_VGC_SCANINT:
-        result = clem_vgc_read_switch(&mmio->vgc, &ref_clock, ioreg, flags);
-        break;
-    case CLEM_MMIO_REG_SHADOW:
-        result = _clem_mmio_shadow_c035(mmio);
-        *mega2_access = false;
-        break;
-    case CLEM_MMIO_REG_SPEED:
-        result = mmio->speed_c036;
-        *mega2_access = false;
-        break;
-    // TODO: DMA?  fast access as well
-    case CLEM_MMIO_REG_RTC_CTL:
-        if (!is_noop) {
-            clem_rtc_command(&mmio->dev_rtc, tspec->clocks_spent, CLEM_IO_READ);
-        }
-        result = mmio->dev_rtc.ctl_c034;
-        break;
-    case CLEM_MMIO_REG_RTC_DATA:
-        result = mmio->dev_rtc.data_c033;
-        break;
-    case CLEM_MMIO_REG_SCC_B_CMD:
-    case CLEM_MMIO_REG_SCC_A_CMD:
-    case CLEM_MMIO_REG_SCC_B_DATA:
-    case CLEM_MMIO_REG_SCC_A_DATA:
-        result = clem_scc_read_switch(&mmio->dev_scc, ioreg, flags);
-        break;
-    case CLEM_MMIO_REG_AUDIO_CTL:
-        result = clem_sound_read_switch(&mmio->dev_audio, ioreg, flags);
-        break;
-    case CLEM_MMIO_REG_AUDIO_DATA:
-        result = clem_sound_read_switch(&mmio->dev_audio, ioreg, flags);
-        break;
-    case CLEM_MMIO_REG_AUDIO_ADRLO:
-        result = clem_sound_read_switch(&mmio->dev_audio, ioreg, flags);
-        break;
-    case CLEM_MMIO_REG_AUDIO_ADRHI:
-        result = clem_sound_read_switch(&mmio->dev_audio, ioreg, flags);
-        break;
-    case CLEM_MMIO_REG_MEGA2_INTEN:
-        result = _clem_mmio_mega2_inten_get(mmio);
-        break;
-    case CLEM_MMIO_REG_MEGA2_MOUSE_DX:
-    case CLEM_MMIO_REG_MEGA2_MOUSE_DY:
-        result = clem_adb_read_mega2_switch(&mmio->dev_adb, ioreg, flags);
-        break;
-    case CLEM_MMIO_REG_DIAG_INTTYPE:
-        result = _clem_mmio_inttype_c046(mmio);
-        break;
-    case CLEM_MMIO_REG_CLRVBLINT:
-        if (!(flags & CLEM_OP_IO_NO_OP)) {
-            _clem_mmio_clrvblint_c047(mmio);
-        }
-        break;
-    case CLEM_MMIO_REG_EMULATOR:
-        if (mmio->emulator_detect == CLEM_MMIO_EMULATOR_DETECT_START) {
-            result = CLEM_EMULATOR_ID;
-            mmio->emulator_detect = CLEM_MMIO_EMULATOR_DETECT_VERSION;
-        } else if (mmio->emulator_detect == CLEM_MMIO_EMULATOR_DETECT_VERSION) {
-            result = CLEM_EMULATOR_VER;
-            mmio->emulator_detect = CLEM_MMIO_EMULATOR_DETECT_IDLE;
-        }
-        break;
-    case CLEM_MMIO_REG_TXTCLR:
-        if (!(flags & CLEM_OP_IO_NO_OP)) {
-            clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_GRAPHICS_MODE);
-        }
-        result = _clem_mmio_floating_bus(mmio, tspec);
-        break;
-    case CLEM_MMIO_REG_TXTSET:
-        if (!(flags & CLEM_OP_IO_NO_OP)) {
-            clem_vgc_clear_mode(&mmio->vgc, CLEM_VGC_GRAPHICS_MODE);
-        }
-        result = _clem_mmio_floating_bus(mmio, tspec);
-        break;
-    case CLEM_MMIO_REG_MIXCLR:
-        if (!(flags & CLEM_OP_IO_NO_OP)) {
-            clem_vgc_clear_mode(&mmio->vgc, CLEM_VGC_MIXED_TEXT);
-        }
-        result = _clem_mmio_floating_bus(mmio, tspec);
-        break;
-    case CLEM_MMIO_REG_MIXSET:
-        if (!(flags & CLEM_OP_IO_NO_OP)) {
-            clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_MIXED_TEXT);
-        }
-        result = _clem_mmio_floating_bus(mmio, tspec);
-        break;
-    case CLEM_MMIO_REG_TXTPAGE1:
-        if (!(flags & CLEM_OP_IO_NO_OP)) {
-            _clem_mmio_memory_map(mmio, mmio->mmap_register & ~CLEM_MEM_IO_MMAP_TXTPAGE2);
-        }
-        result = _clem_mmio_floating_bus(mmio, tspec);
-        break;
-    case CLEM_MMIO_REG_TXTPAGE2:
-        if (!(flags & CLEM_OP_IO_NO_OP)) {
-            _clem_mmio_memory_map(mmio, mmio->mmap_register | CLEM_MEM_IO_MMAP_TXTPAGE2);
-        }
-        result = _clem_mmio_floating_bus(mmio, tspec);
-        break;
-    case CLEM_MMIO_REG_LORES:
-        /* implicitly clears hires */
-        if (!(flags & CLEM_OP_IO_NO_OP)) {
-            clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_LORES);
-        }
-        result = _clem_mmio_floating_bus(mmio, tspec);
-        break;
-    case CLEM_MMIO_REG_HIRES:
-        /* implicitly clears lores */
-        if (!(flags & CLEM_OP_IO_NO_OP)) {
-            clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_HIRES);
-        }
-        result = _clem_mmio_floating_bus(mmio, tspec);
-        break;
-    case CLEM_MMIO_REG_AN0_OFF:
-    case CLEM_MMIO_REG_AN0_ON:
-    case CLEM_MMIO_REG_AN1_OFF:
-    case CLEM_MMIO_REG_AN1_ON:
-    case CLEM_MMIO_REG_AN2_OFF:
-    case CLEM_MMIO_REG_AN2_ON:
-    case CLEM_MMIO_REG_SW0:
-    case CLEM_MMIO_REG_SW1:
-    case CLEM_MMIO_REG_SW2:
-    case CLEM_MMIO_REG_SW3:
-        result = clem_adb_read_switch(&mmio->dev_adb, ioreg, flags);
-        break;
-    case CLEM_MMIO_REG_AN3_OFF:
-    case CLEM_MMIO_REG_AN3_ON:
-        /* AN3 used for double hires graphics */
-        if (!is_noop) {
-            if (ioreg == CLEM_MMIO_REG_AN3_ON) {
-                clem_vgc_clear_mode(&mmio->vgc, CLEM_VGC_DISABLE_AN3);
-            } else {
-                clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_DISABLE_AN3);
-            }
-        }
-        result = clem_adb_read_switch(&mmio->dev_adb, ioreg, flags);
-        break;
-    case CLEM_MMIO_REG_PADDL0:
-    case CLEM_MMIO_REG_PADDL1:
-    case CLEM_MMIO_REG_PADDL2:
-    case CLEM_MMIO_REG_PADDL3:
-    case CLEM_MMIO_REG_PTRIG:
-        /* note c071 - 7f are reserved for ROM access - used for the
-           BRK interrupt */
-        result = clem_adb_read_switch(&mmio->dev_adb, ioreg, flags);
-        break;
-    case CLEM_MMIO_REG_STATEREG:
-        result = _clem_mmio_statereg_c068(mmio);
-        *mega2_access = false;
-        break;
-    case CLEM_MMIO_REG_STATEREG+1:
-        *mega2_access = false;
-        break;
-    case CLEM_MMIO_REG_LC2_RAM_WP:
-    case CLEM_MMIO_REG_LC2_RAM_WP2:
-    case CLEM_MMIO_REG_LC2_ROM_WE:
-    case CLEM_MMIO_REG_LC2_ROM_WE2:
-    case CLEM_MMIO_REG_LC2_ROM_WP:
-    case CLEM_MMIO_REG_LC2_ROM_WP2:
-    case CLEM_MMIO_REG_LC2_RAM_WE:
-    case CLEM_MMIO_REG_LC2_RAM_WE2:
-    case CLEM_MMIO_REG_LC1_RAM_WP:
-    case CLEM_MMIO_REG_LC1_RAM_WP2:
-    case CLEM_MMIO_REG_LC1_ROM_WE:
-    case CLEM_MMIO_REG_LC1_ROM_WE2:
-    case CLEM_MMIO_REG_LC1_ROM_WP:
-    case CLEM_MMIO_REG_LC1_ROM_WP2:
-    case CLEM_MMIO_REG_LC1_RAM_WE:
-    case CLEM_MMIO_REG_LC1_RAM_WE2:
-        if (!(flags & CLEM_OP_IO_NO_OP)) {
-            _clem_mmio_rw_bank_select(mmio, addr);
-        }
-        result = _clem_mmio_floating_bus(mmio, tspec);
-        break;
-    case CLEM_MMIO_REG_IWM_PHASE0_LO:
-    case CLEM_MMIO_REG_IWM_PHASE0_HI:
-    case CLEM_MMIO_REG_IWM_PHASE1_LO:
-    case CLEM_MMIO_REG_IWM_PHASE1_HI:
-    case CLEM_MMIO_REG_IWM_PHASE2_LO:
-    case CLEM_MMIO_REG_IWM_PHASE2_HI:
-    case CLEM_MMIO_REG_IWM_PHASE3_LO:
-    case CLEM_MMIO_REG_IWM_PHASE3_HI:
-    case CLEM_MMIO_REG_IWM_DRIVE_DISABLE:
-    case CLEM_MMIO_REG_IWM_DRIVE_ENABLE:
-    case CLEM_MMIO_REG_IWM_DRIVE_0:
-    case CLEM_MMIO_REG_IWM_DRIVE_1:
-    case CLEM_MMIO_REG_IWM_Q6_LO:
-    case CLEM_MMIO_REG_IWM_Q6_HI:
-    case CLEM_MMIO_REG_IWM_Q7_LO:
-    case CLEM_MMIO_REG_IWM_Q7_HI:
-        result = clem_iwm_read_switch(&mmio->dev_iwm, &mmio->active_drives, tspec, ioreg, flags);
-        break;
-    default:
-        if (ioreg >= 0x90) {
-            result = _clem_mmio_card_io_read(mmio->card_slot[(ioreg - 0x90) >> 4], &ref_clock,
-                                             ioreg & 0xf, flags);
-        } else if (!is_noop) {
-            clem_debug_break(mmio->dev_debug, CLEM_DEBUG_BREAK_UNIMPL_IOREAD, addr, 0x0000);
-        }
+        mmap_flag = CLEM_MEM_IO_MMAP_TXTPAGE2;
         break;
     }
-
-    return result;
+    return (mmio->mmap_register & mmap_flag) ? 0x80 : 0x00;
 }
 
-static void _clem_mmio_card_io_write(ClemensCard *card, struct ClemensClock *clock, uint8_t data,
-                                     uint8_t addr, uint8_t flags) {
-    if (card) {
-        if (!(flags & CLEM_OP_IO_NO_OP)) {
-            (*card->io_sync)(clock, card->context);
-        }
-        (*card->io_write)(clock, data, addr, flags, card->context);
-    }
+static uint8_t _clem_mmio_read_cxrom_test(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                          struct ClemensClock *ref_clock, uint16_t addr,
+                                          uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    return !(mmio->mmap_register & CLEM_MEM_IO_MMAP_CXROM) ? 0x80 : 0x00;
 }
 
-void clem_mmio_write(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec, uint8_t data, uint16_t addr,
-                     uint8_t flags, bool *mega2_access) {
-    struct ClemensClock ref_clock;
-    bool is_noop = (flags & CLEM_OP_IO_NO_OP) != 0;
-    uint8_t ioreg = (addr & 0xff);
-
-    //  SHADOW, SPEED and DMA are fast
-    *mega2_access = true;
-
-    ref_clock.ts = tspec->clocks_spent;
-    ref_clock.ref_step = *mega2_access ? CLEM_CLOCKS_PHI0_CYCLE : tspec->clocks_step;
-
-    if ((flags & CLEM_OP_IO_CARD) && addr >= 0xC100) {
-        uint8_t slot_idx = (uint8_t)(addr >> 8) - 0xc0 - 1;
-        if (mmio->card_slot[slot_idx]) {
-            _clem_mmio_card_io_write(mmio->card_slot[slot_idx], &ref_clock, data, ioreg,
-                                     flags | CLEM_OP_IO_DEVSEL);
-        }
-        return;
-    }
-
-    switch (ioreg) {
+static void _clem_mmio_write_mmap_switch(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                         struct ClemensClock *ref_clock, uint8_t data,
+                                         uint16_t addr, uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)data;
+    (void)flags;
+    (void)mega2_access;
+    switch (addr & 0xff) {
     case CLEM_MMIO_REG_80STOREOFF_WRITE:
         _clem_mmio_memory_map(mmio, mmio->mmap_register & ~CLEM_MEM_IO_MMAP_80COLSTORE);
         break;
@@ -1019,127 +807,123 @@ void clem_mmio_write(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec, uint8_t d
     case CLEM_MMIO_REG_INTC3ROM:
         _clem_mmio_memory_map(mmio, mmio->mmap_register & ~CLEM_MEM_IO_MMAP_C3ROM);
         break;
-    case CLEM_MMIO_REG_80COLUMN_OFF:
-        clem_vgc_clear_mode(&mmio->vgc, CLEM_VGC_80COLUMN_TEXT);
-        break;
-    case CLEM_MMIO_REG_80COLUMN_ON:
-        clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_80COLUMN_TEXT);
-        break;
-    case CLEM_MMIO_REG_ALTCHARSET_OFF:
-        clem_vgc_clear_mode(&mmio->vgc, CLEM_VGC_ALTCHARSET);
-        break;
-    case CLEM_MMIO_REG_ALTCHARSET_ON:
-        clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_ALTCHARSET);
-        break;
-    case CLEM_MMIO_REG_VGC_MONO:
-        if (data & 0x80) {
-            clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_MONOCHROME);
-        } else {
-            clem_vgc_clear_mode(&mmio->vgc, CLEM_VGC_MONOCHROME);
-        }
-        break;
-    case CLEM_MMIO_REG_VGC_TEXT_COLOR:
-        clem_vgc_set_text_colors(&mmio->vgc, (data & 0xf0) >> 4, data & 0x0f);
-        break;
-    case CLEM_MMIO_REG_VGC_IRQ_BYTE:
-        _clem_mmio_vgc_irq_c023_set(mmio, data);
-        break;
-    case CLEM_MMIO_REG_ANYKEY_STROBE:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 1:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 2:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 3:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 4:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 5:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 6:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 7:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 8:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 9:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 10:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 11:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 12:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 13:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 14:
-    case CLEM_MMIO_REG_ANYKEY_STROBE + 15:
-    case CLEM_MMIO_REG_ADB_MOUSE_DATA:
-    case CLEM_MMIO_REG_ADB_MODKEY:
-    case CLEM_MMIO_REG_ADB_CMD_DATA:
-    case CLEM_MMIO_REG_ADB_STATUS:
-        clem_adb_write_switch(&mmio->dev_adb, ioreg, data);
-        break;
-    case CLEM_MMIO_REG_NEWVIDEO:
-        _clem_mmio_newvideo_c029_set(mmio, data);
-        break;
-    case CLEM_MMIO_REG_NEWVIDEO + 1:
-        // to avoid the uimpl read warning since GS/OS will often set/query NEWVIDEO as a 16-bit (2
-        // byte) operation
-        break;
-    case CLEM_MMIO_REG_LANGSEL:
-        clem_vgc_set_region(&mmio->vgc, data);
-        break;
-    case CLEM_MMIO_REG_CHARROM_TEST:
-        //  NO-OP - avoid the unimpl warning if done as a 16-bit write to LANGSEL
-        break;
-    case CLEM_MMIO_REG_SLOTROMSEL:
-        _clem_mmio_slotrom_select_c02d(mmio, data);
-        break;
-    case CLEM_MMIO_REG_SPKR:
-        clem_sound_write_switch(&mmio->dev_audio, ioreg, data);
-        break;
-    case CLEM_MMIO_REG_DISK_INTERFACE:
-        clem_iwm_write_switch(&mmio->dev_iwm, &mmio->active_drives, tspec, ioreg, data);
-        break;
-    case CLEM_MMIO_REG_RTC_VGC_SCANINT:
-        if (!(data & 0x40)) {
-            _clem_mmio_clear_irq(mmio, CLEM_IRQ_TIMER_RTC_1SEC);
-        }
-        clem_vgc_write_switch(&mmio->vgc, &ref_clock, ioreg, data & ~0x40);
-        break;
-    case CLEM_MMIO_REG_RTC_CTL:
-        mmio->dev_rtc.ctl_c034 = data;
-        clem_rtc_command(&mmio->dev_rtc, tspec->clocks_spent, CLEM_IO_WRITE);
-        break;
-    case CLEM_MMIO_REG_RTC_DATA:
-        mmio->dev_rtc.data_c033 = data;
-        break;
-    case CLEM_MMIO_REG_SHADOW:
-        _clem_mmio_shadow_c035_set(mmio, data);
-        *mega2_access = false;
-        break;
-    case CLEM_MMIO_REG_SPEED:
-        _clem_mmio_speed_c036_set(mmio, tspec, data);
-        *mega2_access = false;
-        break;
-    case CLEM_MMIO_REG_SCC_B_CMD:
-    case CLEM_MMIO_REG_SCC_A_CMD:
-    case CLEM_MMIO_REG_SCC_B_DATA:
-    case CLEM_MMIO_REG_SCC_A_DATA:
-        clem_scc_write_switch(&mmio->dev_scc, tspec, ioreg, data);
-        break;
-    case CLEM_MMIO_REG_AUDIO_CTL:
-        clem_sound_write_switch(&mmio->dev_audio, ioreg, data);
-        break;
-    case CLEM_MMIO_REG_AUDIO_DATA:
-        clem_sound_write_switch(&mmio->dev_audio, ioreg, data);
-        break;
-    case CLEM_MMIO_REG_AUDIO_ADRLO:
-        clem_sound_write_switch(&mmio->dev_audio, ioreg, data);
-        break;
-    case CLEM_MMIO_REG_AUDIO_ADRHI:
-        clem_sound_write_switch(&mmio->dev_audio, ioreg, data);
-        break;
-    case CLEM_MMIO_REG_MEGA2_INTEN:
-        _clem_mmio_mega2_inten_set(mmio, data);
-        break;
-    case CLEM_MMIO_REG_DIAG_INTTYPE:
-        //  no-op, likely a 16-bit write that bleeds over to -1 or +1 register index
-        break;
-    case CLEM_MMIO_REG_CLRVBLINT:
-        _clem_mmio_clrvblint_c047(mmio);
-        break;
-    case CLEM_MMIO_REG_EMULATOR:
-        mmio->emulator_detect = CLEM_MMIO_EMULATOR_DETECT_START;
-        break;
-        ;
+    }
+}
+
+static uint8_t _clem_mmio_read_lc_switch(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                         struct ClemensClock *ref_clock, uint16_t addr,
+                                         uint8_t flags, bool *mega2_access) {
+    (void)ref_clock;
+    (void)mega2_access;
+    if (!(flags & CLEM_OP_IO_NO_OP)) {
+        _clem_mmio_rw_bank_select(mmio, addr);
+    }
+    return _clem_mmio_floating_bus(mmio, tspec);
+}
+
+static void _clem_mmio_write_lc_switch(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                       struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                       uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)data;
+    (void)flags;
+    (void)mega2_access;
+    _clem_mmio_rw_bank_select(mmio, addr);
+}
+
+static uint8_t _clem_mmio_read_slotromsel(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                          struct ClemensClock *ref_clock, uint16_t addr,
+                                          uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    *mega2_access = false;
+    return _clem_mmio_slotromsel_c02d(mmio);
+}
+
+static void _clem_mmio_write_slotromsel(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                        struct ClemensClock *ref_clock, uint8_t data,
+                                        uint16_t addr, uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    _clem_mmio_slotrom_select_c02d(mmio, data);
+}
+
+static uint8_t _clem_mmio_read_shadow(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                      struct ClemensClock *ref_clock, uint16_t addr, uint8_t flags,
+                                      bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    *mega2_access = false;
+    return _clem_mmio_shadow_c035(mmio);
+}
+
+static void _clem_mmio_write_shadow(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                    struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                    uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    _clem_mmio_shadow_c035_set(mmio, data);
+    *mega2_access = false;
+}
+
+static uint8_t _clem_mmio_read_statereg(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                        struct ClemensClock *ref_clock, uint16_t addr,
+                                        uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    *mega2_access = false;
+    return _clem_mmio_statereg_c068(mmio);
+}
+
+static void _clem_mmio_write_statereg(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                      struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                      uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    _clem_mmio_statereg_c068_set(mmio, data);
+    *mega2_access = false;
+}
+
+static uint8_t _clem_mmio_read_speed(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                     struct ClemensClock *ref_clock, uint16_t addr, uint8_t flags,
+                                     bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    *mega2_access = false;
+    return mmio->speed_c036;
+}
+
+static void _clem_mmio_write_speed(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                   struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                   uint8_t flags, bool *mega2_access) {
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    _clem_mmio_speed_c036_set(mmio, tspec, data);
+    *mega2_access = false;
+}
+
+//  Video (VGC)
+
+//  The Apple II video soft switches at $C050-$C057 act on either a read or a write
+static void _clem_mmio_video_switch(ClemensMMIO *mmio, uint8_t ioreg) {
+    switch (ioreg) {
     case CLEM_MMIO_REG_TXTCLR:
         clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_GRAPHICS_MODE);
         break;
@@ -1166,103 +950,725 @@ void clem_mmio_write(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec, uint8_t d
         /* implicitly clears lores */
         clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_HIRES);
         break;
-    case CLEM_MMIO_REG_AN0_OFF:
-    case CLEM_MMIO_REG_AN0_ON:
-    case CLEM_MMIO_REG_AN1_OFF:
-    case CLEM_MMIO_REG_AN1_ON:
-    case CLEM_MMIO_REG_AN2_OFF:
-    case CLEM_MMIO_REG_AN2_ON:
-    case CLEM_MMIO_REG_PADDL0:
-    case CLEM_MMIO_REG_PADDL1:
-    case CLEM_MMIO_REG_PADDL2:
-    case CLEM_MMIO_REG_PADDL3:
-    case CLEM_MMIO_REG_PTRIG:
-    case CLEM_MMIO_REG_PTRIG + 0x1:
-    case CLEM_MMIO_REG_PTRIG + 0x2:
-    case CLEM_MMIO_REG_PTRIG + 0x3:
-    case CLEM_MMIO_REG_C074_TRANSWARP:
-    case CLEM_MMIO_REG_PTRIG + 0x5:
-    case CLEM_MMIO_REG_PTRIG + 0x6:
-    case CLEM_MMIO_REG_PTRIG + 0x7:
-    case CLEM_MMIO_REG_PTRIG + 0x8:
-    case CLEM_MMIO_REG_PTRIG + 0x9:
-    case CLEM_MMIO_REG_PTRIG + 0xa:
-    case CLEM_MMIO_REG_PTRIG + 0xb:
-    case CLEM_MMIO_REG_PTRIG + 0xc:
-    case CLEM_MMIO_REG_PTRIG + 0xd:
-    case CLEM_MMIO_REG_PTRIG + 0xe:
-    case CLEM_MMIO_REG_PTRIG + 0xf:
-        clem_adb_write_switch(&mmio->dev_adb, ioreg, data);
+    }
+}
+
+static uint8_t _clem_mmio_read_video_switch(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                            struct ClemensClock *ref_clock, uint16_t addr,
+                                            uint8_t flags, bool *mega2_access) {
+    (void)ref_clock;
+    (void)mega2_access;
+    if (!(flags & CLEM_OP_IO_NO_OP)) {
+        _clem_mmio_video_switch(mmio, addr & 0xff);
+    }
+    return _clem_mmio_floating_bus(mmio, tspec);
+}
+
+static void _clem_mmio_write_video_switch(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                          struct ClemensClock *ref_clock, uint8_t data,
+                                          uint16_t addr, uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)data;
+    (void)flags;
+    (void)mega2_access;
+    _clem_mmio_video_switch(mmio, addr & 0xff);
+}
+
+static void _clem_mmio_write_video_mode(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                        struct ClemensClock *ref_clock, uint8_t data,
+                                        uint16_t addr, uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)data;
+    (void)flags;
+    (void)mega2_access;
+    switch (addr & 0xff) {
+    case CLEM_MMIO_REG_80COLUMN_OFF:
+        clem_vgc_clear_mode(&mmio->vgc, CLEM_VGC_80COLUMN_TEXT);
+        break;
+    case CLEM_MMIO_REG_80COLUMN_ON:
+        clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_80COLUMN_TEXT);
+        break;
+    case CLEM_MMIO_REG_ALTCHARSET_OFF:
+        clem_vgc_clear_mode(&mmio->vgc, CLEM_VGC_ALTCHARSET);
+        break;
+    case CLEM_MMIO_REG_ALTCHARSET_ON:
+        clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_ALTCHARSET);
         break;
-    case CLEM_MMIO_REG_AN3_OFF:
-    case CLEM_MMIO_REG_AN3_ON:
+    }
+}
+
+static uint8_t _clem_mmio_read_video_mode_test(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                               struct ClemensClock *ref_clock, uint16_t addr,
+                                               uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)flags;
+    (void)mega2_access;
+    switch (addr & 0xff) {
+    case CLEM_MMIO_REG_TXT_TEST:
+        return (mmio->vgc.mode_flags & CLEM_VGC_GRAPHICS_MODE) ? 0x00 : 0x80;
+    case CLEM_MMIO_REG_MIXED_TEST:
+        return (mmio->vgc.mode_flags & CLEM_VGC_MIXED_TEXT) ? 0x80 : 0x00;
+    case CLEM_MMIO_REG_ALTCHARSET_TEST:
+        return (mmio->vgc.mode_flags & CLEM_VGC_ALTCHARSET) ? 0x80 : 0x00;
+    case CLEM_MMIO_REG_HIRES_TEST:
+        return (mmio->vgc.mode_flags & CLEM_VGC_HIRES) ? 0x80 : 0x00;
+    case CLEM_MMIO_REG_80COLUMN_TEST:
+        return (mmio->vgc.mode_flags & CLEM_VGC_80COLUMN_TEXT) ? 0x80 : 0x00;
+    }
+    return 0x00;
+}
+
+static uint8_t _clem_mmio_read_vgc(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                   struct ClemensClock *ref_clock, uint16_t addr, uint8_t flags,
+                                   bool *mega2_access) {
+    (void)tspec;
+    (void)mega2_access;
+    return clem_vgc_read_switch(&mmio->vgc, ref_clock, addr & 0xff, flags);
+}
+
+static void _clem_mmio_write_vgc_scanint(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                         struct ClemensClock *ref_clock, uint8_t data,
+                                         uint16_t addr, uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)flags;
+    (void)mega2_access;
+    if (!(data & 0x40)) {
+        _clem_mmio_clear_irq(mmio, CLEM_IRQ_TIMER_RTC_1SEC);
+    }
+    clem_vgc_write_switch(&mmio->vgc, ref_clock, addr & 0xff, data & ~0x40);
+}
+
+static void _clem_mmio_write_vgc_mono(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                      struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                      uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    if (data & 0x80) {
+        clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_MONOCHROME);
+    } else {
+        clem_vgc_clear_mode(&mmio->vgc, CLEM_VGC_MONOCHROME);
+    }
+}
+
+static uint8_t _clem_mmio_read_text_color(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                          struct ClemensClock *ref_clock, uint16_t addr,
+                                          uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    return (uint8_t)((mmio->vgc.text_fg_color << 4) | mmio->vgc.text_bg_color);
+}
+
+static void _clem_mmio_write_text_color(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                        struct ClemensClock *ref_clock, uint8_t data,
+                                        uint16_t addr, uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    clem_vgc_set_text_colors(&mmio->vgc, (data & 0xf0) >> 4, data & 0x0f);
+}
+
+static uint8_t _clem_mmio_read_vgc_irq(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                       struct ClemensClock *ref_clock, uint16_t addr,
+                                       uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    return _clem_mmio_vgc_irq_c023_get(mmio);
+}
+
+static void _clem_mmio_write_vgc_irq(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                     struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                     uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    _clem_mmio_vgc_irq_c023_set(mmio, data);
+}
+
+static uint8_t _clem_mmio_read_newvideo(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                        struct ClemensClock *ref_clock, uint16_t addr,
+                                        uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    return _clem_mmio_newvideo_c029(mmio);
+}
+
+static void _clem_mmio_write_newvideo(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                      struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                      uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    _clem_mmio_newvideo_c029_set(mmio, data);
+}
+
+static uint8_t _clem_mmio_read_langsel(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                       struct ClemensClock *ref_clock, uint16_t addr,
+                                       uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    return clem_vgc_get_region(&mmio->vgc);
+}
+
+static void _clem_mmio_write_langsel(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                     struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                     uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    clem_vgc_set_region(&mmio->vgc, data);
+}
+
+//  Interrupts and the emulator detection register
+
+static uint8_t _clem_mmio_read_mega2_inten(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                           struct ClemensClock *ref_clock, uint16_t addr,
+                                           uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    return _clem_mmio_mega2_inten_get(mmio);
+}
+
+static void _clem_mmio_write_mega2_inten(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                         struct ClemensClock *ref_clock, uint8_t data,
+                                         uint16_t addr, uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    _clem_mmio_mega2_inten_set(mmio, data);
+}
+
+static uint8_t _clem_mmio_read_inttype(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                       struct ClemensClock *ref_clock, uint16_t addr,
+                                       uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    return _clem_mmio_inttype_c046(mmio);
+}
+
+static uint8_t _clem_mmio_read_clrvblint(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                         struct ClemensClock *ref_clock, uint16_t addr,
+                                         uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)mega2_access;
+    if (!(flags & CLEM_OP_IO_NO_OP)) {
+        _clem_mmio_clrvblint_c047(mmio);
+    }
+    return 0x00;
+}
+
+static void _clem_mmio_write_clrvblint(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                       struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                       uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)data;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    _clem_mmio_clrvblint_c047(mmio);
+}
+
+static uint8_t _clem_mmio_read_emulator(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                        struct ClemensClock *ref_clock, uint16_t addr,
+                                        uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    uint8_t result = 0x00;
+    if (mmio->emulator_detect == CLEM_MMIO_EMULATOR_DETECT_START) {
+        result = CLEM_EMULATOR_ID;
+        mmio->emulator_detect = CLEM_MMIO_EMULATOR_DETECT_VERSION;
+    } else if (mmio->emulator_detect == CLEM_MMIO_EMULATOR_DETECT_VERSION) {
+        result = CLEM_EMULATOR_VER;
+        mmio->emulator_detect = CLEM_MMIO_EMULATOR_DETECT_IDLE;
+    }
+    return result;
+}
+
+static void _clem_mmio_write_emulator(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                      struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                      uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)data;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    mmio->emulator_detect = CLEM_MMIO_EMULATOR_DETECT_START;
+}
+
+//  Keyboard, mouse and game controller (ADB)
+
+static uint8_t _clem_mmio_read_adb_mega2(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                         struct ClemensClock *ref_clock, uint16_t addr,
+                                         uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)mega2_access;
+    return clem_adb_read_mega2_switch(&mmio->dev_adb, addr & 0xff, flags);
+}
+
+static uint8_t _clem_mmio_read_adb(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                   struct ClemensClock *ref_clock, uint16_t addr, uint8_t flags,
+                                   bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)mega2_access;
+    return clem_adb_read_switch(&mmio->dev_adb, addr & 0xff, flags);
+}
+
+static void _clem_mmio_write_adb(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                 struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                 uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)flags;
+    (void)mega2_access;
+    clem_adb_write_switch(&mmio->dev_adb, addr & 0xff, data);
+}
+
+//  Paddle timers are only synced on demand, so catch up before they're read or reset
+static uint8_t _clem_mmio_read_paddle(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                      struct ClemensClock *ref_clock, uint16_t addr,
+                                      uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)mega2_access;
+    clem_gameport_sync(&mmio->dev_adb.gameport, ref_clock);
+    return clem_adb_read_switch(&mmio->dev_adb, addr & 0xff, flags);
+}
+
+static void _clem_mmio_write_paddle(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                    struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                    uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)flags;
+    (void)mega2_access;
+    clem_gameport_sync(&mmio->dev_adb.gameport, ref_clock);
+    clem_adb_write_switch(&mmio->dev_adb, addr & 0xff, data);
+}
+
+//  AN3 is also used for double hires graphics
+static uint8_t _clem_mmio_read_an3(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                   struct ClemensClock *ref_clock, uint16_t addr, uint8_t flags,
+                                   bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)mega2_access;
+    uint8_t ioreg = addr & 0xff;
+    if (!(flags & CLEM_OP_IO_NO_OP)) {
         if (ioreg == CLEM_MMIO_REG_AN3_ON) {
             clem_vgc_clear_mode(&mmio->vgc, CLEM_VGC_DISABLE_AN3);
         } else {
             clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_DISABLE_AN3);
         }
-        clem_adb_write_switch(&mmio->dev_adb, ioreg, data);
-        break;
-    case CLEM_MMIO_REG_LC2_RAM_WP:
-    case CLEM_MMIO_REG_LC2_RAM_WP2:
-    case CLEM_MMIO_REG_LC2_ROM_WE:
-    case CLEM_MMIO_REG_LC2_ROM_WE2:
-    case CLEM_MMIO_REG_LC2_ROM_WP:
-    case CLEM_MMIO_REG_LC2_ROM_WP2:
-    case CLEM_MMIO_REG_LC2_RAM_WE:
-    case CLEM_MMIO_REG_LC2_RAM_WE2:
-    case CLEM_MMIO_REG_LC1_RAM_WP:
-    case CLEM_MMIO_REG_LC1_RAM_WP2:
-    case CLEM_MMIO_REG_LC1_ROM_WE:
-    case CLEM_MMIO_REG_LC1_ROM_WE2:
-    case CLEM_MMIO_REG_LC1_ROM_WP:
-    case CLEM_MMIO_REG_LC1_ROM_WP2:
-    case CLEM_MMIO_REG_LC1_RAM_WE:
-    case CLEM_MMIO_REG_LC1_RAM_WE2:
-        _clem_mmio_rw_bank_select(mmio, addr);
-        break;
-    case CLEM_MMIO_REG_STATEREG:
-        _clem_mmio_statereg_c068_set(mmio, data);
-        *mega2_access = false;
-        break;
-    case CLEM_MMIO_REG_STATEREG + 1:
-        *mega2_access = false;
-        break;
-    case CLEM_MMIO_REG_IWM_PHASE0_LO:
-    case CLEM_MMIO_REG_IWM_PHASE0_HI:
-    case CLEM_MMIO_REG_IWM_PHASE1_LO:
-    case CLEM_MMIO_REG_IWM_PHASE1_HI:
-    case CLEM_MMIO_REG_IWM_PHASE2_LO:
-    case CLEM_MMIO_REG_IWM_PHASE2_HI:
-    case CLEM_MMIO_REG_IWM_PHASE3_LO:
-    case CLEM_MMIO_REG_IWM_PHASE3_HI:
-    case CLEM_MMIO_REG_IWM_DRIVE_DISABLE:
-    case CLEM_MMIO_REG_IWM_DRIVE_ENABLE:
-    case CLEM_MMIO_REG_IWM_DRIVE_0:
-    case CLEM_MMIO_REG_IWM_DRIVE_1:
-    case CLEM_MMIO_REG_IWM_Q6_LO:
-    case CLEM_MMIO_REG_IWM_Q6_HI:
-    case CLEM_MMIO_REG_IWM_Q7_LO:
-    case CLEM_MMIO_REG_IWM_Q7_HI:
-        clem_iwm_write_switch(&mmio->dev_iwm, &mmio->active_drives, tspec, ioreg, data);
-        break;
-    default:
-        if (ioreg >= 0x80) {
-            _clem_mmio_card_io_write(mmio->card_slot[(ioreg - 0x90) >> 4], &ref_clock, data,
-                                     ioreg & 0xf, flags);
-        } else if (!is_noop) {
-            clem_debug_break(mmio->dev_debug, CLEM_DEBUG_BREAK_UNIMPL_IOWRITE, addr, data);
+    }
+    return clem_adb_read_switch(&mmio->dev_adb, ioreg, flags);
+}
+
+static void _clem_mmio_write_an3(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                 struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                 uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)flags;
+    (void)mega2_access;
+    uint8_t ioreg = addr & 0xff;
+    if (ioreg == CLEM_MMIO_REG_AN3_ON) {
+        clem_vgc_clear_mode(&mmio->vgc, CLEM_VGC_DISABLE_AN3);
+    } else {
+        clem_vgc_set_mode(&mmio->vgc, CLEM_VGC_DISABLE_AN3);
+    }
+    clem_adb_write_switch(&mmio->dev_adb, ioreg, data);
+}
+
+//  Real time clock
+
+static uint8_t _clem_mmio_read_rtc_data(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                        struct ClemensClock *ref_clock, uint16_t addr,
+                                        uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    return mmio->dev_rtc.data_c033;
+}
+
+static void _clem_mmio_write_rtc_data(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                      struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                      uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    mmio->dev_rtc.data_c033 = data;
+}
+
+static uint8_t _clem_mmio_read_rtc_ctl(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                       struct ClemensClock *ref_clock, uint16_t addr,
+                                       uint8_t flags, bool *mega2_access) {
+    (void)ref_clock;
+    (void)addr;
+    (void)mega2_access;
+    if (!(flags & CLEM_OP_IO_NO_OP)) {
+        clem_rtc_command(&mmio->dev_rtc, tspec->clocks_spent, CLEM_IO_READ);
+    }
+    return mmio->dev_rtc.ctl_c034;
+}
+
+static void _clem_mmio_write_rtc_ctl(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                     struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                     uint8_t flags, bool *mega2_access) {
+    (void)ref_clock;
+    (void)addr;
+    (void)flags;
+    (void)mega2_access;
+    mmio->dev_rtc.ctl_c034 = data;
+    clem_rtc_command(&mmio->dev_rtc, tspec->clocks_spent, CLEM_IO_WRITE);
+}
+
+//  Speaker and Ensoniq sound
+
+static uint8_t _clem_mmio_read_speaker(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                       struct ClemensClock *ref_clock, uint16_t addr,
+                                       uint8_t flags, bool *mega2_access) {
+    (void)ref_clock;
+    (void)mega2_access;
+    clem_sound_read_switch(&mmio->dev_audio, addr & 0xff, flags);
+    return _clem_mmio_floating_bus(mmio, tspec);
+}
+
+static uint8_t _clem_mmio_read_sound(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                     struct ClemensClock *ref_clock, uint16_t addr, uint8_t flags,
+                                     bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)mega2_access;
+    return clem_sound_read_switch(&mmio->dev_audio, addr & 0xff, flags);
+}
+
+static void _clem_mmio_write_sound(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                   struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                   uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)ref_clock;
+    (void)flags;
+    (void)mega2_access;
+    clem_sound_write_switch(&mmio->dev_audio, addr & 0xff, data);
+}
+
+//  Serial (SCC)
+
+static uint8_t _clem_mmio_read_scc(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                   struct ClemensClock *ref_clock, uint16_t addr, uint8_t flags,
+                                   bool *mega2_access) {
+    (void)tspec;
+    (void)mega2_access;
+    //  idle channels are brought up to date only when their registers are accessed
+    clem_scc_glu_sync(&mmio->dev_scc, ref_clock);
+    return clem_scc_read_switch(&mmio->dev_scc, addr & 0xff, flags);
+}
+
+static void _clem_mmio_write_scc(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                 struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                 uint8_t flags, bool *mega2_access) {
+    (void)flags;
+    (void)mega2_access;
+    clem_scc_glu_sync(&mmio->dev_scc, ref_clock);
+    clem_scc_write_switch(&mmio->dev_scc, tspec, addr & 0xff, data);
+}
+
+//  Disk (IWM)
+
+static uint8_t _clem_mmio_read_iwm(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                   struct ClemensClock *ref_clock, uint16_t addr, uint8_t flags,
+                                   bool *mega2_access) {
+    (void)ref_clock;
+    (void)mega2_access;
+    return clem_iwm_read_switch(&mmio->dev_iwm, &mmio->active_drives, tspec, addr & 0xff, flags);
+}
+
+static void _clem_mmio_write_iwm(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                 struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                 uint8_t flags, bool *mega2_access) {
+    (void)ref_clock;
+    (void)flags;
+    (void)mega2_access;
+    clem_iwm_write_switch(&mmio->dev_iwm, &mmio->active_drives, tspec, addr & 0xff, data);
+}
+
+//  Peripheral cards - $C090-$C0FF excluding the IWM
+
+static uint8_t _clem_mmio_read_card(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                    struct ClemensClock *ref_clock, uint16_t addr, uint8_t flags,
+                                    bool *mega2_access) {
+    (void)tspec;
+    (void)mega2_access;
+    uint8_t ioreg = addr & 0xff;
+    return _clem_mmio_card_io_read(mmio->card_slot[(ioreg - 0x90) >> 4], ref_clock, ioreg & 0xf,
+                                   flags);
+}
+
+static void _clem_mmio_write_card(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                  struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                  uint8_t flags, bool *mega2_access) {
+    (void)tspec;
+    (void)mega2_access;
+    uint8_t ioreg = addr & 0xff;
+    _clem_mmio_card_io_write(mmio->card_slot[(ioreg - 0x90) >> 4], ref_clock, data, ioreg & 0xf,
+                             flags);
+}
+
+static void _clem_mmio_register_io(ClemensMMIO *mmio, uint8_t ioreg_first, uint8_t ioreg_last,
+                                   ClemensMMIOReadFn read_fn, ClemensMMIOWriteFn write_fn) {
+    unsigned ioreg;
+    for (ioreg = ioreg_first; ioreg <= ioreg_last; ++ioreg) {
+        if (read_fn) {
+            mmio->io_read[ioreg] = read_fn;
         }
-        break;
+        if (write_fn) {
+            mmio->io_write[ioreg] = write_fn;
+        }
+    }
+}
+
+static void _clem_mmio_init_io_handlers(ClemensMMIO *mmio) {
+    memset(mmio->io_read_count, 0, sizeof(mmio->io_read_count));
+    memset(mmio->io_write_count, 0, sizeof(mmio->io_write_count));
+    _clem_mmio_register_io(mmio, 0x00, 0xff, &_clem_mmio_read_unimpl, &_clem_mmio_write_unimpl);
+
+    //  memory mapping
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_80STOREOFF_WRITE, CLEM_MMIO_REG_SLOTC3ROM, NULL,
+                           &_clem_mmio_write_mmap_switch);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_LC_BANK_TEST, CLEM_MMIO_REG_80COLSTORE_TEST,
+                           &_clem_mmio_read_mmap_test, NULL);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_READCXROM, CLEM_MMIO_REG_READCXROM,
+                           &_clem_mmio_read_cxrom_test, NULL);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_TXTPAGE2_TEST, CLEM_MMIO_REG_TXTPAGE2_TEST,
+                           &_clem_mmio_read_mmap_test, NULL);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_SLOTROMSEL, CLEM_MMIO_REG_SLOTROMSEL,
+                           &_clem_mmio_read_slotromsel, &_clem_mmio_write_slotromsel);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_SHADOW, CLEM_MMIO_REG_SHADOW,
+                           &_clem_mmio_read_shadow, &_clem_mmio_write_shadow);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_SPEED, CLEM_MMIO_REG_SPEED, &_clem_mmio_read_speed,
+                           &_clem_mmio_write_speed);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_STATEREG, CLEM_MMIO_REG_STATEREG,
+                           &_clem_mmio_read_statereg, &_clem_mmio_write_statereg);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_STATEREG + 1, CLEM_MMIO_REG_STATEREG + 1,
+                           &_clem_mmio_read_none_fast, &_clem_mmio_write_none_fast);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_LC2_RAM_WP, CLEM_MMIO_REG_LC1_RAM_WE2,
+                           &_clem_mmio_read_lc_switch, &_clem_mmio_write_lc_switch);
+
+    //  video
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_80COLUMN_OFF, CLEM_MMIO_REG_ALTCHARSET_ON, NULL,
+                           &_clem_mmio_write_video_mode);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_VBLBAR, CLEM_MMIO_REG_VBLBAR, &_clem_mmio_read_vgc,
+                           NULL);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_TXT_TEST, CLEM_MMIO_REG_MIXED_TEST,
+                           &_clem_mmio_read_video_mode_test, NULL);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_HIRES_TEST, CLEM_MMIO_REG_80COLUMN_TEST,
+                           &_clem_mmio_read_video_mode_test, NULL);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_CASSETTE_PORT_NOP, CLEM_MMIO_REG_CASSETTE_PORT_NOP,
+                           &_clem_mmio_read_floating_bus, NULL);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_VGC_MONO, CLEM_MMIO_REG_VGC_MONO, NULL,
+                           &_clem_mmio_write_vgc_mono);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_VGC_TEXT_COLOR, CLEM_MMIO_REG_VGC_TEXT_COLOR,
+                           &_clem_mmio_read_text_color, &_clem_mmio_write_text_color);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_VGC_IRQ_BYTE, CLEM_MMIO_REG_VGC_IRQ_BYTE,
+                           &_clem_mmio_read_vgc_irq, &_clem_mmio_write_vgc_irq);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_NEWVIDEO, CLEM_MMIO_REG_NEWVIDEO,
+                           &_clem_mmio_read_newvideo, &_clem_mmio_write_newvideo);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_NEWVIDEO + 1, CLEM_MMIO_REG_NEWVIDEO + 1,
+                           &_clem_mmio_read_none, &_clem_mmio_write_none);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_LANGSEL, CLEM_MMIO_REG_LANGSEL,
+                           &_clem_mmio_read_langsel, &_clem_mmio_write_langsel);
+    //  TODO: unsure what to do unless we store the character ROM in memory vs font files
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_CHARROM_TEST, CLEM_MMIO_REG_CHARROM_TEST,
+                           &_clem_mmio_read_none, &_clem_mmio_write_none);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_VGC_VERTCNT, CLEM_MMIO_REG_VGC_HORIZCNT,
+                           &_clem_mmio_read_vgc, NULL);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_RTC_VGC_SCANINT, CLEM_MMIO_REG_RTC_VGC_SCANINT,
+                           &_clem_mmio_read_vgc, &_clem_mmio_write_vgc_scanint);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_TXTCLR, CLEM_MMIO_REG_HIRES,
+                           &_clem_mmio_read_video_switch, &_clem_mmio_write_video_switch);
+
+    //  interrupts and emulator detection
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_MEGA2_INTEN, CLEM_MMIO_REG_MEGA2_INTEN,
+                           &_clem_mmio_read_mega2_inten, &_clem_mmio_write_mega2_inten);
+    //  writes are likely a 16-bit write that bleeds over from a neighboring register
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_DIAG_INTTYPE, CLEM_MMIO_REG_DIAG_INTTYPE,
+                           &_clem_mmio_read_inttype, &_clem_mmio_write_none);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_CLRVBLINT, CLEM_MMIO_REG_CLRVBLINT,
+                           &_clem_mmio_read_clrvblint, &_clem_mmio_write_clrvblint);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_EMULATOR, CLEM_MMIO_REG_EMULATOR,
+                           &_clem_mmio_read_emulator, &_clem_mmio_write_emulator);
+
+    //  ADB (keyboard, mouse) and game controllers
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_KEYB_READ, CLEM_MMIO_REG_ANYKEY_STROBE,
+                           &_clem_mmio_read_adb_mega2, NULL);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_ANYKEY_STROBE, CLEM_MMIO_REG_ANYKEY_STROBE + 15,
+                           NULL, &_clem_mmio_write_adb);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_ADB_MOUSE_DATA, CLEM_MMIO_REG_ADB_STATUS,
+                           &_clem_mmio_read_adb, &_clem_mmio_write_adb);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_MEGA2_MOUSE_DX, CLEM_MMIO_REG_MEGA2_MOUSE_DY,
+                           &_clem_mmio_read_adb_mega2, NULL);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_AN0_OFF, CLEM_MMIO_REG_AN2_ON,
+                           &_clem_mmio_read_adb, &_clem_mmio_write_adb);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_AN3_OFF, CLEM_MMIO_REG_AN3_ON,
+                           &_clem_mmio_read_an3, &_clem_mmio_write_an3);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_SW3, CLEM_MMIO_REG_SW2, &_clem_mmio_read_adb, NULL);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_PADDL0, CLEM_MMIO_REG_PADDL3,
+                           &_clem_mmio_read_paddle, &_clem_mmio_write_paddle);
+    //  note c071 - 7f are reserved for ROM access - used for the BRK interrupt
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_PTRIG, CLEM_MMIO_REG_PTRIG, &_clem_mmio_read_paddle,
+                           NULL);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_PTRIG, CLEM_MMIO_REG_PTRIG + 0xf, NULL,
+                           &_clem_mmio_write_paddle);
+
+    //  RTC, sound, serial and disk
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_RTC_DATA, CLEM_MMIO_REG_RTC_DATA,
+                           &_clem_mmio_read_rtc_data, &_clem_mmio_write_rtc_data);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_RTC_CTL, CLEM_MMIO_REG_RTC_CTL,
+                           &_clem_mmio_read_rtc_ctl, &_clem_mmio_write_rtc_ctl);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_SPKR, CLEM_MMIO_REG_SPKR, &_clem_mmio_read_speaker,
+                           &_clem_mmio_write_sound);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_AUDIO_CTL, CLEM_MMIO_REG_AUDIO_ADRHI,
+                           &_clem_mmio_read_sound, &_clem_mmio_write_sound);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_SCC_B_CMD, CLEM_MMIO_REG_SCC_A_DATA,
+                           &_clem_mmio_read_scc, &_clem_mmio_write_scc);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_DISK_INTERFACE, CLEM_MMIO_REG_DISK_INTERFACE,
+                           &_clem_mmio_read_iwm, &_clem_mmio_write_iwm);
+
+    //  peripheral cards, with the IWM occupying slot 6's registers
+    _clem_mmio_register_io(mmio, 0x90, 0xff, &_clem_mmio_read_card, &_clem_mmio_write_card);
+    _clem_mmio_register_io(mmio, CLEM_MMIO_REG_IWM_PHASE0_LO, CLEM_MMIO_REG_IWM_Q7_HI,
+                           &_clem_mmio_read_iwm, &_clem_mmio_write_iwm);
+}
+
+uint8_t clem_mmio_read(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec, uint16_t addr,
+                       uint8_t flags, bool *mega2_access) {
+    struct ClemensClock ref_clock;
+    uint8_t result = 0x00;
+    uint8_t ioreg = addr & 0xff;
+    bool is_noop = (flags & CLEM_OP_IO_NO_OP) != 0;
+
+    //  SHADOW, CYA, DMA are fast
+    //  SLOT, STATE are fast (read-only)
+    *mega2_access = true;
+
+    ref_clock.ts = tspec->clocks_spent;
+    ref_clock.ref_step = *mega2_access ? CLEM_CLOCKS_PHI0_CYCLE : tspec->clocks_step;
+
+    //  device state may change from this access - sync devices after this instruction
+    if (!is_noop) {
+        mmio->next_event_ts = 0;
+    }
+
+    if (flags & CLEM_OP_IO_CARD) {
+        uint8_t slot_idx;
+
+        if (addr == 0xCFFF) {
+            /* TODO: CFFF access */
+        } else if (addr < 0xCFFF && addr >= 0xC800) {
+            slot_idx = (uint8_t)(mmio->card_expansion_rom_index & 0xff);
+            if (slot_idx > 0 && slot_idx <= 7) {
+                result = mmio->card_slot_expansion_memory[slot_idx - 1][addr - 0xc800];
+            }
+        } else if (addr >= 0xC100) {
+            slot_idx = (uint8_t)(addr >> 8) - 0xc0 - 1;
+            if (mmio->card_slot[slot_idx]) {
+                result = _clem_mmio_card_io_read(mmio->card_slot[slot_idx], &ref_clock, ioreg,
+                                                 flags | CLEM_OP_IO_DEVSEL);
+            }
+        }
+
+        return result;
+    }
+
+    if (!is_noop) {
+        ++mmio->io_read_count[ioreg];
+    }
+    return (*mmio->io_read[ioreg])(mmio, tspec, &ref_clock, addr, flags, mega2_access);
+}
+
+void clem_mmio_write(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec, uint8_t data, uint16_t addr,
+                     uint8_t flags, bool *mega2_access) {
+    struct ClemensClock ref_clock;
+    bool is_noop = (flags & CLEM_OP_IO_NO_OP) != 0;
+    uint8_t ioreg = (addr & 0xff);
+
+    //  SHADOW, SPEED and DMA are fast
+    *mega2_access = true;
+
+    ref_clock.ts = tspec->clocks_spent;
+    ref_clock.ref_step = *mega2_access ? CLEM_CLOCKS_PHI0_CYCLE : tspec->clocks_step;
+
+    //  device state may change from this access - sync devices after this instruction
+    if (!is_noop) {
+        mmio->next_event_ts = 0;
+    }
+
+    if ((flags & CLEM_OP_IO_CARD) && addr >= 0xC100) {
+        uint8_t slot_idx = (uint8_t)(addr >> 8) - 0xc0 - 1;
+        if (mmio->card_slot[slot_idx]) {
+            _clem_mmio_card_io_write(mmio->card_slot[slot_idx], &ref_clock, data, ioreg,
+                                     flags | CLEM_OP_IO_DEVSEL);
+        }
+        return;
+    }
+
+    if (!is_noop) {
+        ++mmio->io_write_count[ioreg];
     }
+    (*mmio->io_write[ioreg])(mmio, tspec, &ref_clock, data, addr, flags, mega2_access);
 }
 
-static void _clem_mmio_shadow_map(ClemensMMIO *mmio, uint32_t shadow_flags) {
+static void _clem_mmio_shadow_map(struct ClemensMMIOPageMapSet *page_map_set,
+                                  uint32_t shadow_flags) {
     /* Sets up which pages are shadowed on banks 00, 01.  Flags tested inside
        _clem_write determine if the write operation actual performs the copy to
        E0, E1
     */
-    unsigned remap_flags = mmio->mmap_register ^ shadow_flags;
+    unsigned remap_flags = page_map_set->mmap_register ^ shadow_flags;
     unsigned page_idx;
     bool inhibit_hgr_bank_01 = (shadow_flags & CLEM_MEM_IO_MMAP_NSHADOW_AUX) != 0;
     bool inhibit_shgr_bank_01 = (shadow_flags & CLEM_MEM_IO_MMAP_NSHADOW_SHGR) != 0;
@@ -1271,16 +1677,16 @@ static void _clem_mmio_shadow_map(ClemensMMIO *mmio, uint32_t shadow_flags) {
     if (remap_flags & CLEM_MEM_IO_MMAP_NSHADOW_TXT1) {
         for (page_idx = 0x04; page_idx < 0x08; ++page_idx) {
             uint8_t v = (shadow_flags & CLEM_MEM_IO_MMAP_NSHADOW_TXT1) ? 0 : 1;
-            mmio->fpi_mega2_main_shadow_map.pages[page_idx] = v;
-            mmio->fpi_mega2_aux_shadow_map.pages[page_idx] = v;
+            page_map_set->fpi_mega2_main_shadow_map.pages[page_idx] = v;
+            page_map_set->fpi_mega2_aux_shadow_map.pages[page_idx] = v;
         }
     }
     //  TXT 2
     if (remap_flags & CLEM_MEM_IO_MMAP_NSHADOW_TXT2) {
         for (page_idx = 0x08; page_idx < 0x0C; ++page_idx) {
             uint8_t v = (shadow_flags & CLEM_MEM_IO_MMAP_NSHADOW_TXT2) ? 0 : 1;
-            mmio->fpi_mega2_main_shadow_map.pages[page_idx] = v;
-            mmio->fpi_mega2_aux_shadow_map.pages[page_idx] = v;
+            page_map_set->fpi_mega2_main_shadow_map.pages[page_idx] = v;
+            page_map_set->fpi_mega2_aux_shadow_map.pages[page_idx] = v;
         }
     }
     //  HGR1/AUX HGR1
@@ -1290,8 +1696,8 @@ static void _clem_mmio_shadow_map(ClemensMMIO *mmio, uint32_t shadow_flags) {
         for (page_idx = 0x20; page_idx < 0x40; ++page_idx) {
             uint8_t v0 = (shadow_flags & CLEM_MEM_IO_MMAP_NSHADOW_HGR1) ? 0 : 1;
             uint8_t v1 = (v0 && !inhibit_hgr_bank_01) || !inhibit_shgr_bank_01 ? 1 : 0;
-            mmio->fpi_mega2_main_shadow_map.pages[page_idx] = v0;
-            mmio->fpi_mega2_aux_shadow_map.pages[page_idx] = v1;
+            page_map_set->fpi_mega2_main_shadow_map.pages[page_idx] = v0;
+            page_map_set->fpi_mega2_aux_shadow_map.pages[page_idx] = v1;
         }
     }
     if ((remap_flags & CLEM_MEM_IO_MMAP_NSHADOW_HGR2) ||
@@ -1300,16 +1706,21 @@ static void _clem_mmio_shadow_map(ClemensMMIO *mmio, uint32_t shadow_flags) {
         for (page_idx = 0x40; page_idx < 0x60; ++page_idx) {
             uint8_t v0 = (shadow_flags & CLEM_MEM_IO_MMAP_NSHADOW_HGR2) ? 0 : 1;
             uint8_t v1 = (v0 && !inhibit_hgr_bank_01) || !inhibit_shgr_bank_01 ? 1 : 0;
-            mmio->fpi_mega2_main_shadow_map.pages[page_idx] = v0;
-            mmio->fpi_mega2_aux_shadow_map.pages[page_idx] = v1;
+            page_map_set->fpi_mega2_main_shadow_map.pages[page_idx] = v0;
+            page_map_set->fpi_mega2_aux_shadow_map.pages[page_idx] = v1;
         }
     }
     if (remap_flags & CLEM_MEM_IO_MMAP_NSHADOW_SHGR) {
         for (page_idx = 0x60; page_idx < 0xA0; ++page_idx) {
             uint8_t v1 = inhibit_shgr_bank_01 ? 0 : 1;
-            mmio->fpi_mega2_aux_shadow_map.pages[page_idx] = v1;
+            page_map_set->fpi_mega2_aux_shadow_map.pages[page_idx] = v1;
         }
     }
+    //  shadowed pages always take the slow write path
+    if (remap_flags & CLEM_MEM_IO_MMAP_NSHADOW) {
+        clem_mem_page_map_clear_host(&page_map_set->fpi_main_page_map);
+        clem_mem_page_map_clear_host(&page_map_set->fpi_aux_page_map);
+    }
 }
 
 /*  Banks 02-7F and FC-FF almost always keep the same memory mapping.
@@ -1324,7 +1735,9 @@ static void _clem_mmio_shadow_map(ClemensMMIO *mmio, uint32_t shadow_flags) {
     switches (iolc inhibit)
 
 */
-static void _clem_mmio_memory_map(ClemensMMIO *mmio, uint32_t memory_flags) {
+static void _clem_mmio_page_map_set_remap(ClemensMMIO *mmio,
+                                          struct ClemensMMIOPageMapSet *page_map_set,
+                                          uint32_t memory_flags) {
     struct ClemensMemoryPageMap *page_map_B00;
     struct ClemensMemoryPageMap *page_map_B01;
     struct ClemensMemoryPageMap *page_map_BE0;
@@ -1333,13 +1746,13 @@ static void _clem_mmio_memory_map(ClemensMMIO *mmio, uint32_t memory_flags) {
     struct ClemensMemoryPageInfo *page_B01;
     struct ClemensMemoryPageInfo *page_BE0;
     struct ClemensMemoryPageInfo *page_BE1;
-    unsigned remap_flags = mmio->mmap_register ^ memory_flags;
+    unsigned remap_flags = page_map_set->mmap_register ^ memory_flags;
     unsigned page_idx;
 
-    page_map_B00 = &mmio->fpi_main_page_map;
-    page_map_B01 = &mmio->fpi_aux_page_map;
-    page_map_BE0 = &mmio->mega2_main_page_map;
-    page_map_BE1 = &mmio->mega2_aux_page_map;
+    page_map_B00 = &page_map_set->fpi_main_page_map;
+    page_map_B01 = &page_map_set->fpi_aux_page_map;
+    page_map_BE0 = &page_map_set->mega2_main_page_map;
+    page_map_BE1 = &page_map_set->mega2_aux_page_map;
 
     //  ALTZPLC is a main bank-only softswitch.  As a result 01, E0, E1 bank
     //      maps for page 0, 1 remain unchanged
@@ -1429,7 +1842,7 @@ static void _clem_mmio_memory_map(ClemensMMIO *mmio, uint32_t memory_flags) {
 
     //  Shadowing
     if (remap_flags & CLEM_MEM_IO_MMAP_NSHADOW) {
-        _clem_mmio_shadow_map(mmio, memory_flags & CLEM_MEM_IO_MMAP_NSHADOW);
+        _clem_mmio_shadow_map(page_map_set, memory_flags & CLEM_MEM_IO_MMAP_NSHADOW);
     }
 
     //  I/O space mapping
@@ -1669,18 +2082,89 @@ static void _clem_mmio_memory_map(ClemensMMIO *mmio, uint32_t memory_flags) {
         }
     }
 
-    mmio->mmap_register = memory_flags;
+    //  bank 00 writes may resolve through bank 01's map, so both are cleared
+    if (remap_flags) {
+        clem_mem_page_map_clear_host(page_map_B00);
+        clem_mem_page_map_clear_host(page_map_B01);
+        clem_mem_page_map_clear_host(page_map_BE0);
+        clem_mem_page_map_clear_host(page_map_BE1);
+    }
+
+    page_map_set->mmap_register = memory_flags;
+}
+
+static void _clem_mmio_page_map_set_select(ClemensMMIO *mmio,
+                                           struct ClemensMMIOPageMapSet *page_map_set) {
+    //  the MMIO may be reset without a machine's bank map (i.e. in unit tests)
+    if (mmio->bank_page_map) {
+        mmio->bank_page_map[0x00] = &page_map_set->fpi_main_page_map;
+        mmio->bank_page_map[0x01] = &page_map_set->fpi_aux_page_map;
+        mmio->bank_page_map[0xE0] = &page_map_set->mega2_main_page_map;
+        mmio->bank_page_map[0xE1] = &page_map_set->mega2_aux_page_map;
+    }
+    mmio->page_map_set = page_map_set;
+    mmio->mmap_register = page_map_set->mmap_register;
+}
+
+static void _clem_mmio_memory_map(ClemensMMIO *mmio, uint32_t memory_flags) {
+    struct ClemensMMIOPageMapSet *page_map_set;
+    unsigned set_idx;
+
+    if (memory_flags == mmio->mmap_register)
+        return;
+    //  sets not installed may hold host pointers to pages watched by the debugger
+    if (mmio->dev_debug && mmio->dev_debug->watch_generation != mmio->watch_generation) {
+        for (set_idx = 0; set_idx < CLEM_MMIO_PAGE_MAP_SET_COUNT; ++set_idx) {
+            if (&mmio->page_map_sets[set_idx] != mmio->page_map_set) {
+                mmio->page_map_sets[set_idx].valid = false;
+            }
+        }
+        mmio->watch_generation = mmio->dev_debug->watch_generation;
+    }
+    for (set_idx = 0; set_idx < CLEM_MMIO_PAGE_MAP_SET_COUNT; ++set_idx) {
+        page_map_set = &mmio->page_map_sets[set_idx];
+        if (page_map_set->valid && page_map_set->mmap_register == memory_flags) {
+            _clem_mmio_page_map_set_select(mmio, page_map_set);
+            return;
+        }
+    }
+    //  build the new state from the current one in the least recently built set
+    page_map_set = &mmio->page_map_sets[mmio->page_map_set_next];
+    if (page_map_set == mmio->page_map_set) {
+        mmio->page_map_set_next = (mmio->page_map_set_next + 1) % CLEM_MMIO_PAGE_MAP_SET_COUNT;
+        page_map_set = &mmio->page_map_sets[mmio->page_map_set_next];
+    }
+    mmio->page_map_set_next = (mmio->page_map_set_next + 1) % CLEM_MMIO_PAGE_MAP_SET_COUNT;
+    memcpy(page_map_set, mmio->page_map_set, sizeof(*page_map_set));
+    page_map_set->fpi_main_page_map.shadow_map = &page_map_set->fpi_mega2_main_shadow_map;
+    page_map_set->fpi_aux_page_map.shadow_map = &page_map_set->fpi_mega2_aux_shadow_map;
+    page_map_set->valid = true;
+    _clem_mmio_page_map_set_remap(mmio, page_map_set, memory_flags);
+    _clem_mmio_page_map_set_select(mmio, page_map_set);
 }
 
 void _clem_mmio_restore_mappings(ClemensMMIO *mmio) {
-    uint32_t memory_flags = mmio->mmap_register;
-    mmio->mmap_register = 0xffffffff;
-    _clem_mmio_memory_map(mmio, 0x0000000000);
-    _clem_mmio_memory_map(mmio, memory_flags);
+    struct ClemensMMIOPageMapSet *page_map_set = mmio->page_map_set;
+    unsigned set_idx;
+
+    if (!page_map_set) {
+        page_map_set = &mmio->page_map_sets[0];
+    }
+    //  rebuilds the current set from scratch, and drops the others since they
+    //  may depend on state outside of mmap_register (i.e. the C800 card ROM)
+    for (set_idx = 0; set_idx < CLEM_MMIO_PAGE_MAP_SET_COUNT; ++set_idx) {
+        mmio->page_map_sets[set_idx].valid = false;
+    }
+    page_map_set->valid = true;
+    page_map_set->mmap_register = 0xffffffff;
+    _clem_mmio_page_map_set_remap(mmio, page_map_set, 0x0000000000);
+    _clem_mmio_page_map_set_remap(mmio, page_map_set, mmio->mmap_register);
+    _clem_mmio_page_map_set_select(mmio, page_map_set);
 }
 
 void _clem_mmio_init_page_maps(ClemensMMIO *mmio, struct ClemensMemoryPageMap **bank_page_map,
                                uint8_t *e0_bank, uint8_t *e1_bank, uint32_t memory_flags) {
+    struct ClemensMMIOPageMapSet *page_map_set = &mmio->page_map_sets[0];
     struct ClemensMemoryPageMap *page_map;
     struct ClemensMemoryPageInfo *page;
     unsigned page_idx;
@@ -1702,13 +2186,13 @@ void _clem_mmio_init_page_maps(ClemensMMIO *mmio, struct ClemensMemoryPageMap **
         page->flags &= ~CLEM_MEM_PAGE_WRITEOK_FLAG;
     }
 
-    page_map = &mmio->fpi_main_page_map;
-    page_map->shadow_map = &mmio->fpi_mega2_main_shadow_map;
+    page_map = &page_map_set->fpi_main_page_map;
+    page_map->shadow_map = &page_map_set->fpi_mega2_main_shadow_map;
     for (page_idx = 0x00; page_idx < 0x100; ++page_idx) {
         _clem_mmio_create_page_mainaux_mapping(&page_map->pages[page_idx], page_idx, 0x00);
     }
-    page_map = &mmio->fpi_aux_page_map;
-    page_map->shadow_map = &mmio->fpi_mega2_aux_shadow_map;
+    page_map = &page_map_set->fpi_aux_page_map;
+    page_map->shadow_map = &page_map_set->fpi_mega2_aux_shadow_map;
     for (page_idx = 0x00; page_idx < 0x100; ++page_idx) {
         _clem_mmio_create_page_mainaux_mapping(&page_map->pages[page_idx], page_idx, 0x01);
     }
@@ -1719,7 +2203,7 @@ void _clem_mmio_init_page_maps(ClemensMMIO *mmio, struct ClemensMemoryPageMap **
         _clem_mmio_create_page_direct_mapping(&page_map->pages[page_idx], page_idx);
     }
     //  Banks E0 - C000-CFFF mapped as IO, Internal ROM
-    page_map = &mmio->mega2_main_page_map;
+    page_map = &page_map_set->mega2_main_page_map;
     page_map->shadow_map = NULL;
     for (page_idx = 0x00; page_idx < 0x100; ++page_idx) {
         _clem_mmio_create_page_direct_mapping(&page_map->pages[page_idx], page_idx);
@@ -1732,7 +2216,7 @@ void _clem_mmio_init_page_maps(ClemensMMIO *mmio, struct ClemensMemoryPageMap **
         page->flags &= ~CLEM_MEM_PAGE_WRITEOK_FLAG;
     }
     //  Banks E1 - C000-CFFF mapped as IO, Internal ROM
-    page_map = &mmio->mega2_aux_page_map;
+    page_map = &page_map_set->mega2_aux_page_map;
     page_map->shadow_map = NULL;
     for (page_idx = 0x00; page_idx < 0x100; ++page_idx) {
         _clem_mmio_create_page_direct_mapping(&page_map->pages[page_idx], page_idx);
@@ -1754,8 +2238,8 @@ void _clem_mmio_init_page_maps(ClemensMMIO *mmio, struct ClemensMemoryPageMap **
     }
 
     //  set up the default page mappings
-    mmio->bank_page_map[0x00] = &mmio->fpi_main_page_map;
-    mmio->bank_page_map[0x01] = &mmio->fpi_aux_page_map;
+    mmio->page_map_set = page_map_set;
+    mmio->page_map_set_next = 1;
 
     for (bank_idx = 0x02; bank_idx < mmio->fpi_ram_bank_count; ++bank_idx) {
         mmio->bank_page_map[bank_idx] = &mmio->fpi_direct_page_map;
@@ -1768,9 +2252,7 @@ void _clem_mmio_init_page_maps(ClemensMMIO *mmio, struct ClemensMemoryPageMap **
     for (bank_idx = 0x80; bank_idx < 0xF0; ++bank_idx) {
         mmio->bank_page_map[bank_idx] = &mmio->empty_page_map;
     }
-    /* Mega II banks */
-    mmio->bank_page_map[0xE0] = &mmio->mega2_main_page_map;
-    mmio->bank_page_map[0xE1] = &mmio->mega2_aux_page_map;
+    /* Mega II banks (and 00, 01) are set by _clem_mmio_restore_mappings() */
     /* TODO: handle expansion ROM and 128K firmware ROM 01*/
     for (bank_idx = 0xF0; bank_idx < 0x100; ++bank_idx) {
         mmio->bank_page_map[bank_idx] = &mmio->empty_page_map;
@@ -1779,8 +2261,10 @@ void _clem_mmio_init_page_maps(ClemensMMIO *mmio, struct ClemensMemoryPageMap **
         mmio->bank_page_map[bank_idx] = &mmio->fpi_rom_page_map;
     }
 
-    memset(&mmio->fpi_mega2_main_shadow_map, 0, sizeof(mmio->fpi_mega2_main_shadow_map));
-    memset(&mmio->fpi_mega2_aux_shadow_map, 0, sizeof(mmio->fpi_mega2_aux_shadow_map));
+    memset(&page_map_set->fpi_mega2_main_shadow_map, 0,
+           sizeof(page_map_set->fpi_mega2_main_shadow_map));
+    memset(&page_map_set->fpi_mega2_aux_shadow_map, 0,
+           sizeof(page_map_set->fpi_mega2_aux_shadow_map));
 
     /* brute force initialization of all page maps to ensure every option
        is executed on startup */
@@ -1794,6 +2278,7 @@ void clem_mmio_reset(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec) {
     mmio->mmap_register = CLEM_MEM_IO_MMAP_NSHADOW_SHGR | CLEM_MEM_IO_MMAP_WRLCRAM |
                                   CLEM_MEM_IO_MMAP_LCBANK2;
     _clem_mmio_restore_mappings(mmio);
+    _clem_mmio_init_io_handlers(mmio);
     clem_timer_reset(&mmio->dev_timer);
     clem_rtc_reset(&mmio->dev_rtc, CLEM_CLOCKS_PHI0_CYCLE);
     clem_adb_reset(&mmio->dev_adb);
@@ -1801,6 +2286,7 @@ void clem_mmio_reset(ClemensMMIO *mmio, struct ClemensTimeSpec *tspec) {
     clem_vgc_reset(&mmio->vgc);
     clem_iwm_reset(&mmio->dev_iwm, tspec);
     clem_scc_reset(&mmio->dev_scc, tspec);
+    mmio->next_event_ts = 0;
 }
 
 void clem_mmio_init(ClemensMMIO *mmio, struct ClemensDeviceDebugger *dev_debug,
@@ -1860,6 +2346,7 @@ void clem_mmio_bind_machine(ClemensMachine *clem, ClemensMMIO *mmio) {
     clem->mem.mmio_write = _clem_mmio_write_hook;
     clem->mem.mmio_read = _clem_mmio_read_hook;
     clem->mem.mmio_niolc = _clem_mmio_niolc;
+    clem->mem.last_data_address = &mmio->last_data_address;
 }
 
 void clem_mmio_restore(ClemensMachine *clem, ClemensMMIO *mmio) {
@@ -1867,5 +2354,7 @@ void clem_mmio_restore(ClemensMachine *clem, ClemensMMIO *mmio) {
     mmio->dev_debug = &clem->dev_debug;
     _clem_mmio_init_page_maps(mmio, clem->mem.bank_page_map, clem->mem.mega2_bank_map[0],
                               clem->mem.mega2_bank_map[1], mmio->mmap_register);
+    _clem_mmio_init_io_handlers(mmio);
     clem_vgc_reset_scanlines(&mmio->vgc);
+    mmio->next_event_ts = 0;
 }
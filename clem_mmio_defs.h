@@ -752,6 +752,11 @@
 #define CLEM_ENSONIQ_OSC_FLAG_CYCLE 0x01
 #define CLEM_ENSONIQ_OSC_FLAG_OIR   0x02
 
+//  band-limited step synthesis of the mix (see clem_audio.c) - the taps are the
+//  width of a step in output frames, and must be a multiple of 4
+#define CLEM_AUDIO_BLEP_TAPS   16
+#define CLEM_AUDIO_BLEP_PHASES 32
+
 /* enable/disable certain compile time diagnostics */
 
 #define CLEM_AUDIO_DIAGNOSTICS 0
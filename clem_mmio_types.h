@@ -213,6 +213,11 @@ struct ClemensDeviceAudio {
     clem_clocks_duration_t dt_mix_sample;
     unsigned mix_frame_index;
 
+    /* band-limited synthesis - pending step corrections for the next frames */
+    float blep_frames[2 * CLEM_AUDIO_BLEP_TAPS];
+    unsigned blep_frame_pos;
+    float doc_level; /**< DOC mix at the last pass through its oscillators */
+
     /* test code */
     float tone_frame_delta;
     float tone_theta;
@@ -420,6 +425,45 @@ struct ClemensDeviceMega2Memory {
     uint8_t *e1_bank;
 };
 
+#define CLEM_MMIO_PAGE_MAP_SET_COUNT 8
+
+/**
+ * @brief The bank 00, 01, E0 and E1 page maps for one memory mapping state
+ *
+ * Software often toggles between a few soft switch states (i.e. PAGE2, 80STORE,
+ * RAMRD/RAMWRT and the language card.)  Once a state's maps have been built,
+ * switching back to it only replaces the bank map pointers.
+ */
+struct ClemensMMIOPageMapSet {
+    struct ClemensMemoryPageMap fpi_main_page_map;
+    struct ClemensMemoryPageMap fpi_aux_page_map;
+    struct ClemensMemoryPageMap mega2_main_page_map;
+    struct ClemensMemoryPageMap mega2_aux_page_map;
+    /* Shadow maps for bank 00, 01 */
+    struct ClemensMemoryShadowMap fpi_mega2_main_shadow_map;
+    struct ClemensMemoryShadowMap fpi_mega2_aux_shadow_map;
+    uint32_t mmap_register; /* the memory mapping state these maps were built for */
+    bool valid;
+};
+
+struct ClemensMMIO;
+
+/**
+ * @brief Handles a read from an I/O register at $C000-$C0FF
+ *
+ * Handlers are indexed by the low byte of the register address.  Handlers for
+ * registers accessed at FPI speed clear *mega2_access.
+ */
+typedef uint8_t (*ClemensMMIOReadFn)(struct ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                     struct ClemensClock *ref_clock, uint16_t addr, uint8_t flags,
+                                     bool *mega2_access);
+/**
+ * @brief Handles a write to an I/O register at $C000-$C0FF
+ */
+typedef void (*ClemensMMIOWriteFn)(struct ClemensMMIO *mmio, struct ClemensTimeSpec *tspec,
+                                   struct ClemensClock *ref_clock, uint8_t data, uint16_t addr,
+                                   uint8_t flags, bool *mega2_access);
+
 /**
  * @brief Reflects the CPU state on the MMIO
  *
@@ -449,22 +493,26 @@ typedef struct ClemensMMIO {
     struct ClemensMemoryPageMap **bank_page_map;
     /* The different page mapping types */
     struct ClemensMemoryPageMap fpi_direct_page_map;
-    struct ClemensMemoryPageMap fpi_main_page_map;
-    struct ClemensMemoryPageMap fpi_aux_page_map;
     struct ClemensMemoryPageMap fpi_rom_page_map;
-    struct ClemensMemoryPageMap mega2_main_page_map;
-    struct ClemensMemoryPageMap mega2_aux_page_map;
     struct ClemensMemoryPageMap empty_page_map;
-
-    /* Shadow maps for bank 00, 01 */
-    struct ClemensMemoryShadowMap fpi_mega2_main_shadow_map;
-    struct ClemensMemoryShadowMap fpi_mega2_aux_shadow_map;
+    /* Bank 00, 01, E0, E1 maps built for recently used soft switch states.
+       page_map_set is the one installed in bank_page_map */
+    struct ClemensMMIOPageMapSet page_map_sets[CLEM_MMIO_PAGE_MAP_SET_COUNT];
+    struct ClemensMMIOPageMapSet *page_map_set;
+    unsigned page_map_set_next; /* next set to replace when building a new one */
+    uint32_t watch_generation;  /* dev_debug->watch_generation when sets were last checked */
 
     /* Reflected mega2 memory used for MMIO operations that require such access:
        i.e. floating bus data retrieval
     */
     uint8_t *e0_bank;
     uint8_t *e1_bank;
+    /* I/O register handlers indexed by the low byte of the $C0xx address, and
+       the number of non-debugger accesses made to each register */
+    ClemensMMIOReadFn io_read[256];
+    ClemensMMIOWriteFn io_write[256];
+    uint32_t io_read_count[256];
+    uint32_t io_write_count[256];
     /* end non-serialized attribute block */
 
     /* All devices */
@@ -491,6 +539,7 @@ typedef struct ClemensMMIO {
 
     uint64_t mega2_cycles;            // number of mega2 pulses/ticks since startup
     uint32_t timer_60hz_us;           // used for executing logic per 1/60th second
+    clem_clocks_time_t next_event_ts; // earliest scheduled device event (0 = sync now)
     int32_t card_expansion_rom_index; // card slot has the mutex on C800-CFFF
 
     /* All ticks are mega2 cycles */
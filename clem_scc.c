@@ -232,6 +232,39 @@ static bool _clem_scc_brg_tick(struct ClemensDeviceSCCChannel *channel) {
     return (channel->brg_counter & CLEM_SCC_BRG_STATUS_PULSE_FLAG) != 0;
 }
 
+//  Equivalent to calling tick() 'ticks' times - the counter is reloaded with the
+//  time constant after it reaches zero, toggling the flip-flop
+static void _clem_scc_brg_advance(struct ClemensDeviceSCCChannel *channel, uint64_t ticks) {
+    uint32_t period, remainder;
+    uint64_t reloads;
+    bool ff;
+
+    if (!ticks || !_clem_scc_is_brg_on(channel))
+        return;
+    if (ticks <= (channel->brg_counter & CLEM_SCC_BRG_STATUS_COUNTER_MASK)) {
+        channel->brg_counter = (channel->brg_counter & ~CLEM_SCC_BRG_STATUS_PULSE_FLAG) -
+                               (uint32_t)ticks;
+        return;
+    }
+    //  the first reload occurs on the tick after the counter reaches zero
+    ticks -= (channel->brg_counter & CLEM_SCC_BRG_STATUS_COUNTER_MASK) + 1;
+    ff = !(channel->brg_counter & CLEM_SCC_BRG_STATUS_FF_FLAG);
+    _clem_scc_brg_counter_reset(channel, ff);
+    period = (channel->brg_counter & CLEM_SCC_BRG_STATUS_COUNTER_MASK) + 1;
+    reloads = ticks / period;
+    remainder = (uint32_t)(ticks % period);
+    if (reloads & 1) {
+        ff = !ff;
+        channel->brg_counter ^= CLEM_SCC_BRG_STATUS_FF_FLAG;
+    }
+    if (remainder) {
+        channel->brg_counter -= remainder;
+    } else if (!ff) {
+        //  the last tick was a reload from high to low
+        channel->brg_counter |= CLEM_SCC_BRG_STATUS_PULSE_FLAG;
+    }
+}
+
 static inline unsigned _clem_scc_count_1_bits(uint8_t v, unsigned bps) {
     //   TODO: this could be a generated lookup table that returns even/odd
     unsigned cnt = 0;
@@ -531,6 +564,81 @@ static void _clem_scc_channel_port_states(struct ClemensDeviceSCC *scc, unsigned
     }
 }
 
+//  A channel is idle when clocking it only ticks the BRG - nothing to transmit,
+//  the receiver is waiting on a start bit and the status bits are current.
+static bool _clem_scc_is_channel_idle(struct ClemensDeviceSCC *scc, unsigned ch_idx) {
+    struct ClemensDeviceSCCChannel *channel = &scc->channel[ch_idx];
+    bool txd, rxd;
+
+    if (!_clem_scc_is_auto_enable(channel) || _clem_scc_check_port_cts_txrc(channel) ||
+        _clem_scc_is_local_loopback_enabled(channel) || _clem_scc_is_auto_echo_enabled(channel)) {
+        if (channel->tx_shift_ctr != 0 || !(channel->rr0 & CLEM_SCC_RR0_TX_EMPTY) ||
+            !channel->txd_internal)
+            return false;
+        txd = _clem_scc_is_auto_echo_enabled(channel) ? _clem_scc_check_port_rxd(channel) : true;
+        if (((channel->serial_port & CLEM_SCC_PORT_TX_D_LO) != 0) != txd)
+            return false;
+    }
+    if ((!_clem_scc_is_auto_enable(channel) || _clem_scc_check_port_dcd(channel) ||
+         _clem_scc_is_local_loopback_enabled(channel)) &&
+        !_clem_scc_is_synchronous_mode(channel)) {
+        rxd = _clem_scc_is_local_loopback_enabled(channel) ? channel->txd_internal != 0
+                                                           : _clem_scc_check_port_rxd(channel);
+        if (channel->rx_shift_ctr != 0 || !rxd)
+            return false;
+    }
+    if (!_clem_scc_is_interrupt_pending(scc, CLEM_SCC_RR3_EXT_STATUS_IP_A >> (ch_idx * 3))) {
+        if (((channel->rr0 & CLEM_SCC_RR0_CTS_STATUS) != 0) !=
+                _clem_scc_check_port_cts_txrc(channel) ||
+            ((channel->rr0 & CLEM_SCC_RR0_DCD_STATUS) != 0) != _clem_scc_check_port_dcd(channel))
+            return false;
+        if (_clem_scc_is_brg_on(channel) &&
+            _clem_scc_is_interrupt_enabled(channel, CLEM_SCC_INT_ZERO_COUNT_INT_ENABLE))
+            return false;
+    }
+    return true;
+}
+
+//  Advances an idle channel to next_ts in one step, issuing the same BRG ticks
+//  and edges as the edge by edge loop in clem_scc_sync_channel_uart().
+static void _clem_scc_channel_skip(struct ClemensDeviceSCC *scc, unsigned ch_idx,
+                                   clem_clocks_time_t next_ts) {
+    struct ClemensDeviceSCCChannel *channel = &scc->channel[ch_idx];
+    clem_clocks_duration_t edge_step = _clem_scc_channel_calc_clock_step(channel, scc->xtal_step);
+    clem_clocks_time_t master_ts;
+    uint64_t master_ticks, xtal_edges, pclk_edges;
+
+    if (channel->master_clock_ts >= next_ts)
+        return;
+    //  edges are processed up to the last master clock before next_ts
+    master_ticks = (next_ts - channel->master_clock_ts + channel->master_clock_step - 1) /
+                   channel->master_clock_step;
+    master_ts = channel->master_clock_ts + (master_ticks - 1) * channel->master_clock_step;
+    channel->master_clock_ts += master_ticks * channel->master_clock_step;
+
+    xtal_edges = 0;
+    if (channel->xtal_edge_ts <= master_ts) {
+        xtal_edges = (master_ts - channel->xtal_edge_ts) / edge_step + 1;
+        channel->xtal_edge_ts += xtal_edges * edge_step;
+    }
+    pclk_edges = 0;
+    if (channel->pclk_edge_ts <= master_ts) {
+        pclk_edges = (master_ts - channel->pclk_edge_ts) / edge_step + 1;
+        channel->pclk_edge_ts += pclk_edges * edge_step;
+    }
+    if (!xtal_edges && !pclk_edges)
+        return;
+
+    if (_clem_scc_is_xtal_enabled(channel) &&
+        _clem_scc_is_brg_clock_mode(channel, CLEM_SCC_CLOCK_MODE_XTAL)) {
+        _clem_scc_brg_advance(channel, xtal_edges);
+    }
+    if (_clem_scc_is_brg_clock_mode(channel, CLEM_SCC_CLOCK_MODE_PCLK)) {
+        _clem_scc_brg_advance(channel, pclk_edges);
+    }
+    _clem_scc_channel_port_states(scc, ch_idx);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void clem_scc_reset_channel(struct ClemensDeviceSCC *scc, clem_clocks_time_t ts, unsigned ch_idx,
@@ -586,6 +694,12 @@ void clem_scc_sync_channel_uart(struct ClemensDeviceSCC *scc, unsigned ch_idx,
         return;
     }
 
+    //  idle serial ports are advanced in one step regardless of the delta
+    if (_clem_scc_is_channel_idle(scc, ch_idx)) {
+        _clem_scc_channel_skip(scc, ch_idx, next_ts);
+        return;
+    }
+
     trxc_pulse = false;
     brg_pulse = false;
 
@@ -648,6 +762,27 @@ void clem_scc_glu_sync(struct ClemensDeviceSCC *scc, struct ClemensClock *clock)
     }
 }
 
+clem_clocks_time_t clem_scc_glu_next_event_ts(struct ClemensDeviceSCC *scc) {
+    clem_clocks_time_t next_ts = CLEM_TIME_NEVER;
+    unsigned ch_idx;
+    //  disabled and idle channels only advance their clocks and BRG, which sync()
+    //  handles in one step when their registers are next accessed
+    for (ch_idx = 0; ch_idx < 2; ++ch_idx) {
+        struct ClemensDeviceSCCChannel *channel = &scc->channel[ch_idx];
+        if (!_clem_scc_is_rx_enabled(channel) && !_clem_scc_is_tx_enabled(channel))
+            continue;
+        if (_clem_scc_is_channel_idle(scc, ch_idx))
+            continue;
+        if (channel->xtal_edge_ts < next_ts) {
+            next_ts = channel->xtal_edge_ts;
+        }
+        if (channel->pclk_edge_ts < next_ts) {
+            next_ts = channel->pclk_edge_ts;
+        }
+    }
+    return next_ts;
+}
+
 void clem_scc_reg_command_wr0(struct ClemensDeviceSCC *scc, unsigned ch_idx, uint8_t value) {
     struct ClemensDeviceSCCChannel *channel = &scc->channel[ch_idx];
     //  register commands are unnecessary (bits 0-2), and CRC related settings (bits 6,7)
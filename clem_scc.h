@@ -152,6 +152,14 @@ void clem_scc_reset(struct ClemensDeviceSCC *scc, struct ClemensTimeSpec *tspec)
  */
 void clem_scc_glu_sync(struct ClemensDeviceSCC *scc, struct ClemensClock *clock);
 
+/**
+ * @brief Returns the next clock edge for channels with an active transmitter or receiver
+ *
+ * @param scc
+ * @return clem_clocks_time_t CLEM_TIME_NEVER if both channels are idle
+ */
+clem_clocks_time_t clem_scc_glu_next_event_ts(struct ClemensDeviceSCC *scc);
+
 /**
  * @brief
  *
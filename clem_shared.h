@@ -17,6 +17,8 @@ typedef uint8_t *(*ClemensSerializerAllocateCb)(unsigned /* type */, unsigned /*
                                                 void * /* context */);
 
 #define CLEM_TIME_UNINITIALIZED ((clem_clocks_time_t)(-1))
+/* Returned by devices that have no pending event to schedule */
+#define CLEM_TIME_NEVER ((clem_clocks_time_t)(-1))
 
 /** A bit confusing and created to avoid floating point math whenever possible
  *  (whether this was a good choice given modern architectures... ?)
@@ -119,6 +121,15 @@ struct ClemensClock {
     clem_clocks_duration_t ref_step;
 };
 
+/* A contiguous DMA transfer between a card's buffer and machine memory */
+struct ClemensCardDMA {
+    uint8_t *data;    /* source of memory writes or destination of memory reads */
+    uint16_t adr;     /* starting address, wrapping within the bank */
+    uint16_t length;  /* bytes remaining in the transfer */
+    uint8_t bank;
+    uint8_t is_write; /* 1 if the card writes to memory */
+};
+
 /**
  * @brief Defines the abstract interface to slot-based card hardware
  *
@@ -134,6 +145,15 @@ typedef struct {
     uint32_t (*io_sync)(struct ClemensClock *clock, void *context);
     /* executed once per cycle if io_sync() returns DMA, this returns 1 if a write */
     uint32_t (*io_dma)(uint8_t* data_bank, uint16_t* adr, uint8_t is_adr_bus, void* context);
+    /* optional - replaces io_dma() with block transfers.  Returns 1 and fills in 'dma'
+       if a transfer is pending.  Memory is copied in bulk at one byte per Mega II
+       cycle elapsed since the last io_sync(), and io_dma_done() receives the number
+       of bytes moved (which may be less than dma->length.) */
+    uint32_t (*io_dma_block)(struct ClemensCardDMA *dma, void *context);
+    void (*io_dma_done)(unsigned count, void *context);
+    /* optional - returns the time of the card's next internal event (i.e. timer IRQ) so that
+       io_sync() can be deferred until then.  If NULL, io_sync() is called every step */
+    clem_clocks_time_t (*io_next_event)(struct ClemensClock *clock, void *context);
     const char *(*io_name)(void *context);
 } ClemensCard;
 
@@ -26,6 +26,15 @@ struct ClemensMemoryPageInfo {
     uint8_t bank_read;
     uint8_t bank_write;
     uint32_t flags;
+    /* Host memory for plain RAM/ROM pages, resolved from the fields above on
+       first access.  NULL means the access must go through the page flags,
+       unless a CLEM_MEM_PAGE_HOST_DIRECT flag is set.  These are cleared
+       whenever the page map changes. */
+    uint8_t *host_read;
+    uint8_t *host_write;
+    /* the physical bank:page behind host_write (for Mega II dirty tracking) */
+    uint8_t host_write_bank;
+    uint8_t host_write_page;
 };
 
 struct ClemensMemoryShadowMap {
@@ -181,6 +190,53 @@ enum {
 };
 
 typedef void (*ClemensOpcodeCallback)(struct ClemensInstruction *, const char *, void *);
+typedef bool (*ClemensDebugBreakCallback)(void *);
+
+/* see clemens_debug_add_breakpoint() */
+enum ClemensDebugBreakpointType {
+    kClemensDebugBreakpoint_None,
+    kClemensDebugBreakpoint_Execute,
+    kClemensDebugBreakpoint_DataRead,
+    kClemensDebugBreakpoint_Write,
+    kClemensDebugBreakpoint_BRK
+};
+
+/* One bit per 256 byte page of a Mega II bank */
+#define CLEM_MEGA2_DIRTY_PAGE_BITMAP_SIZE (256 / 8)
+
+/* ClemensBusTraceRecord flags */
+#define CLEM_BUS_TRACE_FLAG_WRITE 0x01
+#define CLEM_BUS_TRACE_FLAG_VDA   0x02
+#define CLEM_BUS_TRACE_FLAG_VPA   0x04
+#define CLEM_BUS_TRACE_FLAG_IO    0x08
+#define CLEM_BUS_TRACE_FLAG_MEGA2 0x10
+/* Records were dropped before this one because the ring was full */
+#define CLEM_BUS_TRACE_FLAG_GAP 0x80
+
+/* A single CPU bus cycle.  The layout is fixed so that records can be written
+   as is to a binary trace file. */
+struct ClemensBusTraceRecord {
+    clem_clocks_time_t ts; /* clocks_spent at the end of the cycle */
+    uint16_t adr;
+    uint8_t bank;
+    uint8_t data;
+    uint8_t flags;
+    uint8_t reserved[3];
+};
+
+/* Single producer/single consumer ring of bus cycles (see
+   clemens_bus_trace_attach()).  The emulator owns 'write', 'tail_cached' and
+   'dropped', and publishes 'head'.  The consumer owns 'tail'. */
+struct ClemensBusTrace {
+    struct ClemensBusTraceRecord *records;
+    uint32_t capacity_mask; /* capacity - 1, where capacity is a power of two */
+    uint32_t head;
+    uint32_t tail;
+    uint32_t write;
+    uint32_t tail_cached;
+    uint32_t dropped;
+    bool gap;
+};
 
 struct ClemensMemory {
     /* each used bank MUST be 64K (65536) bytes */
@@ -202,12 +258,65 @@ struct ClemensMemory {
     uint8_t (*mmio_read)(struct ClemensMemory *, struct ClemensTimeSpec *, uint16_t /* addr */,
                          uint8_t /* flags*/, bool *);
     bool (*mmio_niolc)(struct ClemensMemory *);
+    /* If set, receives the bank:address of every CPU data access (used by MMIO
+       switches that check if an address was accessed twice in succession) */
+    uint32_t *last_data_address;
+    /* Set when an access reaches the MMIO callbacks above, except for reads of
+       polling registers without side effects.  Cleared by
+       clemens_emulate_cpu_until() so it can return to let the MMIO sync */
+    bool mmio_accessed;
+    /* Incremented on any access that can change machine state (writes and I/O
+       reads with side effects).  Used for idle loop detection. */
+    uint32_t mutation_count;
+    /* Pages of banks $E0 and $E1 written directly or through shadowing since
+       the host last consumed a video frame (see clemens_video_next_frame()) */
+    uint8_t mega2_dirty_pages[2][CLEM_MEGA2_DIRTY_PAGE_BITMAP_SIZE];
+    /* If set, every CPU bus cycle is appended to this ring */
+    struct ClemensBusTrace *bus_trace;
+};
+
+/* Tracks a candidate idle loop at the target of a short backward branch.  The
+   anchor is the CPU and PHI0 timing state at one visit to the loop head. */
+struct ClemensIdleLoop {
+    struct ClemensCPURegs regs;
+    clem_clocks_time_t clocks_spent;
+    clem_clocks_duration_t phi0_offset; /* clocks_next_phi0 - clocks_spent */
+    clem_clocks_duration_t phi0_current_step;
+    clem_clocks_duration_t clocks_step;
+    unsigned mega2_scanline_ctr;
+    uint32_t cycles_spent;
+    uint32_t mutation_count;
+    unsigned visits;
+    bool emulation;
 };
 
+/* Must be a power of two.  At most half of the slots are used */
+#define CLEM_DEBUG_BREAKPOINT_HASH_SIZE 256
+#define CLEM_DEBUG_BREAKPOINT_LIMIT     (CLEM_DEBUG_BREAKPOINT_HASH_SIZE / 2)
+
+#define CLEM_DEBUG_BREAKPOINT_KEY(_type_, _bank_, _adr_)                                           \
+    (((uint32_t)(_type_) << 24) | ((uint32_t)(_bank_) << 16) | (uint16_t)(_adr_))
+
 struct ClemensDeviceDebugger {
     ClemensLoggerFn log_message;
     uint16_t pc; /* these values are passed from the CPU per frame */
     uint8_t pbr;
+
+    /* Breakpoints keyed by (type << 24) | (bank << 16) | address in an open
+       addressed hash table.  0 marks an empty slot. */
+    uint32_t breakpoints[CLEM_DEBUG_BREAKPOINT_HASH_SIZE];
+    unsigned breakpoint_count;
+    unsigned breakpoint_types; /* one bit per ClemensDebugBreakpointType in use */
+    /* One bit per page index (of any bank) holding a data watchpoint.  These
+       pages never cache host memory pointers, so that every access reaches the
+       watchpoint check in clem_read() and clem_write() */
+    uint8_t watch_pages[256 / 8];
+    /* changes whenever watch_pages changes, so that the MMIO can drop cached
+       page maps that may still hold host pointers to watched pages */
+    uint32_t watch_generation;
+    /* key of the last watchpoint hit by the current clemens_emulate_cpu() or
+       clemens_emulate_cpu_until() call, or 0 */
+    uint32_t watch_hit;
 };
 
 /**
@@ -218,6 +327,7 @@ typedef struct ClemensMachine {
     struct Clemens65C816 cpu;
     struct ClemensTimeSpec tspec;
     struct ClemensMemory mem;
+    struct ClemensIdleLoop idle_loop;
 
     /** Internal, tracks cycle count for holding down the reset key */
     int resb_counter;
@@ -232,6 +342,8 @@ typedef struct ClemensMachine {
     void *debug_user_ptr;
     /* opcode print callback */
     ClemensOpcodeCallback opcode_post;
+    /* breakpoint check issued after each instruction by clemens_emulate_cpu_until() */
+    ClemensDebugBreakCallback debug_break;
     /* logger callback (if NULL, uses stdout) */
     ClemensLoggerFn logger_fn;
 } ClemensMachine;
@@ -269,6 +269,14 @@ void clem_vgc_sync(struct ClemensVGC *vgc, struct ClemensClock *clock, const uin
     vgc->ts_last_frame = clock->ts;
 }
 
+clem_clocks_time_t clem_vgc_next_event_ts(struct ClemensVGC *vgc) {
+    //  scanline IRQs, palette latching and the VBL all occur on scanline boundaries
+    if (vgc->mode_flags & CLEM_VGC_INIT) {
+        return 0;
+    }
+    return vgc->ts_last_frame + (CLEM_VGC_HORIZ_SCAN_DURATION(0) - vgc->dt_scanline);
+}
+
 void clem_vgc_calc_counters(struct ClemensVGC *vgc, struct ClemensClock *clock, unsigned *v_counter,
                             unsigned *h_counter) {
     /* 65 cycles per horizontal scanline, 978 ns per horizontal count = 63.57us
@@ -17,6 +17,7 @@ void clem_vgc_reset_scanlines(struct ClemensVGC *vgc);
 
 void clem_vgc_sync(struct ClemensVGC *vgc, struct ClemensClock *clock, const uint8_t *mega2_bank0,
                    const uint8_t *mega2_bank1);
+clem_clocks_time_t clem_vgc_next_event_ts(struct ClemensVGC *vgc);
 
 void clem_vgc_scanline_enable_int(struct ClemensVGC *vgc, bool enable);
 
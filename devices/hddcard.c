@@ -461,6 +461,48 @@ static uint32_t io_sync(struct ClemensClock *clock, void *ctxptr) {
     return 0;
 }
 
+static clem_clocks_time_t io_next_event(struct ClemensClock *clock, void *ctxptr) {
+    struct ClemensHddCardContext *context = (struct ClemensHddCardContext *)(ctxptr);
+    //  formatting and DMA transfers advance on every sync
+    if (context->state == CLEM_CARD_HDD_STATE_FORMAT ||
+        (context->state & CLEM_CARD_HDD_STATE_DMA)) {
+        return clock->ts;
+    }
+    return CLEM_TIME_NEVER;
+}
+
+//  Finishes the command once the last byte of its transfer has moved
+static void _clem_card_hdd_dma_complete(struct ClemensHddCardContext *context) {
+    if (context->cmd_num == CLEM_CARD_HDD_COMMAND_WRITE) {
+        // commit block
+        uint8_t drive_index = _clem_card_hdd_select_drive(context);
+        if (context->write_prot[drive_index]) {
+            _clem_card_hdd_fail_idle(context, CLEM_CARD_HDD_PRODOS_ERR_WPROT);
+        } else {
+            context->results[CLEM_CARD_HDD_RES_0] = (*context->hdd[drive_index]->write_block)(
+                context->hdd[drive_index]->user_context, 0, context->block_num,
+                context->block_data);
+            if (context->results[CLEM_CARD_HDD_RES_0] != CLEM_SMARTPORT_STATUS_CODE_OK) {
+                _clem_card_hdd_fail_idle(context, CLEM_CARD_HDD_PRODOS_ERR_IO);
+            } else {
+                if (_clem_card_hdd_is_smartport_cmd(context)) {
+                    context->results[CLEM_CARD_HDD_RES_0] =
+                        (uint8_t)(context->dma_offset & 0xff);
+                    context->results[CLEM_CARD_HDD_RES_1] =
+                        (uint8_t)((context->dma_offset >> 8) & 0xff);
+                }
+                _clem_card_hdd_ok(context);
+            }
+        }
+    } else {
+        if (_clem_card_hdd_is_smartport_cmd(context)) {
+            context->results[CLEM_CARD_HDD_RES_0] = (uint8_t)(context->dma_offset & 0xff);
+            context->results[CLEM_CARD_HDD_RES_1] = (uint8_t)((context->dma_offset >> 8) & 0xff);
+        }
+        _clem_card_hdd_ok(context);
+    }
+}
+
 static uint32_t io_dma(uint8_t *data_bank, uint16_t *adr, uint8_t is_adr_bus, void *ctxptr) {
     // MISC = 0; is_adr_bus = true; *data_bank = 0x00 (bank); adr = dma_offset; MISC++
     // MISC = 1; is_adr_bus = false; *data_bank = data; dma_offset++;
@@ -484,39 +526,36 @@ static uint32_t io_dma(uint8_t *data_bank, uint16_t *adr, uint8_t is_adr_bus, vo
         }
     }
     if (context->dma_offset == context->dma_size) {
-        if (context->cmd_num == CLEM_CARD_HDD_COMMAND_WRITE) {
-            // commit block
-            uint8_t drive_index = _clem_card_hdd_select_drive(context);
-            if (context->write_prot[drive_index]) {
-                _clem_card_hdd_fail_idle(context, CLEM_CARD_HDD_PRODOS_ERR_WPROT);
-            } else {
-                context->results[CLEM_CARD_HDD_RES_0] = (*context->hdd[drive_index]->write_block)(
-                    context->hdd[drive_index]->user_context, 0, context->block_num,
-                    context->block_data);
-                if (context->results[CLEM_CARD_HDD_RES_0] != CLEM_SMARTPORT_STATUS_CODE_OK) {
-                    _clem_card_hdd_fail_idle(context, CLEM_CARD_HDD_PRODOS_ERR_IO);
-                } else {
-                    if (_clem_card_hdd_is_smartport_cmd(context)) {
-                        context->results[CLEM_CARD_HDD_RES_0] =
-                            (uint8_t)(context->dma_offset & 0xff);
-                        context->results[CLEM_CARD_HDD_RES_1] =
-                            (uint8_t)((context->dma_offset >> 8) & 0xff);
-                    }
-                    _clem_card_hdd_ok(context);
-                }
-            }
-        } else {
-            if (_clem_card_hdd_is_smartport_cmd(context)) {
-                context->results[CLEM_CARD_HDD_RES_0] = (uint8_t)(context->dma_offset & 0xff);
-                context->results[CLEM_CARD_HDD_RES_1] =
-                    (uint8_t)((context->dma_offset >> 8) & 0xff);
-            }
-            _clem_card_hdd_ok(context);
-        }
+        _clem_card_hdd_dma_complete(context);
     }
     return out;
 }
 
+static uint32_t io_dma_block(struct ClemensCardDMA *dma, void *ctxptr) {
+    struct ClemensHddCardContext *context = (struct ClemensHddCardContext *)(ctxptr);
+    uint16_t dma_end = context->dma_size;
+    if (dma_end > (uint16_t)sizeof(context->block_data)) {
+        dma_end = (uint16_t)sizeof(context->block_data);
+    }
+    if (!(context->state & CLEM_CARD_HDD_STATE_DMA) || context->dma_offset >= dma_end) {
+        return 0;
+    }
+    dma->data = &context->block_data[context->dma_offset];
+    dma->adr = context->dma_addr + context->dma_offset;
+    dma->length = dma_end - context->dma_offset;
+    dma->bank = 0x00;
+    dma->is_write = (context->state == CLEM_CARD_HDD_STATE_DMA_W) ? 1 : 0;
+    return 1;
+}
+
+static void io_dma_done(unsigned count, void *ctxptr) {
+    struct ClemensHddCardContext *context = (struct ClemensHddCardContext *)(ctxptr);
+    context->dma_offset += (uint16_t)count;
+    if (context->dma_offset == context->dma_size) {
+        _clem_card_hdd_dma_complete(context);
+    }
+}
+
 static void io_read(struct ClemensClock *clock, uint8_t *data, uint8_t addr, uint8_t flags,
                     void *ctxptr) {
     struct ClemensHddCardContext *context = (struct ClemensHddCardContext *)(ctxptr);
@@ -681,6 +720,9 @@ void clem_card_hdd_initialize(ClemensCard *card) {
     card->io_write = &io_write;
     card->io_name = &io_name;
     card->io_dma = &io_dma;
+    card->io_dma_block = &io_dma_block;
+    card->io_dma_done = &io_dma_done;
+    card->io_next_event = &io_next_event;
 }
 
 void clem_card_hdd_uninitialize(ClemensCard *card) {
@@ -692,6 +734,9 @@ void clem_card_hdd_uninitialize(ClemensCard *card) {
     card->io_write = NULL;
     card->io_name = NULL;
     card->io_dma = NULL;
+    card->io_dma_block = NULL;
+    card->io_dma_done = NULL;
+    card->io_next_event = NULL;
 }
 
 void clem_card_hdd_mount(ClemensCard *card, ClemensProdosHDD32 *hdd, uint8_t drive_index) {
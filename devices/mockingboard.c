@@ -3,6 +3,7 @@
 #include "serializer.h"
 
 #include <float.h>
+#include <limits.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stdlib.h>
@@ -883,6 +884,44 @@ static uint32_t io_sync(struct ClemensClock *clock, void *context) {
                : 0;
 }
 
+/* Timer steps remaining until an enabled timer interrupt is flagged.  A timer
+   waiting to reload its counter is reported as 1 step (conservative) */
+static unsigned _clem_via_steps_to_irq(struct ClemensVIA6522 *via) {
+    unsigned steps = UINT_MAX;
+    if ((via->ier & CLEM_VIA_6522_IER_TIMER1) && !(via->ifr & CLEM_VIA_6522_IER_TIMER1)) {
+        if (via->timer1_status == kClemensVIA6522TimerStatus_LoadCounter) {
+            steps = 1;
+        } else if (via->timer1_status == kClemensVIA6522TimerStatus_Active) {
+            steps = (unsigned)via->timer1[1] + 1;
+        }
+    }
+    if ((via->ier & CLEM_VIA_6522_IER_TIMER2) && !(via->ifr & CLEM_VIA_6522_IER_TIMER2)) {
+        if (via->timer2_status == kClemensVIA6522TimerStatus_LoadCounter) {
+            steps = 1;
+        } else if (via->timer2_status == kClemensVIA6522TimerStatus_Active) {
+            if ((unsigned)via->timer2[1] + 1 < steps) {
+                steps = (unsigned)via->timer2[1] + 1;
+            }
+        }
+    }
+    return steps;
+}
+
+static clem_clocks_time_t io_next_event(struct ClemensClock *clock, void *context) {
+    ClemensMockingboardContext *board = (ClemensMockingboardContext *)context;
+    unsigned steps = _clem_via_steps_to_irq(&board->via[0]);
+    unsigned steps_1 = _clem_via_steps_to_irq(&board->via[1]);
+    if (steps_1 < steps) {
+        steps = steps_1;
+    }
+    if (steps == UINT_MAX) {
+        return CLEM_TIME_NEVER;
+    }
+    //  io_sync() only steps the VIAs once its budget exceeds a full step
+    return board->last_clocks.ts + (clem_clocks_time_t)steps * board->last_clocks.ref_step -
+           board->sync_time_budget + 1;
+}
+
 static void io_read(struct ClemensClock *clock, uint8_t *data, uint8_t addr, uint8_t flags,
                     void *context) {
     ClemensMockingboardContext *board = (ClemensMockingboardContext *)context;
@@ -1117,6 +1156,9 @@ void clem_card_mockingboard_initialize(ClemensCard *card) {
     card->io_write = &io_write;
     card->io_name = &io_name;
     card->io_dma = NULL;
+    card->io_dma_block = NULL;
+    card->io_dma_done = NULL;
+    card->io_next_event = &io_next_event;
 }
 
 void clem_card_mockingboard_uninitialize(ClemensCard *card) {
@@ -160,6 +160,8 @@ static struct ClemensOpcodeDesc sOpcodeDescriptions[256];
 
 static inline void _opcode_instruction_define_mvn(struct ClemensInstruction *instr, uint8_t opcode,
                                                   uint8_t dest, uint8_t src) {
+    if (!instr)
+        return;
     instr->desc = &sOpcodeDescriptions[opcode];
     instr->opc_8 = false;
     instr->value = src;
@@ -168,6 +170,8 @@ static inline void _opcode_instruction_define_mvn(struct ClemensInstruction *ins
 
 static inline void _opcode_instruction_define(struct ClemensInstruction *instr, uint8_t opcode,
                                               uint16_t value, bool opc_8) {
+    if (!instr)
+        return;
     instr->desc = &sOpcodeDescriptions[opcode];
     instr->bank = 0x00;
     instr->opc_8 = opc_8;
@@ -176,6 +180,8 @@ static inline void _opcode_instruction_define(struct ClemensInstruction *instr,
 
 static inline void _opcode_instruction_define_simple(struct ClemensInstruction *instr,
                                                      uint8_t opcode) {
+    if (!instr)
+        return;
     instr->desc = &sOpcodeDescriptions[opcode];
     instr->opc = opcode;
     instr->bank = 0x00;
@@ -185,6 +191,8 @@ static inline void _opcode_instruction_define_simple(struct ClemensInstruction *
 
 static inline void _opcode_instruction_define_long(struct ClemensInstruction *instr, uint8_t opcode,
                                                    uint8_t bank, uint16_t addr) {
+    if (!instr)
+        return;
     instr->desc = &sOpcodeDescriptions[opcode];
     instr->bank = bank;
     instr->opc_8 = false;
@@ -193,6 +201,8 @@ static inline void _opcode_instruction_define_long(struct ClemensInstruction *in
 
 static inline void _opcode_instruction_define_dp(struct ClemensInstruction *instr, uint8_t opcode,
                                                  uint8_t offset) {
+    if (!instr)
+        return;
     instr->desc = &sOpcodeDescriptions[opcode];
     instr->bank = 0x00;
     instr->opc_8 = false;
@@ -712,6 +722,75 @@ void clemens_opcode_callback(ClemensMachine *clem, ClemensOpcodeCallback callbac
     clem->opcode_post = callback;
 }
 
+void clemens_debug_break_callback(ClemensMachine *clem, ClemensDebugBreakCallback callback) {
+    clem->debug_break = callback;
+}
+
+bool clemens_debug_add_breakpoint(ClemensMachine *clem, enum ClemensDebugBreakpointType type,
+                                  uint32_t address) {
+    struct ClemensMemoryPageMap *page_map;
+    unsigned bank_idx;
+    uint8_t page_idx = (uint8_t)(address >> 8);
+
+    if (!clem_debug_add_breakpoint(&clem->dev_debug, type, address))
+        return false;
+    if (type != kClemensDebugBreakpoint_DataRead && type != kClemensDebugBreakpoint_Write)
+        return true;
+    //  accesses to the page must leave the fast path for the watchpoint check
+    for (bank_idx = 0; bank_idx < 256; ++bank_idx) {
+        page_map = clem->mem.bank_page_map[bank_idx];
+        if (page_map) {
+            page_map->pages[page_idx].host_read = NULL;
+            page_map->pages[page_idx].host_write = NULL;
+            page_map->pages[page_idx].flags &= ~CLEM_MEM_PAGE_HOST_DIRECT_MASK;
+        }
+    }
+    return true;
+}
+
+void clemens_debug_clear_breakpoints(ClemensMachine *clem) {
+    clem_debug_clear_breakpoints(&clem->dev_debug);
+}
+
+uint32_t clemens_debug_breakpoint_hit(const ClemensMachine *clem) {
+    const struct ClemensDeviceDebugger *dbg = &clem->dev_debug;
+    const struct Clemens65C816 *cpu = &clem->cpu;
+    uint32_t key;
+
+    if (dbg->watch_hit)
+        return dbg->watch_hit;
+    if (dbg->breakpoint_types & (1 << kClemensDebugBreakpoint_Execute)) {
+        key = CLEM_DEBUG_BREAKPOINT_KEY(kClemensDebugBreakpoint_Execute, cpu->regs.PBR,
+                                        cpu->regs.PC);
+        if (clem_debug_has_breakpoint(dbg, key))
+            return key;
+    }
+    if ((dbg->breakpoint_types & (1 << kClemensDebugBreakpoint_BRK)) &&
+        cpu->regs.IR == CLEM_OPC_BRK)
+        return CLEM_DEBUG_BREAKPOINT_KEY(kClemensDebugBreakpoint_BRK, 0, 0);
+    return 0;
+}
+
+void clemens_bus_trace_init(struct ClemensBusTrace *trace, struct ClemensBusTraceRecord *records,
+                            unsigned capacity) {
+    CLEM_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0);
+    memset(trace, 0, sizeof(*trace));
+    trace->records = records;
+    trace->capacity_mask = capacity - 1;
+}
+
+void clemens_bus_trace_attach(ClemensMachine *clem, struct ClemensBusTrace *trace) {
+    if (clem->mem.bus_trace) {
+        clem_mem_bus_trace_publish(clem->mem.bus_trace);
+    }
+    clem->mem.bus_trace = trace;
+}
+
+unsigned clemens_bus_trace_read(struct ClemensBusTrace *trace,
+                                struct ClemensBusTraceRecord *records, unsigned limit) {
+    return clem_mem_bus_trace_read(trace, records, limit);
+}
+
 void clemens_create_page_mapping(struct ClemensMemoryPageInfo *page, uint8_t page_idx,
                                  uint8_t bank_read_idx, uint8_t bank_write_idx) {
     clem_mem_create_page_mapping(page, page_idx, bank_read_idx, bank_write_idx);
@@ -775,6 +854,10 @@ void clemens_simple_init(ClemensMachine *machine, uint32_t speed_factor, uint32_
     }
 
     memset(&machine->mem.bank_page_map, 0, sizeof(machine->mem.bank_page_map));
+    memset(&machine->idle_loop, 0, sizeof(machine->idle_loop));
+    //  the host has yet to render anything
+    memset(machine->mem.mega2_dirty_pages, 0xff, sizeof(machine->mem.mega2_dirty_pages));
+    machine->mem.bus_trace = NULL;
 }
 
 void clemens_register() {
@@ -816,6 +899,9 @@ bool clemens_load_hex(ClemensMachine *clem, const char *hex, const char *hex_end
     unsigned data;
     uint8_t chksum = 0;
 
+    //  memory is written directly and bypasses video page tracking
+    memset(clem->mem.mega2_dirty_pages, 0xff, sizeof(clem->mem.mega2_dirty_pages));
+
     while ((hex_end && line < hex_end) || *line) {
         char cur_state = state;
         if (state == CLEM_LOAD_HEX_STATE_EOF) {
@@ -1007,2175 +1093,351 @@ void clemens_out_bin_data(const ClemensMachine *clem, uint8_t *out, unsigned out
     memcpy(out, memory + left0, right0 - left0);
 }
 
+//  The opcode handlers live in clem_cpu_execute.h, which is compiled into a
+//  variant per reachable (e, m, x) mode so that status checks fold into
+//  constants, plus one traced variant for debugging.  Emulation mode always runs
+//  with m and x set, so it has only the e1/m1/x1 variant.
+
+static bool _clem_cpu_step_end(ClemensMachine *clem, uint16_t opc_pc, uint8_t opc_pbr,
+                               clem_clocks_time_t clocks);
+
+#define CLEM_CPU_EXECUTE_FN        _cpu_execute_e0_m0_x0
+#define CLEM_CPU_EXECUTE_TRACED    false
+#define CLEM_CPU_EXECUTE_EMULATION false
+#define CLEM_CPU_EXECUTE_M         false
+#define CLEM_CPU_EXECUTE_X         false
+#include "clem_cpu_execute.h"
+
+#define CLEM_CPU_EXECUTE_FN        _cpu_execute_e0_m0_x1
+#define CLEM_CPU_EXECUTE_TRACED    false
+#define CLEM_CPU_EXECUTE_EMULATION false
+#define CLEM_CPU_EXECUTE_M         false
+#define CLEM_CPU_EXECUTE_X         true
+#include "clem_cpu_execute.h"
+
+#define CLEM_CPU_EXECUTE_FN        _cpu_execute_e0_m1_x0
+#define CLEM_CPU_EXECUTE_TRACED    false
+#define CLEM_CPU_EXECUTE_EMULATION false
+#define CLEM_CPU_EXECUTE_M         true
+#define CLEM_CPU_EXECUTE_X         false
+#include "clem_cpu_execute.h"
+
+#define CLEM_CPU_EXECUTE_FN        _cpu_execute_e0_m1_x1
+#define CLEM_CPU_EXECUTE_TRACED    false
+#define CLEM_CPU_EXECUTE_EMULATION false
+#define CLEM_CPU_EXECUTE_M         true
+#define CLEM_CPU_EXECUTE_X         true
+#include "clem_cpu_execute.h"
+
+#define CLEM_CPU_EXECUTE_FN        _cpu_execute_e1_m1_x1
+#define CLEM_CPU_EXECUTE_TRACED    false
+#define CLEM_CPU_EXECUTE_EMULATION true
+#define CLEM_CPU_EXECUTE_M         true
+#define CLEM_CPU_EXECUTE_X         true
+#include "clem_cpu_execute.h"
+
+#define CLEM_CPU_EXECUTE_FN        _cpu_execute_traced
+#define CLEM_CPU_EXECUTE_TRACED    true
+#define CLEM_CPU_EXECUTE_EMULATION cpu->pins.emulation
+#define CLEM_CPU_EXECUTE_M         ((cpu->regs.P & kClemensCPUStatus_MemoryAccumulator) != 0)
+#define CLEM_CPU_EXECUTE_X         ((cpu->regs.P & kClemensCPUStatus_Index) != 0)
+#include "clem_cpu_execute.h"
+
+#define CLEM_CPU_EXECUTE_ENTRY(_e_, _m_, _x_) &_cpu_execute_e##_e_##_m##_m_##_x##_x_,
+
+typedef bool (*ClemensCPUExecuteFn)(struct Clemens65C816 *, ClemensMachine *, clem_clocks_time_t,
+                                    unsigned *);
+
+static const ClemensCPUExecuteFn s_cpu_execute_modes[CLEM_CPU_EXECUTE_MODE_COUNT] = {
+    CLEM_CPU_EXECUTE_MODES(CLEM_CPU_EXECUTE_ENTRY)};
+
 void cpu_execute(struct Clemens65C816 *cpu, ClemensMachine *clem) {
-    uint16_t tmp_addr;
-    uint16_t tmp_eaddr;
-    uint16_t tmp_value;
-    uint16_t tmp_pc;
-    uint8_t tmp_data;
-    uint8_t tmp_bnk0;
-    uint8_t tmp_bnk1;
-    uint8_t IR;
-
-    struct ClemensInstruction opc_inst;
-    uint16_t opc_addr;
-    uint8_t opc_pbr;
+    if (clem->debug_flags) {
+        _cpu_execute_traced(cpu, clem, 0, NULL);
+        return;
+    }
+    (*s_cpu_execute_modes[_cpu_execute_mode_index(cpu)])(cpu, clem, 0, NULL);
+}
 
-    uint8_t carry;
-    bool m_status;
-    bool x_status;
-    bool zero_flag;
-    bool overflow_flag;
-    bool neg_flag;
+void clemens_emulate_cpu(ClemensMachine *clem) {
+    struct Clemens65C816 *cpu = &clem->cpu;
 
-    assert(cpu->state_type == kClemensCPUStateType_Execute);
-    /*
-        Execute all cycles of an instruction here
-    */
-    tmp_pc = cpu->regs.PC;
-    opc_pbr = cpu->regs.PBR;
-    opc_addr = tmp_pc;
-    opc_inst.cycles_spent = cpu->cycles_spent;
-
-    //  TODO: Okay, we enter native mode but PBR is still 0x00 though we are
-    //        reading code from ROM.  research what to do during the switch to
-    //        native mode!   do the I/O memory registers still tell us to read
-    //        from ROM though we are at PBR bank 0x00?  Or should PBR change to
-    //        0xff?
-    clem_read(clem, &cpu->regs.IR, tmp_pc++, cpu->regs.PBR, CLEM_MEM_FLAG_OPCODE_FETCH);
-    IR = cpu->regs.IR;
-    //  This define may be overwritten by a non simple instruction
-    _opcode_instruction_define_simple(&opc_inst, IR);
-
-    m_status = (cpu->regs.P & kClemensCPUStatus_MemoryAccumulator) != 0;
-    x_status = (cpu->regs.P & kClemensCPUStatus_Index) != 0;
-    carry = (cpu->regs.P & kClemensCPUStatus_Carry) != 0;
-    zero_flag = (cpu->regs.P & kClemensCPUStatus_Zero) != 0;
-
-    switch (IR) {
-    //
-    // Start ADC
-    case CLEM_OPC_ADC_IMM:
-        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, m_status);
-        break;
-    case CLEM_OPC_ADC_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_ADC_ABSL:
-        //  TODO: emulation mode
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_ADC_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem,  &tmp_value, tmp_addr, 0x00, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ADC_DP_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ADC_DP_INDIRECTL:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ADC_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    m_status, x_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_ADC_ABSL_IDX:
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
-                                    x_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_ADC_ABS_IDY: // $addr + Y
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_ADC_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ADC_DP_IDX_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO for (d, X)
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
+    clem->dev_debug.watch_hit = 0;
+
+    if (!cpu->pins.resbIn) {
+        /*  the reset interrupt overrides any other state
+            start in emulation mode, 65C02 stack, regs, etc.
+        */
+        if (cpu->state_type != kClemensCPUStateType_Reset) {
+            cpu->state_type = kClemensCPUStateType_Reset;
+
+            cpu->regs.D = 0x0000;
+            cpu->regs.DBR = 0x00;
+            cpu->regs.PBR = 0x00;
+            cpu->regs.S &= 0x00ff;
+            cpu->regs.S |= 0x0100;
+            cpu->regs.X &= 0x00ff;
+            cpu->regs.Y &= 0x00ff;
+
+            cpu->regs.P = cpu->regs.P & ~(kClemensCPUStatus_MemoryAccumulator |
+                                          kClemensCPUStatus_Index | kClemensCPUStatus_Decimal |
+                                          kClemensCPUStatus_IRQDisable | kClemensCPUStatus_Carry);
+            cpu->regs.P |= (kClemensCPUStatus_MemoryAccumulator | kClemensCPUStatus_Index |
+                            kClemensCPUStatus_IRQDisable);
+            cpu->pins.emulation = true;
+            cpu->pins.readyOut = true;
+            cpu->enabled = true;
+            clem_debug_reset(&clem->dev_debug);
+
+            CLEM_LOG("Machine RESB LO");
+
+            _clem_cycle(clem);
         }
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ADC_DP_INDIRECT_IDY:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        _clem_cycle(clem);
+        if (clem->resb_counter > 0) {
+            if (--clem->resb_counter <= 0) {
+                cpu->pins.resbIn = true;
+                CLEM_LOG("Machine RESB HI");
+            }
         }
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ADC_DP_INDIRECTL_IDY:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
-                                    x_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
+        // Clocks_spent set to ZERO!  All MMIO should follow suit now that reset cycle
+        // is complete.  Applications should account for this change in timestamp
+        _clem_timespec_reset(&clem->tspec);
+        return;
+    }
+    //  RESB high during reset invokes our interrupt microcode
+    if (!cpu->enabled)
+        return;
+
+    // CLEM_I_PRINT_STATS(clem);
+
+    if (cpu->state_type == kClemensCPUStateType_Reset) {
+        uint16_t tmp_addr;
+        uint16_t tmp_value;
+        uint8_t tmp_data;
+        uint8_t tmp_datahi;
+
+        clem_read(clem, &tmp_data, cpu->regs.S, 0x00, CLEM_MEM_FLAG_DATA);
+        tmp_addr = cpu->regs.S - 1;
+        if (cpu->pins.emulation) {
+            tmp_addr = CLEM_UTIL_set16_lo(cpu->regs.S, tmp_addr);
         }
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ADC_STACK_REL:
-        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
+        clem_read(clem, &tmp_datahi, tmp_addr, 0x00, CLEM_MEM_FLAG_DATA);
+        _cpu_sp_dec2(cpu);
+        clem_read(clem, &tmp_data, cpu->regs.S, 0x00, CLEM_MEM_FLAG_DATA);
+        _cpu_sp_dec(cpu);
+
+        // vector pull low signal while the PC is being loaded
+        cpu->regs.PC = _clem_read_interrupt_vector(clem, CLEM_6502_RESET_VECTOR_LO_ADDR,
+                                                   CLEM_6502_RESET_VECTOR_HI_ADDR);
+        cpu->state_type = kClemensCPUStateType_Execute;
+        return;
+    } else if (cpu->state_type == kClemensCPUStateType_IRQ ||
+               cpu->state_type == kClemensCPUStateType_NMI) {
+        uint8_t tmp_data;
+        uint8_t tmp_datahi;
+        uint16_t vlo, vhi;
+        if (cpu->pins.emulation) {
+            vlo = cpu->state_type == kClemensCPUStateType_NMI ? CLEM_6502_NMI_VECTOR_LO_ADDR
+                                                              : CLEM_6502_IRQBRK_VECTOR_LO_ADDR;
+            vhi = cpu->state_type == kClemensCPUStateType_NMI ? CLEM_6502_NMI_VECTOR_HI_ADDR
+                                                              : CLEM_6502_IRQBRK_VECTOR_HI_ADDR;
         } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
+            vlo = cpu->state_type == kClemensCPUStateType_NMI ? CLEM_65816_NMI_VECTOR_LO_ADDR
+                                                              : CLEM_65816_IRQB_VECTOR_LO_ADDR;
+            vhi = cpu->state_type == kClemensCPUStateType_NMI ? CLEM_65816_NMI_VECTOR_LO_ADDR
+                                                              : CLEM_65816_IRQB_VECTOR_HI_ADDR;
         }
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    case CLEM_OPC_ADC_STACK_REL_INDIRECT_IDY:
-        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_adc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_adc_bcd(cpu, tmp_value, m_status);
+
+        /* +2 cycles of 'internal ops'
+           +3/4 cycles for stack operations
+            2 cycles vector pull to PC
+        */
+        if (!cpu->pins.readyOut) {
+            CLEM_LOG("IRQ triggered after a likely WAI");
+            cpu->pins.readyOut = true;
         }
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    //  End ADC
-    //
-    //  Start AND
-    case CLEM_OPC_AND_IMM:
-        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, m_status);
-        break;
-    case CLEM_OPC_AND_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_AND_ABSL:
-        //  TODO: emulation mode
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_AND_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_AND_DP_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_AND_DP_INDIRECTL:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_AND_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_AND_ABSL_IDX:
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
-                                    x_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_AND_ABS_IDY: // $addr + Y
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_AND_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_AND_DP_IDX_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO for (d, X)
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_AND_DP_INDIRECT_IDY:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_AND_DP_INDIRECTL_IDY:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
-                                    x_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_AND_STACK_REL:
-        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    case CLEM_OPC_AND_STACK_REL_INDIRECT_IDY:
-        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_and(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    //  End ADC
-    //
-    //  Start ASL
-    case CLEM_OPC_ASL_A:
-        _cpu_asl(cpu, &cpu->regs.A, m_status);
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_ASL_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_asl(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_ASL_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_asl(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ASL_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_cycle(clem);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_asl(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_indexed_816(clem, tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
-                                x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_ASL_ABS_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_asl(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    //  End ASL
-    //
-    //  Start BIT
-    case CLEM_OPC_BIT_IMM:
-        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
-        _cpu_bit_imm(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, m_status);
-        break;
-    case CLEM_OPC_BIT_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_bit(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_BIT_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_bit(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_BIT_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_bit(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_BIT_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_bit(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    //  End BIT
-    //
-    //  Start Branch
+        _clem_cycle_2(clem);
+        _clem_irq_brk_setup(clem, &cpu->regs.PBR, &cpu->regs.PC, vlo, vhi, false);
+        cpu->state_type = kClemensCPUStateType_Execute;
+
+        return;
+    }
+    if (!cpu->pins.readyOut) {
+        _clem_wait(clem);
+        return;
+    }
+    clem->dev_debug.pc = cpu->regs.PC;
+    clem->dev_debug.pbr = cpu->regs.PBR;
+    cpu_execute(cpu, clem);
+}
+
+//  Loops closed by a backward branch within this many bytes are idle loop
+//  candidates.  The visit limit bounds how long we wait for the PHI0 phase to
+//  line up with the anchor.
+#define CLEM_IDLE_LOOP_BRANCH_LIMIT 64
+#define CLEM_IDLE_LOOP_VISIT_LIMIT  130
+
+static bool _clem_is_relative_branch(uint8_t ir) {
+    switch (ir) {
     case CLEM_OPC_BCC:
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        _clem_branch(clem, &tmp_pc, tmp_data, !carry);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, false);
-        break;
     case CLEM_OPC_BCS:
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        _clem_branch(clem, &tmp_pc, tmp_data, carry);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, false);
-        break;
     case CLEM_OPC_BEQ:
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        _clem_branch(clem, &tmp_pc, tmp_data, zero_flag);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, false);
-        break;
     case CLEM_OPC_BMI:
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        _clem_branch(clem, &tmp_pc, tmp_data, cpu->regs.P & kClemensCPUStatus_Negative);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, false);
-        break;
     case CLEM_OPC_BNE:
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        _clem_branch(clem, &tmp_pc, tmp_data, !zero_flag);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, false);
-        break;
     case CLEM_OPC_BPL:
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        _clem_branch(clem, &tmp_pc, tmp_data, !(cpu->regs.P & kClemensCPUStatus_Negative));
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, false);
-        break;
     case CLEM_OPC_BRA:
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        _clem_branch(clem, &tmp_pc, tmp_data, true);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, false);
-        break;
-    case CLEM_OPC_BRL:
-        _clem_read_pba_16(clem, &tmp_value, &tmp_pc);
-        tmp_addr = tmp_pc + (int16_t)tmp_value;
-        _clem_cycle(clem);
-        tmp_pc = tmp_addr;
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, false);
-        break;
     case CLEM_OPC_BVC:
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        _clem_branch(clem, &tmp_pc, tmp_data, !(cpu->regs.P & kClemensCPUStatus_Overflow));
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, false);
-        break;
     case CLEM_OPC_BVS:
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        _clem_branch(clem, &tmp_pc, tmp_data, cpu->regs.P & kClemensCPUStatus_Overflow);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, false);
-        break;
-    //  End Branch
-    //
-    case CLEM_OPC_CLC:
-        cpu->regs.P &= ~kClemensCPUStatus_Carry;
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_CLD:
-        cpu->regs.P &= ~kClemensCPUStatus_Decimal;
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_CLI:
-        cpu->regs.P &= ~kClemensCPUStatus_IRQDisable;
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_CLV:
-        cpu->regs.P &= ~kClemensCPUStatus_Overflow;
-        _clem_cycle(clem);
-        break;
-    //
-    //  Start CMP
-    case CLEM_OPC_CMP_IMM:
-        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, m_status);
-        break;
-    case CLEM_OPC_CMP_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_CMP_ABSL:
-        //  TODO: emulation mode
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_CMP_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_CMP_DP_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_CMP_DP_INDIRECTL:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_CMP_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_CMP_ABSL_IDX:
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
-                                    x_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_CMP_ABS_IDY: // $addr + Y
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_CMP_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_CMP_DP_IDX_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO for (d, X)
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_CMP_DP_INDIRECT_IDY:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_CMP_DP_INDIRECTL_IDY:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
-                                    x_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_CMP_STACK_REL:
-        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    case CLEM_OPC_CMP_STACK_REL_INDIRECT_IDY:
-        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_cmp(cpu, cpu->regs.A, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    //  End CMP
-    //
-    case CLEM_OPC_CPX_IMM:
-        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, x_status);
-        _cpu_cmp(cpu, cpu->regs.X, tmp_value, x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, x_status);
-        break;
-    case CLEM_OPC_CPX_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, x_status);
-        _cpu_cmp(cpu, cpu->regs.X, tmp_value, x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, x_status);
-        break;
-    case CLEM_OPC_CPX_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, x_status);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, x_status);
-        _cpu_cmp(cpu, cpu->regs.X, tmp_value, x_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_CPY_IMM:
-        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, x_status);
-        _cpu_cmp(cpu, cpu->regs.Y, tmp_value, x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, x_status);
-        break;
-    case CLEM_OPC_CPY_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, x_status);
-        _cpu_cmp(cpu, cpu->regs.Y, tmp_value, x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, x_status);
-        break;
-    case CLEM_OPC_CPY_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, x_status);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, x_status);
-        _cpu_cmp(cpu, cpu->regs.Y, tmp_value, x_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    //
-    //  Start DEC
-    case CLEM_OPC_DEC_A:
-        _cpu_dec(cpu, &cpu->regs.A, m_status);
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_DEC_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_dec(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_DEC_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_dec(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_DEC_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_cycle(clem);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_dec(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_indexed_816(clem, tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
-                                x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_DEC_ABS_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_dec(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    //  End DEC
-    //
-    case CLEM_OPC_DEX:
-        tmp_value = cpu->regs.X - 1;
-        if (x_status) {
-            cpu->regs.X = CLEM_UTIL_set16_lo(cpu->regs.X, tmp_value);
-            _cpu_p_flags_n_z_data(cpu, (uint8_t)tmp_value);
-        } else {
-            cpu->regs.X = tmp_value;
-            _cpu_p_flags_n_z_data_16(cpu, tmp_value);
-        }
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_DEY:
-        tmp_value = cpu->regs.Y - 1;
-        if (x_status) {
-            cpu->regs.Y = CLEM_UTIL_set16_lo(cpu->regs.Y, tmp_value);
-            _cpu_p_flags_n_z_data(cpu, (uint8_t)tmp_value);
-        } else {
-            cpu->regs.Y = tmp_value;
-            _cpu_p_flags_n_z_data_16(cpu, tmp_value);
-        }
-        _clem_cycle(clem);
-        break;
-    //
-    //  Start EOR
-    case CLEM_OPC_EOR_IMM:
-        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, m_status);
-        break;
-    case CLEM_OPC_EOR_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_EOR_ABSL:
-        //  TODO: emulation mode
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_EOR_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_EOR_DP_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_EOR_DP_INDIRECTL:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_EOR_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_EOR_ABSL_IDX:
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
-                                    x_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_EOR_ABS_IDY: // $addr + Y
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_EOR_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_EOR_DP_IDX_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO for (d, X)
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_EOR_DP_INDIRECT_IDY:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_EOR_DP_INDIRECTL_IDY:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
-                                    x_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_EOR_STACK_REL:
-        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    case CLEM_OPC_EOR_STACK_REL_INDIRECT_IDY:
-        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_eor(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    //  End EOR
-    //
-    //  Start INC
-    case CLEM_OPC_INC_A:
-        _cpu_inc(cpu, &cpu->regs.A, m_status);
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_INC_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_inc(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_INC_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_inc(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_INC_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_cycle(clem);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_inc(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_indexed_816(clem, tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
-                                x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_INC_ABS_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_inc(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    //  End INC
-    //
-    case CLEM_OPC_INX:
-        tmp_value = cpu->regs.X + 1;
-        if (x_status) {
-            cpu->regs.X = CLEM_UTIL_set16_lo(cpu->regs.X, tmp_value);
-            _cpu_p_flags_n_z_data(cpu, (uint8_t)tmp_value);
-        } else {
-            cpu->regs.X = tmp_value;
-            _cpu_p_flags_n_z_data_16(cpu, tmp_value);
-        }
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_INY:
-        tmp_value = cpu->regs.Y + 1;
-        if (x_status) {
-            cpu->regs.Y = CLEM_UTIL_set16_lo(cpu->regs.Y, tmp_value);
-            _cpu_p_flags_n_z_data(cpu, (uint8_t)tmp_value);
-        } else {
-            cpu->regs.Y = tmp_value;
-            _cpu_p_flags_n_z_data_16(cpu, tmp_value);
-        }
-        _clem_cycle(clem);
-        break;
-    //
-    //  Start JMP
-    case CLEM_OPC_JMP_ABS:
-        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
-        tmp_pc = tmp_addr;
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_JMP_INDIRECT:
-        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
-        _clem_read_16_wrap(clem, &tmp_eaddr, tmp_addr, 0x00, CLEM_MEM_FLAG_DATA);
-        tmp_pc = tmp_eaddr;
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_JMP_INDIRECT_IDX:
-        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
-        if (x_status) {
-            tmp_eaddr = tmp_addr + (cpu->regs.X & 0x00ff);
-        } else {
-            tmp_eaddr = tmp_addr + cpu->regs.X;
-        }
-        _clem_cycle(clem);
-        _clem_read_16_wrap(clem, &tmp_pc, tmp_eaddr, cpu->regs.PBR, CLEM_MEM_FLAG_DATA);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, x_status);
-        break;
-    case CLEM_OPC_JMP_ABSL:
-        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
-        _clem_read_pba(clem, &tmp_bnk0, &tmp_pc);
-        tmp_pc = tmp_addr;
-        cpu->regs.PBR = tmp_bnk0;
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_JMP_ABSL_INDIRECT:
-        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
-        _clem_read_16_wrap(clem, &tmp_eaddr, tmp_addr, 0x00, CLEM_MEM_FLAG_DATA);
-        clem_read(clem, &tmp_bnk0, tmp_addr + 2, 0x00, CLEM_MEM_FLAG_DATA);
-        tmp_pc = tmp_eaddr;
-        cpu->regs.PBR = tmp_bnk0;
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    //  End JMP
-    //
-    //  Start LDA
-    case CLEM_OPC_LDA_IMM:
-        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, m_status);
-        break;
-    case CLEM_OPC_LDA_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_LDA_ABSL:
-        //  TODO: emulation mode
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_LDA_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_LDA_DP_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_LDA_DP_INDIRECTL:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_LDA_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_LDA_ABSL_IDX:
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
-                                    x_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_LDA_ABS_IDY: // $addr + Y
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_LDA_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_LDA_DP_IDX_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO for (d, X)
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_LDA_DP_INDIRECT_IDY:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_LDA_DP_INDIRECTL_IDY:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
-                                    x_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_LDA_STACK_REL:
-        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    case CLEM_OPC_LDA_STACK_REL_INDIRECT_IDY:
-        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_lda(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    //  End LDA
-    //
-    case CLEM_OPC_LDX_IMM:
-        _clem_read_pba_816(clem, &tmp_value, &tmp_pc, x_status);
-        _cpu_ldxy(cpu, &cpu->regs.X, tmp_value, x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, x_status);
-        break;
-    case CLEM_OPC_LDX_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, x_status);
-        _cpu_ldxy(cpu, &cpu->regs.X, tmp_value, x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, x_status);
-        break;
-    case CLEM_OPC_LDX_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, x_status);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, x_status);
-        _cpu_ldxy(cpu, &cpu->regs.X, tmp_value, x_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_LDX_ABS_IDY:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    x_status, x_status);
-        _cpu_ldxy(cpu, &cpu->regs.X, tmp_value, x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, x_status);
-        break;
-    case CLEM_OPC_LDX_DP_IDY:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.Y, x_status);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, x_status);
-        _cpu_ldxy(cpu, &cpu->regs.X, tmp_value, x_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_LDY_IMM:
-        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, x_status);
-        _cpu_ldxy(cpu, &cpu->regs.Y, tmp_value, x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, x_status);
-        break;
-    case CLEM_OPC_LDY_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, x_status);
-        _cpu_ldxy(cpu, &cpu->regs.Y, tmp_value, x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, x_status);
-        break;
-    case CLEM_OPC_LDY_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, x_status);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, x_status);
-        _cpu_ldxy(cpu, &cpu->regs.Y, tmp_value, x_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_LDY_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    x_status, x_status);
-        _cpu_ldxy(cpu, &cpu->regs.Y, tmp_value, x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, x_status);
-        break;
-    case CLEM_OPC_LDY_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, x_status);
-        _cpu_ldxy(cpu, &cpu->regs.Y, tmp_value, x_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    //
-    //  Start ASL
-    case CLEM_OPC_LSR_A:
-        _cpu_lsr(cpu, &cpu->regs.A, m_status);
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_LSR_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_lsr(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_LSR_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_lsr(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_LSR_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_cycle(clem);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_lsr(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_indexed_816(clem, tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
-                                x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_LSR_ABS_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_lsr(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    //  End LSR
-    //
-    case CLEM_OPC_MVN:
-        //  copy X -> Y, incrementing X, Y, decrement C
-        _clem_read_pba(clem, &tmp_bnk1, &tmp_pc); // dest
-        _clem_read_pba(clem, &tmp_bnk0, &tmp_pc); // src
-        clem_read(clem, &tmp_data, cpu->regs.X, tmp_bnk0, CLEM_MEM_FLAG_DATA);
-        clem_write(clem, tmp_data, cpu->regs.Y, tmp_bnk1, CLEM_MEM_FLAG_DATA);
-        if (x_status) {
-            cpu->regs.X = CLEM_UTIL_set16_lo(cpu->regs.X, cpu->regs.X + 1);
-            cpu->regs.Y = CLEM_UTIL_set16_lo(cpu->regs.Y, cpu->regs.Y + 1);
-        } else {
-            ++cpu->regs.X;
-            ++cpu->regs.Y;
-        }
-        _clem_cycle_2(clem);
-        --cpu->regs.A;
-        if (cpu->regs.A != 0xffff) {
-            tmp_pc = cpu->regs.PC; // repeat
-        }
-        cpu->regs.DBR = tmp_bnk1;
-        _opcode_instruction_define_mvn(&opc_inst, IR, tmp_bnk1, tmp_bnk0);
-        break;
-    case CLEM_OPC_MVP:
-        //  copy X -> Y, decrementing X, Y, decrement C
-        _clem_read_pba(clem, &tmp_bnk1, &tmp_pc); // dest
-        _clem_read_pba(clem, &tmp_bnk0, &tmp_pc); // src
-        clem_read(clem, &tmp_data, cpu->regs.X, tmp_bnk0, CLEM_MEM_FLAG_DATA);
-        clem_write(clem, tmp_data, cpu->regs.Y, tmp_bnk1, CLEM_MEM_FLAG_DATA);
-        if (x_status) {
-            cpu->regs.X = CLEM_UTIL_set16_lo(cpu->regs.X, cpu->regs.X - 1);
-            cpu->regs.Y = CLEM_UTIL_set16_lo(cpu->regs.Y, cpu->regs.Y - 1);
-        } else {
-            --cpu->regs.X;
-            --cpu->regs.Y;
-        }
-        _clem_cycle_2(clem);
-        --cpu->regs.A;
-        if (cpu->regs.A != 0xffff) {
-            tmp_pc = cpu->regs.PC; // repeat
-        }
-        cpu->regs.DBR = tmp_bnk1;
-        _opcode_instruction_define_mvn(&opc_inst, IR, tmp_bnk1, tmp_bnk0);
-        break;
-    case CLEM_OPC_NOP:
-        _clem_cycle(clem);
-        break;
-    //
-    //  Start ORA
-    case CLEM_OPC_ORA_IMM:
-        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, m_status);
-        break;
-    case CLEM_OPC_ORA_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_ORA_ABSL:
-        //  TODO: emulation mode
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_ORA_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ORA_DP_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ORA_DP_INDIRECTL:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ORA_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_ORA_ABSL_IDX:
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
-                                    x_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_ORA_ABS_IDY: // $addr + Y
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_ORA_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ORA_DP_IDX_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO for (d, X)
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ORA_DP_INDIRECT_IDY:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        /* TODO: timing check for io cycle? */
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ORA_DP_INDIRECTL_IDY:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
-                                    x_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ORA_STACK_REL:
-        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    case CLEM_OPC_ORA_STACK_REL_INDIRECT_IDY:
-        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_ora(cpu, tmp_value, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    //  End ORA
-    //
-    case CLEM_OPC_PEA_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _cpu_sp_dec2(cpu);
-        _clem_write_16_wrap(clem, tmp_addr, cpu->regs.S + 1, 0x00);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_PEI_DP_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _cpu_sp_dec2(cpu);
-        _clem_write_16_wrap(clem, tmp_addr, cpu->regs.S + 1, 0x00);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_PER:
-        _clem_read_pba_16(clem, &tmp_value, &tmp_pc);
-        tmp_addr = tmp_pc + (int16_t)tmp_value;
-        _clem_cycle(clem);
-        _cpu_sp_dec2(cpu);
-        _clem_write_16_wrap(clem, tmp_addr, cpu->regs.S + 1, 0x00);
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, m_status);
-        break;
-    case CLEM_OPC_PHA:
-        _clem_opc_push_reg_816(clem, cpu->regs.A, m_status);
-        break;
-    case CLEM_OPC_PHB:
-        _clem_cycle(clem);
-        clem_write(clem, (uint8_t)cpu->regs.DBR, cpu->regs.S, 0x00, CLEM_MEM_FLAG_DATA);
-        _cpu_sp_dec(cpu);
-        break;
-    case CLEM_OPC_PHD:
-        _clem_cycle(clem);
-        //  65816 quirk - PHD can overrun the valid stack range
-        clem_write(clem, (uint8_t)(cpu->regs.D >> 8), cpu->regs.S, 0x00, CLEM_MEM_FLAG_DATA);
-        clem_write(clem, (uint8_t)(cpu->regs.D), cpu->regs.S - 1, 0x00, CLEM_MEM_FLAG_DATA);
-        _cpu_sp_dec2(cpu);
-        break;
-    case CLEM_OPC_PHK:
-        _clem_cycle(clem);
-        clem_write(clem, (uint8_t)cpu->regs.PBR, cpu->regs.S, 0x00, CLEM_MEM_FLAG_DATA);
-        _cpu_sp_dec(cpu);
-        break;
-    case CLEM_OPC_PHP:
-        _clem_cycle(clem);
-        _clem_opc_push_status(clem, false);
-        break;
-    case CLEM_OPC_PHX:
-        _clem_opc_push_reg_816(clem, cpu->regs.X, x_status);
-        break;
-    case CLEM_OPC_PHY:
-        _clem_opc_push_reg_816(clem, cpu->regs.Y, x_status);
-        break;
-    case CLEM_OPC_PLA:
-        _clem_opc_pull_reg_816(clem, &cpu->regs.A, m_status);
-        _cpu_p_flags_n_z_data_816(cpu, cpu->regs.A, m_status);
-        break;
-    case CLEM_OPC_PLB:
-        _clem_opc_pull_reg_8(clem, &cpu->regs.DBR);
-        _cpu_p_flags_n_z_data(cpu, cpu->regs.DBR);
-        break;
-    case CLEM_OPC_PLD:
-        _clem_cycle_2(clem);
-        _clem_read_16_wrap(clem, &cpu->regs.D, cpu->regs.S + 1, 0x00, CLEM_MEM_FLAG_DATA);
-        _cpu_sp_inc2(cpu);
-        _cpu_p_flags_n_z_data_16(cpu, cpu->regs.D);
-        break;
-    case CLEM_OPC_PLP:
-        // In emulation, the B flag is not restored - it should
-        // instead set x_status to 1? (can we set x_status to 0 in
-        // emulation?)
-        _clem_cycle_2(clem);
-        _clem_opc_pull_status(clem);
-        break;
-    case CLEM_OPC_PLX:
-        _clem_opc_pull_reg_816(clem, &cpu->regs.X, x_status);
-        _cpu_p_flags_n_z_data_816(cpu, cpu->regs.X, x_status);
-        break;
-    case CLEM_OPC_PLY:
-        _clem_opc_pull_reg_816(clem, &cpu->regs.Y, x_status);
-        _cpu_p_flags_n_z_data_816(cpu, cpu->regs.Y, x_status);
-        break;
-    case CLEM_OPC_REP:
-        // Reset Status Bits
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        cpu->regs.P &= (~tmp_data); // all 1 bits are turned OFF in P
-        if (cpu->pins.emulation) {
-            cpu->regs.P |= kClemensCPUStatus_MemoryAccumulator;
-            cpu->regs.P |= kClemensCPUStatus_Index;
-        }
-        _cpu_p_flags_apply_m_x(cpu);
-        _clem_cycle(clem);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, false);
-        break;
-    //
-    //  Start ROL
-    case CLEM_OPC_ROL_A:
-        _cpu_rol(cpu, &cpu->regs.A, m_status);
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_ROL_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_rol(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_ROL_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_rol(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ROL_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_cycle(clem);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_rol(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_indexed_816(clem, tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
-                                x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_ROL_ABS_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_rol(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    //  End ROL
-    //
-    //  Start ROR
-    case CLEM_OPC_ROR_A:
-        _cpu_ror(cpu, &cpu->regs.A, m_status);
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_ROR_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_ror(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_ROR_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_ror(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_ROR_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_cycle(clem);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    m_status, x_status);
-        _cpu_ror(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_indexed_816(clem, tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
-                                x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_ROR_ABS_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_ror(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    //  End ROR
-    //
-    // Start SBC
-    case CLEM_OPC_SBC_IMM:
-        _clem_read_pba_mode_imm_816(clem, &tmp_value, &tmp_pc, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, m_status);
-        break;
-    case CLEM_OPC_SBC_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_SBC_ABSL:
-        //  TODO: emulation mode
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_SBC_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_SBC_DP_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_SBC_DP_INDIRECTL:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, tmp_bnk0, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_SBC_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, cpu->regs.DBR,
-                                    m_status, x_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_SBC_ABSL_IDX:
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
-                                    x_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_SBC_ABS_IDY: // $addr + Y
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_SBC_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_SBC_DP_IDX_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO for (d, X)
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_SBC_DP_INDIRECT_IDY:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        /* TODO: timing io cycle check? */
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_SBC_DP_INDIRECTL_IDY:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
-                                    x_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_SBC_STACK_REL:
-        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    case CLEM_OPC_SBC_STACK_REL_INDIRECT_IDY:
-        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_read_data_indexed_816(clem, &tmp_value, tmp_addr, cpu->regs.Y, cpu->regs.DBR,
-                                    m_status, x_status);
-        if (!(cpu->regs.P & kClemensCPUStatus_Decimal)) {
-            _cpu_sbc(cpu, tmp_value, m_status);
-        } else {
-            _cpu_sbc_bcd(cpu, tmp_value, m_status);
-        }
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    //  End ADC
-    //
-    case CLEM_OPC_SEC:
-        cpu->regs.P |= kClemensCPUStatus_Carry;
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_SED:
-        cpu->regs.P |= kClemensCPUStatus_Decimal;
-        _clem_cycle(clem);
-
-        break;
-    case CLEM_OPC_SEI:
-        cpu->regs.P |= kClemensCPUStatus_IRQDisable;
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_SEP:
-        // Reset Status Bits
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        if (cpu->pins.emulation) {
-            tmp_data |= kClemensCPUStatus_MemoryAccumulator;
-            tmp_data |= kClemensCPUStatus_Index;
-        }
-        cpu->regs.P |= tmp_data; // all 1 bits are turned ON in P
-        _cpu_p_flags_apply_m_x(cpu);
-        _clem_cycle(clem);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, false);
-        break;
-    //
-    //  Start STA
-    case CLEM_OPC_STA_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_write_816(clem, cpu->regs.A, tmp_addr, cpu->regs.DBR, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_STA_ABSL:
-        //  absolute long read
-        //  TODO: what about emulation mode?
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_write_816(clem, cpu->regs.A, tmp_addr, tmp_bnk0, m_status);
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_STA_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_write_816(clem, cpu->regs.A, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_STA_DP_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_write_816(clem, cpu->regs.A, tmp_addr, cpu->regs.DBR, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_STA_DP_INDIRECTL:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_write_816(clem, cpu->regs.A, tmp_addr, tmp_bnk0, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_STA_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_cycle(clem);
-        //_clem_read_indexed_null_io(clem, tmp_addr, cpu->regs.X, cpu->regs.DBR);
-        _clem_write_indexed_816(clem, cpu->regs.A, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
-                                x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_STA_ABSL_IDX:
-        _clem_read_pba_mode_absl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc);
-        _clem_write_indexed_816(clem, cpu->regs.A, tmp_addr, cpu->regs.X, tmp_bnk0, m_status,
-                                x_status);
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        break;
-    case CLEM_OPC_STA_ABS_IDY: // $addr + Y
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_cycle(clem); // extra IO
-        _clem_write_indexed_816(clem, cpu->regs.A, tmp_addr, cpu->regs.Y, cpu->regs.DBR, m_status,
-                                x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_STA_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_write_816(clem, cpu->regs.A, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_STA_DP_IDX_INDIRECT:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO for (d, X)
-        _clem_write_816(clem, cpu->regs.A, tmp_addr, cpu->regs.DBR, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_STA_DP_INDIRECT_IDY:
-        _clem_read_pba_mode_dp_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-
-        _clem_io_read_cycle(clem, tmp_addr, cpu->regs.Y, cpu->regs.DBR);
-        _clem_write_indexed_816(clem, cpu->regs.A, tmp_addr, cpu->regs.Y, cpu->regs.DBR, m_status,
-                                x_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_STA_DP_INDIRECTL_IDY:
-        _clem_read_pba_mode_dp_indirectl(clem, &tmp_addr, &tmp_bnk0, &tmp_pc, &tmp_data, 0, false);
-        _clem_write_indexed_816(clem, cpu->regs.A, tmp_addr, cpu->regs.Y, tmp_bnk0, m_status,
-                                x_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_STA_STACK_REL:
-        _clem_read_pba_mode_stack_rel(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_write_816(clem, cpu->regs.A, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    case CLEM_OPC_STA_STACK_REL_INDIRECT_IDY:
-        _clem_read_pba_mode_stack_rel_indirect(clem, &tmp_addr, &tmp_pc, &tmp_data);
-        _clem_write_indexed_816(clem, cpu->regs.A, tmp_addr, cpu->regs.Y, cpu->regs.DBR, m_status,
-                                x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_data, m_status);
-        break;
-    //  End STA
-    //
-    //  Start STX,STY,STZ
-    case CLEM_OPC_STX_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_write_816(clem, cpu->regs.X, tmp_addr, cpu->regs.DBR, x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, x_status);
-        break;
-    case CLEM_OPC_STX_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, x_status);
-        _clem_write_816(clem, cpu->regs.X, tmp_addr, 0x00, x_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_STX_DP_IDY:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.Y, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_write_816(clem, cpu->regs.X, tmp_addr, 0x00, x_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_STY_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_write_816(clem, cpu->regs.Y, tmp_addr, cpu->regs.DBR, x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, x_status);
-        break;
-    case CLEM_OPC_STY_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, x_status);
-        _clem_write_816(clem, cpu->regs.Y, tmp_addr, 0x00, x_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_STY_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_write_816(clem, cpu->regs.Y, tmp_addr, 0x00, x_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_STZ_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_write_816(clem, 0x0000, tmp_addr, cpu->regs.DBR, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_STZ_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_write_816(clem, 0x0000, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_STZ_ABS_IDX:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_cycle(clem);
-        _clem_write_indexed_816(clem, 0x0000, tmp_addr, cpu->regs.X, cpu->regs.DBR, m_status,
-                                x_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_STZ_DP_IDX:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, cpu->regs.X, x_status);
-        _clem_cycle(clem); // extra IO cycle for d,x
-        _clem_write_816(clem, 0x0000, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    //  End STX,STY,STZ
-    //
-    //  Start Transfer
-    case CLEM_OPC_TAX:
-        if (x_status) {
-            cpu->regs.X = CLEM_UTIL_set16_lo(cpu->regs.X, cpu->regs.A);
-            _cpu_p_flags_n_z_data(cpu, (uint8_t)cpu->regs.X);
-        } else {
-            cpu->regs.X = cpu->regs.A;
-            _cpu_p_flags_n_z_data_16(cpu, cpu->regs.X);
-        }
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_TAY:
-        if (x_status) {
-            cpu->regs.Y = CLEM_UTIL_set16_lo(cpu->regs.Y, cpu->regs.A);
-            _cpu_p_flags_n_z_data(cpu, (uint8_t)cpu->regs.Y);
-        } else {
-            cpu->regs.Y = cpu->regs.A;
-            _cpu_p_flags_n_z_data_16(cpu, cpu->regs.Y);
-        }
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_TCD:
-        cpu->regs.D = cpu->regs.A;
-        _cpu_p_flags_n_z_data_16(cpu, cpu->regs.D);
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_TDC:
-        cpu->regs.A = cpu->regs.D;
-        _cpu_p_flags_n_z_data_16(cpu, cpu->regs.A);
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_TCS:
-        if (cpu->pins.emulation) {
-            cpu->regs.S = CLEM_UTIL_set16_lo(cpu->regs.S, cpu->regs.A);
-        } else {
-            cpu->regs.S = cpu->regs.A;
-        }
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_TSC:
-        cpu->regs.A = cpu->regs.S;
-        _cpu_p_flags_n_z_data_16(cpu, cpu->regs.A);
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_TSX:
-        if (!cpu->pins.emulation && !x_status) {
-            cpu->regs.X = cpu->regs.S;
-            _cpu_p_flags_n_z_data_16(cpu, cpu->regs.X);
-        } else if (x_status) {
-            cpu->regs.X = CLEM_UTIL_set16_lo(cpu->regs.X, cpu->regs.S);
-            _cpu_p_flags_n_z_data(cpu, (uint8_t)cpu->regs.X);
-        }
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_TXA:
-        if (m_status) {
-            cpu->regs.A = CLEM_UTIL_set16_lo(cpu->regs.A, cpu->regs.X);
-            _cpu_p_flags_n_z_data(cpu, (uint8_t)cpu->regs.A);
-        } else {
-            cpu->regs.A = x_status ? (uint8_t)cpu->regs.X : cpu->regs.X;
-            _cpu_p_flags_n_z_data_16(cpu, cpu->regs.A);
-        }
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_TXS:
-        //  no n,z flags set
-        if (cpu->pins.emulation) {
-            cpu->regs.S = CLEM_UTIL_set16_lo(cpu->regs.S, cpu->regs.X);
-        } else if (x_status) {
-            cpu->regs.S = cpu->regs.X & 0x00ff;
-        } else {
-            cpu->regs.S = cpu->regs.X;
-        }
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_TXY:
-        if (x_status) {
-            cpu->regs.Y = CLEM_UTIL_set16_lo(cpu->regs.Y, cpu->regs.X);
-            _cpu_p_flags_n_z_data(cpu, (uint8_t)cpu->regs.Y);
-        } else {
-            cpu->regs.Y = cpu->regs.X;
-            _cpu_p_flags_n_z_data_16(cpu, cpu->regs.Y);
-        }
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_TYA:
-        if (m_status) {
-            cpu->regs.A = CLEM_UTIL_set16_lo(cpu->regs.A, cpu->regs.Y);
-            _cpu_p_flags_n_z_data(cpu, (uint8_t)cpu->regs.A);
-        } else {
-            cpu->regs.A = x_status ? (uint8_t)cpu->regs.Y : cpu->regs.Y;
-            _cpu_p_flags_n_z_data_16(cpu, cpu->regs.A);
-        }
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_TYX:
-        if (x_status) {
-            cpu->regs.X = CLEM_UTIL_set16_lo(cpu->regs.X, cpu->regs.Y);
-            _cpu_p_flags_n_z_data(cpu, (uint8_t)cpu->regs.X);
-        } else {
-            cpu->regs.X = cpu->regs.Y;
-            _cpu_p_flags_n_z_data_16(cpu, cpu->regs.X);
-        }
-        _clem_cycle(clem);
-        break;
-    //  End Transfer
-    //
-    case CLEM_OPC_TRB_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_trb(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_TRB_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_trb(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_TSB_ABS:
-        _clem_read_pba_mode_abs(clem, &tmp_addr, &tmp_pc);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _cpu_tsb(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, cpu->regs.DBR, m_status);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, m_status);
-        break;
-    case CLEM_OPC_TSB_DP:
-        _clem_read_pba_mode_dp(clem, &tmp_addr, &tmp_pc, &tmp_data, 0, false);
-        _clem_read_data_816(clem, &tmp_value, tmp_addr, 0x00, m_status);
-        _cpu_tsb(cpu, &tmp_value, m_status);
-        _clem_cycle(clem);
-        _clem_write_816(clem, tmp_value, tmp_addr, 0x00, m_status);
-        _opcode_instruction_define_dp(&opc_inst, IR, tmp_data);
-        break;
-    case CLEM_OPC_XBA:
-        tmp_value = cpu->regs.A;
-        cpu->regs.A = (tmp_value & 0xff00) >> 8;
-        cpu->regs.A = (tmp_value & 0x00ff) << 8 | cpu->regs.A;
-        _cpu_p_flags_n_z_data(cpu, (uint8_t)(cpu->regs.A & 0x00ff));
-        _clem_cycle_2(clem);
-        break;
-    case CLEM_OPC_XCE:
-        tmp_value = cpu->pins.emulation;
-        cpu->pins.emulation = (cpu->regs.P & kClemensCPUStatus_Carry) != 0;
-        if (tmp_value != cpu->pins.emulation) {
-            cpu->regs.P |= kClemensCPUStatus_Index;
-            cpu->regs.P |= kClemensCPUStatus_MemoryAccumulator;
-            if (tmp_value) {
-                // TODO: log internally
-            } else {
-                // switch to emulation, and emulation stack
-                cpu->regs.S = CLEM_UTIL_set16_lo(0x0100, cpu->regs.S);
-            }
-            _cpu_p_flags_apply_m_x(cpu);
-        }
-        if (tmp_value) {
-            cpu->regs.P |= kClemensCPUStatus_Carry;
-        } else {
-            cpu->regs.P &= ~kClemensCPUStatus_Carry;
-        }
-        _clem_cycle(clem);
-        break;
-    case CLEM_OPC_WDM:
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        //  TODO: add option for wdm custom ops vs NOP
-        //        right now, always a custom op
-        if (tmp_data == 0x01) {
-            // memory dump
-            // byte 0 = pages to print (0-255)
-            // byte 1 = bank
-            // byte 2,3 = adrlo, hi
-            _clem_read_pba(clem, &tmp_data, &tmp_pc);
-            _clem_read_pba(clem, &tmp_bnk0, &tmp_pc);
-            _clem_read_pba(clem, &tmp_bnk1, &tmp_pc);
-            _clem_debug_memory_dump(clem, tmp_bnk1, tmp_bnk0, tmp_data);
-        } else if (tmp_data == 0x02) {
-            //  Instruction with data pushed onto the stack: 
-            //  [type]
-            //  [adrhi]
-            //  [adrlo]
-            //_clem_opc_pull_reg_8(clem,)
-            //  passed to the appropriate handler
-        }
-        break;
-    //  Jump, JSR,
-    case CLEM_OPC_JSR:
-        // Stack [PCH, PCL]
-        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
-        --tmp_pc; // point to last byte in operand
-        _clem_cycle(clem);
-        _clem_opc_push_pc16(clem, tmp_pc);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, false);
-        CLEM_CPU_I_JSR_LOG(cpu, tmp_addr);
-        tmp_pc = tmp_addr; // set next PC to the JSR routine
-        break;
-    case CLEM_OPC_JSR_INDIRECT_IDX:
-        // +2 cycles accounted for by the extra 16-bit read from the index
-        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
-        --tmp_pc; // point to last byte in operand
-        _clem_cycle(clem);
-        _clem_opc_push_pc16(clem, tmp_pc);
-        if (x_status) {
-            tmp_eaddr = tmp_addr + (cpu->regs.X & 0x00ff);
-        } else {
-            tmp_eaddr = tmp_addr + cpu->regs.X;
-        }
-        _clem_read_16_wrap(clem, &tmp_pc, tmp_eaddr, cpu->regs.PBR, CLEM_MEM_FLAG_DATA);
-        CLEM_CPU_I_JSR_LOG(cpu, tmp_eaddr);
-        _opcode_instruction_define(&opc_inst, IR, tmp_addr, x_status);
-        break;
-    case CLEM_OPC_RTS:
-        //  Stack [PCH, PCL]
-        _clem_cycle_2(clem);
-        tmp_value = cpu->regs.S + 1;
-        if (cpu->pins.emulation) {
-            tmp_value = CLEM_UTIL_set16_lo(cpu->regs.S, tmp_value);
-        }
-        clem_read(clem, &tmp_data, tmp_value, 0x00, CLEM_MEM_FLAG_DATA);
-        tmp_addr = tmp_data;
-        ++tmp_value;
-        if (cpu->pins.emulation) {
-            tmp_value = CLEM_UTIL_set16_lo(cpu->regs.S, tmp_value);
-        }
-        clem_read(clem, &tmp_data, tmp_value, 0x00, CLEM_MEM_FLAG_DATA);
-        tmp_addr = ((uint16_t)tmp_data << 8) | tmp_addr;
-        _clem_cycle(clem);
-        _cpu_sp_inc2(cpu);
-        tmp_pc = tmp_addr + 1; //  point to next instruction
-        CLEM_CPU_I_RTS_LOG(cpu, tmp_pc);
-        break;
-    case CLEM_OPC_JSL:
-        // Stack [PBR, PCH, PCL]
-        _clem_read_pba_16(clem, &tmp_addr, &tmp_pc);
-        //  push old PBR
-        clem_write(clem, cpu->regs.PBR, cpu->regs.S, 0x0, CLEM_MEM_FLAG_DATA);
-        _clem_cycle(clem);
-        //  new PBR
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        --tmp_pc; // point to last byte in operand
-        tmp_bnk0 = tmp_data;
-        //  JSL stack overrun will not wrap to 0x1ff (65816 quirk)
-        //  SP will still wrap
-        //  tmp_pc will be tha address of the last operand
-        clem_write(clem, (uint8_t)(tmp_pc >> 8), cpu->regs.S - 1, 0x00, CLEM_MEM_FLAG_DATA);
-        tmp_value = cpu->regs.S - 1;
-        clem_write(clem, (uint8_t)tmp_pc, cpu->regs.S - 2, 0x00, CLEM_MEM_FLAG_DATA);
-        _cpu_sp_dec3(cpu);
-        _opcode_instruction_define_long(&opc_inst, IR, tmp_bnk0, tmp_addr);
-        CLEM_CPU_I_JSL_LOG(cpu, tmp_addr, tmp_bnk0);
-        tmp_pc = tmp_addr; // set next PC to the JSL routine
-        cpu->regs.PBR = tmp_bnk0;
-        break;
-    case CLEM_OPC_RTL:
-        _clem_cycle_2(clem);
-        //  again, 65816 quirk where RTL will read from over the top
-        //  in emulation mode even
-        clem_read(clem, &tmp_data, cpu->regs.S + 1, 0x00, CLEM_MEM_FLAG_DATA);
-        tmp_addr = tmp_data;
-        clem_read(clem, &tmp_data, cpu->regs.S + 2, 0x00, CLEM_MEM_FLAG_DATA);
-        tmp_addr = ((uint16_t)tmp_data << 8) | tmp_addr;
-        clem_read(clem, &tmp_data, cpu->regs.S + 3, 0x00, CLEM_MEM_FLAG_DATA);
-        _cpu_sp_inc3(cpu);
-        tmp_pc = tmp_addr + 1;
-        CLEM_CPU_I_RTL_LOG(cpu, tmp_pc, tmp_data);
-        cpu->regs.PBR = tmp_data;
-        break;
-
-    //  interrupt opcodes (RESET is handled separately)
-    case CLEM_OPC_BRK:
-        //  BRK ignores irq disable
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        CLEM_CPU_I_INTR_LOG(cpu, "BRK");
-        tmp_value = tmp_data;
-        if (cpu->pins.emulation) {
-            _clem_irq_brk_setup(clem, &cpu->regs.PBR, &tmp_pc, CLEM_6502_IRQBRK_VECTOR_LO_ADDR,
-                                CLEM_6502_IRQBRK_VECTOR_HI_ADDR, true);
-
-        } else {
-            _clem_irq_brk_setup(clem, &cpu->regs.PBR, &tmp_pc, CLEM_65816_BRK_VECTOR_LO_ADDR,
-                                CLEM_65816_BRK_VECTOR_HI_ADDR, true);
-        }
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, true);
-        break;
-    case CLEM_OPC_COP:
-        //  ignore irq disable
-        _clem_read_pba(clem, &tmp_data, &tmp_pc);
-        CLEM_CPU_I_INTR_LOG(cpu, "COP");
-        tmp_value = tmp_data;
-        if (cpu->pins.emulation) {
-            _clem_irq_brk_setup(clem, &cpu->regs.PBR, &tmp_pc, CLEM_6502_COP_VECTOR_LO_ADDR,
-                                CLEM_6502_COP_VECTOR_LO_ADDR, true);
-
-        } else {
-            _clem_irq_brk_setup(clem, &cpu->regs.PBR, &tmp_pc, CLEM_65816_COP_VECTOR_LO_ADDR,
-                                CLEM_65816_COP_VECTOR_HI_ADDR, true);
-        }
-        _opcode_instruction_define(&opc_inst, IR, tmp_value, true);
-        break;
-    case CLEM_OPC_RTI:
-        _clem_cycle_2(clem);
-        tmp_pc = _clem_irq_brk_return(clem);
-        break;
-    case CLEM_OPC_WAI:
-        //  the calling application could interpret ReadyOut
-        _clem_cycle_2(clem);
-        cpu->pins.readyOut = false;
-        break;
-    case CLEM_OPC_STP:
-        _clem_cycle_2(clem);
-        cpu->enabled = false;
-        break;
-    default:
-        CLEM_WARN("Unknown IR = %x\n", IR);
-        assert(false);
-        break;
+        return true;
     }
-    cpu->regs.PC = tmp_pc;
+    return false;
+}
 
-    if (clem->debug_flags) {
-        opc_inst.pbr = opc_pbr;
-        opc_inst.addr = opc_addr;
-        opc_inst.cycles_spent = cpu->cycles_spent - opc_inst.cycles_spent;
-        _opcode_print(clem, &opc_inst);
-    }
+static void _clem_idle_loop_anchor(ClemensMachine *clem) {
+    struct ClemensIdleLoop *idle = &clem->idle_loop;
+    idle->regs = clem->cpu.regs;
+    idle->emulation = clem->cpu.pins.emulation;
+    idle->clocks_spent = clem->tspec.clocks_spent;
+    idle->phi0_offset =
+        (clem_clocks_duration_t)(clem->tspec.clocks_next_phi0 - clem->tspec.clocks_spent);
+    idle->phi0_current_step = clem->tspec.phi0_current_step;
+    idle->clocks_step = clem->tspec.clocks_step;
+    idle->mega2_scanline_ctr = clem->tspec.mega2_scanline_ctr;
+    idle->cycles_spent = clem->cpu.cycles_spent;
+    idle->mutation_count = clem->mem.mutation_count;
+    idle->visits = 0;
 }
 
-void clemens_emulate_cpu(ClemensMachine *clem) {
+//  Called after an instruction has executed.  If it was a short backward branch,
+//  the CPU is at the head of a loop.  When the loop head is revisited with the
+//  same registers and PHI0 timing state and nothing was written or read with side
+//  effects in between, every following iteration will be identical until a
+//  device changes state.  Those iterations are skipped by advancing the clock by
+//  whole periods up to the next device event, which leaves the machine exactly
+//  where it would be had the loop run.
+static void _clem_idle_loop_check(ClemensMachine *clem, uint16_t opc_pc, uint8_t opc_pbr,
+                                  clem_clocks_time_t clocks) {
+    struct ClemensIdleLoop *idle = &clem->idle_loop;
     struct Clemens65C816 *cpu = &clem->cpu;
+    clem_clocks_duration_t period;
+    clem_clocks_time_t skip_count;
 
-    if (!cpu->pins.resbIn) {
-        /*  the reset interrupt overrides any other state
-            start in emulation mode, 65C02 stack, regs, etc.
-        */
-        if (cpu->state_type != kClemensCPUStateType_Reset) {
-            cpu->state_type = kClemensCPUStateType_Reset;
-
-            cpu->regs.D = 0x0000;
-            cpu->regs.DBR = 0x00;
-            cpu->regs.PBR = 0x00;
-            cpu->regs.S &= 0x00ff;
-            cpu->regs.S |= 0x0100;
-            cpu->regs.X &= 0x00ff;
-            cpu->regs.Y &= 0x00ff;
-
-            cpu->regs.P = cpu->regs.P & ~(kClemensCPUStatus_MemoryAccumulator |
-                                          kClemensCPUStatus_Index | kClemensCPUStatus_Decimal |
-                                          kClemensCPUStatus_IRQDisable | kClemensCPUStatus_Carry);
-            cpu->regs.P |= (kClemensCPUStatus_MemoryAccumulator | kClemensCPUStatus_Index |
-                            kClemensCPUStatus_IRQDisable);
-            cpu->pins.emulation = true;
-            cpu->pins.readyOut = true;
-            cpu->enabled = true;
-            clem_debug_reset(&clem->dev_debug);
-
-            CLEM_LOG("Machine RESB LO");
-
-            _clem_cycle(clem);
-        }
-        _clem_cycle(clem);
-        if (clem->resb_counter > 0) {
-            if (--clem->resb_counter <= 0) {
-                cpu->pins.resbIn = true;
-                CLEM_LOG("Machine RESB HI");
-            }
-        }
-        // Clocks_spent set to ZERO!  All MMIO should follow suit now that reset cycle
-        // is complete.  Applications should account for this change in timestamp
-        _clem_timespec_reset(&clem->tspec);
+    if (!_clem_is_relative_branch(cpu->regs.IR) || cpu->regs.PBR != opc_pbr ||
+        cpu->regs.PC >= opc_pc || opc_pc - cpu->regs.PC > CLEM_IDLE_LOOP_BRANCH_LIMIT) {
         return;
     }
-    //  RESB high during reset invokes our interrupt microcode
-    if (!cpu->enabled)
+    if (idle->mutation_count != clem->mem.mutation_count || idle->emulation != cpu->pins.emulation ||
+        memcmp(&idle->regs, &cpu->regs, sizeof(cpu->regs)) != 0 ||
+        idle->clocks_step != clem->tspec.clocks_step ||
+        ++idle->visits > CLEM_IDLE_LOOP_VISIT_LIMIT) {
+        _clem_idle_loop_anchor(clem);
         return;
+    }
+    if (idle->phi0_offset !=
+            (clem_clocks_duration_t)(clem->tspec.clocks_next_phi0 - clem->tspec.clocks_spent) ||
+        idle->phi0_current_step != clem->tspec.phi0_current_step) {
+        return;
+    }
+    period = (clem_clocks_duration_t)(clem->tspec.clocks_spent - idle->clocks_spent);
+    if (period == 0 || clocks == CLEM_TIME_NEVER || clocks <= clem->tspec.clocks_spent) {
+        _clem_idle_loop_anchor(clem);
+        return;
+    }
+    skip_count = (clocks - clem->tspec.clocks_spent) / period;
+    if (idle->mega2_scanline_ctr != clem->tspec.mega2_scanline_ctr) {
+        //  The PHI0 phase matches but the stretch cycle position does not.  If no
+        //  stretch cycle occurred since the anchor, iterations remain identical
+        //  until the scanline counter would reach the stretch cycle.
+        clem_clocks_duration_t phi0_edges = period / CLEM_CLOCKS_PHI0_CYCLE;
+        if ((period % CLEM_CLOCKS_PHI0_CYCLE) != 0 ||
+            idle->mega2_scanline_ctr + phi0_edges != clem->tspec.mega2_scanline_ctr ||
+            clem->tspec.mega2_scanline_ctr >= 64) {
+            return;
+        }
+        if (skip_count > (64 - 1 - clem->tspec.mega2_scanline_ctr) / phi0_edges) {
+            skip_count = (64 - 1 - clem->tspec.mega2_scanline_ctr) / phi0_edges;
+        }
+        clem->tspec.mega2_scanline_ctr += (unsigned)(skip_count * phi0_edges);
+    }
+    //  the loop is periodic from the anchor - skip whole periods up to the deadline
+    clem->tspec.clocks_spent += skip_count * period;
+    clem->tspec.clocks_next_phi0 += skip_count * period;
+    cpu->cycles_spent += (uint32_t)(skip_count * (cpu->cycles_spent - idle->cycles_spent));
+    _clem_idle_loop_anchor(clem);
+}
 
-    // CLEM_I_PRINT_STATS(clem);
-
-    if (cpu->state_type == kClemensCPUStateType_Reset) {
-        uint16_t tmp_addr;
-        uint16_t tmp_value;
-        uint8_t tmp_data;
-        uint8_t tmp_datahi;
-
-        clem_read(clem, &tmp_data, cpu->regs.S, 0x00, CLEM_MEM_FLAG_DATA);
-        tmp_addr = cpu->regs.S - 1;
-        if (cpu->pins.emulation) {
-            tmp_addr = CLEM_UTIL_set16_lo(cpu->regs.S, tmp_addr);
-        }
-        clem_read(clem, &tmp_datahi, tmp_addr, 0x00, CLEM_MEM_FLAG_DATA);
-        _cpu_sp_dec2(cpu);
-        clem_read(clem, &tmp_data, cpu->regs.S, 0x00, CLEM_MEM_FLAG_DATA);
-        _cpu_sp_dec(cpu);
+//  Called after each instruction run by clemens_emulate_cpu_until(), including
+//  those run in a batch by the opcode handlers.  Returns true when control must
+//  return to the host.
+static bool _clem_cpu_step_end(ClemensMachine *clem, uint16_t opc_pc, uint8_t opc_pbr,
+                               clem_clocks_time_t clocks) {
+    struct Clemens65C816 *cpu = &clem->cpu;
 
-        // vector pull low signal while the PC is being loaded
-        cpu->regs.PC = _clem_read_interrupt_vector(clem, CLEM_6502_RESET_VECTOR_LO_ADDR,
-                                                   CLEM_6502_RESET_VECTOR_HI_ADDR);
-        cpu->state_type = kClemensCPUStateType_Execute;
-        return;
-    } else if (cpu->state_type == kClemensCPUStateType_IRQ ||
-               cpu->state_type == kClemensCPUStateType_NMI) {
-        uint8_t tmp_data;
-        uint8_t tmp_datahi;
-        uint16_t vlo, vhi;
-        if (cpu->pins.emulation) {
-            vlo = cpu->state_type == kClemensCPUStateType_NMI ? CLEM_6502_NMI_VECTOR_LO_ADDR
-                                                              : CLEM_6502_IRQBRK_VECTOR_LO_ADDR;
-            vhi = cpu->state_type == kClemensCPUStateType_NMI ? CLEM_6502_NMI_VECTOR_HI_ADDR
-                                                              : CLEM_6502_IRQBRK_VECTOR_HI_ADDR;
-        } else {
-            vlo = cpu->state_type == kClemensCPUStateType_NMI ? CLEM_65816_NMI_VECTOR_LO_ADDR
-                                                              : CLEM_65816_IRQB_VECTOR_LO_ADDR;
-            vhi = cpu->state_type == kClemensCPUStateType_NMI ? CLEM_65816_NMI_VECTOR_LO_ADDR
-                                                              : CLEM_65816_IRQB_VECTOR_HI_ADDR;
-        }
+    if (clem->debug_break && clemens_debug_breakpoint_hit(clem) &&
+        (*clem->debug_break)(clem->debug_user_ptr))
+        return true;
+    //  reset and interrupt handling are coordinated with the MMIO
+    if (!cpu->pins.resbIn || cpu->state_type != kClemensCPUStateType_Execute)
+        return true;
+    //  devices must sync after an I/O access.  Polling reads don't count, so that
+    //  loops waiting on a status register can be fast-forwarded below.
+    if (clem->mem.mmio_accessed)
+        return true;
+    //  an interrupt is pending and can be serviced (i.e. after CLI, PLP, RTI)
+    if (!cpu->pins.nmibIn)
+        return true;
+    if (!cpu->pins.irqbIn && !(cpu->regs.P & kClemensCPUStatus_IRQDisable))
+        return true;
+    //  after WAI or STP, nothing happens until a device raises an interrupt
+    //  or reset, which can only occur at or after the next MMIO event
+    if (!cpu->pins.readyOut || !cpu->enabled) {
+        _clem_wait_until(clem, clocks);
+        return true;
+    }
+    //  skipping instructions would hide them from tracing and breakpoints
+    if (!clem->debug_flags && !clem->debug_break && !clem->mem.bus_trace) {
+        //  a block move repeats itself at the same PC until the count runs out
+        if ((cpu->regs.IR == CLEM_OPC_MVN || cpu->regs.IR == CLEM_OPC_MVP) &&
+            cpu->regs.PC == opc_pc && cpu->regs.PBR == opc_pbr) {
+            clem_mem_block_move(clem, clocks);
+        }
+        _clem_idle_loop_check(clem, opc_pc, opc_pbr, clocks);
+    }
+    return clem->tspec.clocks_spent >= clocks;
+}
 
-        /* +2 cycles of 'internal ops'
-           +3/4 cycles for stack operations
-            2 cycles vector pull to PC
-        */
-        if (!cpu->pins.readyOut) {
-            CLEM_LOG("IRQ triggered after a likely WAI");
-            cpu->pins.readyOut = true;
-        }
-        _clem_cycle_2(clem);
-        _clem_irq_brk_setup(clem, &cpu->regs.PBR, &cpu->regs.PC, vlo, vhi, false);
-        cpu->state_type = kClemensCPUStateType_Execute;
+unsigned clemens_emulate_cpu_until(ClemensMachine *clem, clem_clocks_time_t clocks) {
+    struct Clemens65C816 *cpu = &clem->cpu;
+    unsigned step_count = 0;
+    uint16_t opc_pc;
+    uint8_t opc_pbr;
 
-        return;
+    clem->mem.mmio_accessed = false;
+    clem->dev_debug.watch_hit = 0;
+    for (;;) {
+        //  without tracing, the opcode handlers run instructions in batches
+        //  until one needs the host or the CPU mode changes.  Breakpoints are
+        //  checked between the instructions of a batch.
+        if (!clem->debug_flags && cpu->pins.resbIn && cpu->enabled &&
+            cpu->pins.readyOut && cpu->state_type == kClemensCPUStateType_Execute) {
+            clem->dev_debug.pc = cpu->regs.PC;
+            clem->dev_debug.pbr = cpu->regs.PBR;
+            if ((*s_cpu_execute_modes[_cpu_execute_mode_index(cpu)])(cpu, clem, clocks,
+                                                                       &step_count))
+                break;
+            continue;
+        }
+        opc_pc = cpu->regs.PC;
+        opc_pbr = cpu->regs.PBR;
+        clemens_emulate_cpu(clem);
+        ++step_count;
+        if (_clem_cpu_step_end(clem, opc_pc, opc_pbr, clocks))
+            break;
     }
-    if (!cpu->pins.readyOut) {
-        _clem_wait(clem);
-        return;
+    if (clem->mem.bus_trace) {
+        clem_mem_bus_trace_publish(clem->mem.bus_trace);
     }
-    clem->dev_debug.pc = cpu->regs.PC;
-    clem->dev_debug.pbr = cpu->regs.PBR;
-    cpu_execute(cpu, clem);
+
+    return step_count;
 }
@@ -106,6 +106,28 @@ bool clemens_is_resetting(const ClemensMachine *clem);
  */
 void clemens_emulate_cpu(ClemensMachine *clem);
 
+/**
+ * @brief Emulate the 65816 CPU until the specified time or until an event requires
+ *        the host's attention
+ *
+ * Runs clemens_emulate_cpu() repeatedly until clocks_spent reaches the clocks
+ * target.  Execution also stops early after an instruction that accessed MMIO,
+ * when an interrupt can be serviced (IRQB with interrupts enabled, or NMIB),
+ * when the CPU resets, or when the debug_break callback returns true.  A CPU
+ * halted by WAI or STP advances the clock directly to the target, since only an
+ * MMIO event can wake it.  If the target is CLEM_TIME_NEVER, the halted CPU
+ * instead returns after its one step so that the caller regains control.
+ *
+ * For the Apple IIgs, pass the MMIO's next event time (see
+ * clemens_mmio_next_event_ts()) and call clemens_emulate_mmio() afterwards.  At
+ * least one step is always executed.
+ *
+ * @param clem
+ * @param clocks The target clocks_spent value
+ * @return unsigned The number of steps executed
+ */
+unsigned clemens_emulate_cpu_until(ClemensMachine *clem, clem_clocks_time_t clocks);
+
 /**
  * @brief Defines the logger function and machine specific context.
  *
@@ -132,6 +154,99 @@ void clemens_host_setup(ClemensMachine *clem, ClemensLoggerFn logger, void *debu
  */
 void clemens_opcode_callback(ClemensMachine *clem, ClemensOpcodeCallback callback);
 
+/**
+ * @brief Defines a callback issued by clemens_emulate_cpu_until() after an
+ *        instruction that may have hit a breakpoint
+ *
+ * Breakpoints are added with clemens_debug_add_breakpoint().  The callback is
+ * issued when the next instruction's address has an execute breakpoint, after a
+ * data access to a watched address or after a BRK.  If the callback returns true,
+ * execution stops.  As with clemens_opcode_callback(), the debug_user_ptr passed
+ * to clemens_host_setup() is supplied to the callback.
+ *
+ * @param clem
+ * @param callback NULL to disable
+ */
+void clemens_debug_break_callback(ClemensMachine *clem, ClemensDebugBreakCallback callback);
+
+/**
+ * @brief Adds a breakpoint checked by clemens_emulate_cpu_until()
+ *
+ * Execute breakpoints are looked up by PBR:PC in a hash table between
+ * instructions.  Data read and write watchpoints mark their page so that only
+ * accesses to watched pages leave the memory fast path to be checked.  A hit on a
+ * watchpoint is recorded in dev_debug.watch_hit as
+ * CLEM_DEBUG_BREAKPOINT_KEY(type, bank, address) until the next call to
+ * clemens_emulate_cpu() or clemens_emulate_cpu_until().  The address is
+ * ignored for BRK breakpoints.  Breakpoints persist across resets.
+ *
+ * @param clem
+ * @param type
+ * @param address 24-bit address (bank << 16 | offset)
+ * @return false if CLEM_DEBUG_BREAKPOINT_LIMIT breakpoints have been added
+ */
+bool clemens_debug_add_breakpoint(ClemensMachine *clem, enum ClemensDebugBreakpointType type,
+                                  uint32_t address);
+
+/**
+ * @brief Returns the breakpoint hit by the instruction just run
+ *
+ * This is the check that precedes the debug break callback.  Execute breakpoints
+ * are matched against the next instruction's address.
+ *
+ * @param clem
+ * @return CLEM_DEBUG_BREAKPOINT_KEY(type, bank, address) of the watchpoint, execute
+ *         or BRK breakpoint hit (with a zero address for BRK), or 0
+ */
+uint32_t clemens_debug_breakpoint_hit(const ClemensMachine *clem);
+
+/**
+ * @brief Removes all breakpoints added by clemens_debug_add_breakpoint()
+ *
+ * @param clem
+ */
+void clemens_debug_clear_breakpoints(ClemensMachine *clem);
+
+/**
+ * @brief Prepares a bus trace ring over caller supplied records
+ *
+ * @param trace
+ * @param records storage that must outlive the trace
+ * @param capacity number of records, which must be a power of two
+ */
+void clemens_bus_trace_init(struct ClemensBusTrace *trace, struct ClemensBusTraceRecord *records,
+                            unsigned capacity);
+
+/**
+ * @brief Records every CPU bus cycle into the trace ring
+ *
+ * Each read and write cycle issued by the CPU appends a ClemensBusTraceRecord
+ * holding the clock, address, data and bus flags.  The emulator never waits on
+ * the ring - if it's full, cycles are dropped, counted in trace->dropped and
+ * the next record is marked with CLEM_BUS_TRACE_FLAG_GAP.  Records are made
+ * available to clemens_bus_trace_read() in batches and at the end of each
+ * clemens_emulate_cpu_until().  Instruction skipping (idle loops and block
+ * moves) is disabled while a trace is attached so that no cycles are missed.
+ *
+ * @param clem
+ * @param trace NULL to stop tracing, which publishes any pending records
+ */
+void clemens_bus_trace_attach(ClemensMachine *clem, struct ClemensBusTrace *trace);
+
+/**
+ * @brief Copies published records out of the ring
+ *
+ * This is safe to call from a thread other than the emulator's, as long as only
+ * one thread reads from the trace.
+ *
+ * @param trace
+ * @param records
+ * @param limit maximum number of records to copy
+ * @return the number of records copied
+ */
+unsigned clemens_bus_trace_read(struct ClemensBusTrace *trace,
+                                struct ClemensBusTraceRecord *records, unsigned limit);
+
 /**
  * @brief
  *
@@ -341,6 +341,7 @@ void clemens_monitor_to_video_coordinates(ClemensMonitor *monitor, ClemensVideo
 void clemens_assign_audio_mix_buffer(ClemensMMIO *mmio, struct ClemensAudioMixBuffer *mix_buffer) {
     memcpy(&mmio->dev_audio.mix_buffer, mix_buffer, sizeof(struct ClemensAudioMixBuffer));
     clem_sound_reset(&mmio->dev_audio);
+    mmio->next_event_ts = 0;
 }
 
 ClemensAudio *clemens_get_audio(ClemensAudio *audio, ClemensMMIO *mmio) {
@@ -356,14 +357,37 @@ ClemensAudio *clemens_get_audio(ClemensAudio *audio, ClemensMMIO *mmio) {
 
 void clemens_audio_next_frame(ClemensMMIO *mmio, unsigned consumed) {
     clem_sound_consume_frames(&mmio->dev_audio, consumed);
+    mmio->next_event_ts = 0;
+}
+
+bool clemens_is_mega2_memory_dirty(const ClemensMachine *machine, uint8_t bank, uint16_t adr,
+                                   unsigned byte_cnt) {
+    const uint8_t *dirty_pages = machine->mem.mega2_dirty_pages[bank & 0x1];
+    unsigned page_idx, page_end;
+    if (byte_cnt == 0)
+        return false;
+    page_end = ((unsigned)adr + byte_cnt - 1) >> 8;
+    if (page_end > 0xff)
+        page_end = 0xff;
+    for (page_idx = adr >> 8; page_idx <= page_end; ++page_idx) {
+        if (dirty_pages[page_idx >> 3] & (1 << (page_idx & 0x7)))
+            return true;
+    }
+    return false;
+}
+
+void clemens_video_next_frame(ClemensMachine *machine) {
+    memset(machine->mem.mega2_dirty_pages, 0, sizeof(machine->mem.mega2_dirty_pages));
 }
 
 void clemens_input(ClemensMMIO *mmio, const struct ClemensInputEvent *input) {
     clem_adb_device_input(&mmio->dev_adb, input);
+    mmio->next_event_ts = 0;
 }
 
 void clemens_input_key_toggle(ClemensMMIO *mmio, unsigned enabled) {
     clem_adb_device_key_toggle(&mmio->dev_adb, enabled);
+    mmio->next_event_ts = 0;
 }
 
 unsigned clemens_get_adb_key_modifier_states(ClemensMMIO *mmio) {
@@ -457,52 +481,84 @@ bool clemens_is_mmio_initialized(const ClemensMMIO *mmio) {
     return mmio->state_type == kClemensMMIOStateType_Active;
 }
 
-void clemens_emulate_mmio(ClemensMachine *clem, ClemensMMIO *mmio) {
-    struct Clemens65C816 *cpu = &clem->cpu;
+clem_clocks_time_t clemens_mmio_next_event_ts(const ClemensMMIO *mmio) {
+    return mmio->next_event_ts;
+}
+
+static inline clem_clocks_time_t _clem_mmio_min_ts(clem_clocks_time_t a, clem_clocks_time_t b) {
+    return a < b ? a : b;
+}
+
+/* Each device publishes the time of its next internal event (scanline, DOC
+   interrupt, IWM bit cell while the motor is on, SCC clock edge, paddle timer,
+   60hz timer.)  Between these events device state only changes from I/O register
+   accesses, which reset the deadline so that devices are synced after the
+   instruction that accessed them.
+*/
+static clem_clocks_time_t _clem_mmio_next_event_ts(ClemensMMIO *mmio, struct ClemensClock *clock,
+                                                   uint32_t card_dmas) {
+    clem_clocks_time_t next_ts;
+    uint32_t mega2_cycles_remaining;
+    ClemensCard *card;
+    unsigned i;
+
+    if (card_dmas) {
+        return clock->ts;
+    }
+
+    mega2_cycles_remaining = CLEM_MEGA2_CYCLES_PER_60TH - mmio->timer_60hz_us;
+    if (clem_adb_glu_next_event_us(&mmio->dev_adb) < mega2_cycles_remaining) {
+        mega2_cycles_remaining = clem_adb_glu_next_event_us(&mmio->dev_adb);
+    }
+    next_ts = (mmio->mega2_cycles + mega2_cycles_remaining) * CLEM_CLOCKS_PHI0_CYCLE;
+    next_ts = _clem_mmio_min_ts(next_ts, clem_vgc_next_event_ts(&mmio->vgc));
+    next_ts = _clem_mmio_min_ts(next_ts, clem_iwm_glu_next_event_ts(&mmio->dev_iwm));
+    next_ts = _clem_mmio_min_ts(next_ts, clem_scc_glu_next_event_ts(&mmio->dev_scc));
+    next_ts = _clem_mmio_min_ts(next_ts, clem_sound_glu_next_event_ts(&mmio->dev_audio));
+    next_ts = _clem_mmio_min_ts(next_ts, clem_gameport_next_event_ts(&mmio->dev_adb.gameport));
+
+    for (i = 0; i < CLEM_CARD_SLOT_COUNT; ++i) {
+        card = mmio->card_slot[i];
+        if (!card)
+            continue;
+        if (!card->io_next_event)
+            return clock->ts;
+        next_ts = _clem_mmio_min_ts(next_ts, (*card->io_next_event)(clock, card->context));
+    }
+    return next_ts;
+}
+
+//  Block transfers run at the same one byte per Mega II cycle as io_dma(), but
+//  are copied in bulk instead of byte by byte through the page map
+static void _clem_mmio_card_dma_block(ClemensMachine *clem, ClemensCard *card,
+                                      uint32_t mega2_cycles) {
+    struct ClemensCardDMA dma;
+    unsigned count;
+
+    while (mega2_cycles > 0 && (*card->io_dma_block)(&dma, card->context)) {
+        if (dma.length == 0)
+            break;
+        count = dma.length < mega2_cycles ? dma.length : mega2_cycles;
+        clem_mem_dma(clem, dma.data, dma.adr, dma.bank, count, dma.is_write != 0);
+        (*card->io_dma_done)(count, card->context);
+        mega2_cycles -= count;
+    }
+}
+
+static void _clem_mmio_sync(ClemensMachine *clem, ClemensMMIO *mmio) {
     struct ClemensClock clock;
     struct ClemensDeviceMega2Memory m2mem;
     uint32_t delta_mega2_cycles;
     uint32_t card_result;
     uint32_t card_irqs;
     uint32_t card_nmis;
+    uint32_t card_dmas;
     unsigned i, cyc;
     ClemensCard* card;
     uint8_t dma_bank, dma_data;
     uint16_t dma_addr;
     uint8_t dma_latch;
 
-    if (!cpu->pins.resbIn) {
-        //  don't actually process MMIO until reset cycle has completed (resbIn==true)
-        mmio->state_type = kClemensMMIOStateType_Reset;
-        return;
-    }
-    if (mmio->state_type == kClemensMMIOStateType_Reset) {
-        clem_mmio_bind_machine(clem, mmio);
-        clem_disk_reset_drives(&mmio->active_drives);
-        clem_mmio_reset(mmio, &clem->tspec);
-        /* extension cards reset handling */
-        clem_iwm_speed_disk_gate(mmio, &clem->tspec);
-        clock.ts = clem->tspec.clocks_spent;
-        clock.ref_step = CLEM_CLOCKS_PHI0_CYCLE;
-        for (i = 0; i < CLEM_CARD_SLOT_COUNT; ++i) {
-            if (mmio->card_slot[i]) {
-                mmio->card_slot[i]->io_reset(&clock, mmio->card_slot[i]->context);
-            }
-        }
-        clem_iwm_speed_disk_gate(mmio, &clem->tspec);
-
-        mmio->state_type = kClemensMMIOStateType_Active;
-        return;
-    }
-    if (mmio->state_type != kClemensMMIOStateType_Active)
-        return;
-
-    //  record the last data access for switches that check if an I/O was accessed
-    //  twice in succession
-    if (clem->cpu.pins.vdaOut) {
-        mmio->last_data_address = (((uint32_t)clem->cpu.pins.bank) << 16) | clem->cpu.pins.adr;
-    }
-
     clem_iwm_speed_disk_gate(mmio, &clem->tspec);
 
     //  1 mega2 cycle = 1023 nanoseconds
@@ -526,6 +582,7 @@ void clemens_emulate_mmio(ClemensMachine *clem, ClemensMMIO *mmio) {
 
     card_nmis = 0;
     card_irqs = 0;
+    card_dmas = 0;
     for (i = 0; i < CLEM_CARD_SLOT_COUNT; ++i) {
         card = mmio->card_slot[i];
         if (!card)
@@ -536,6 +593,11 @@ void clemens_emulate_mmio(ClemensMachine *clem, ClemensMMIO *mmio) {
         if (card_result & CLEM_CARD_NMI)
             card_nmis |= (1 << i);
         if (card_result & CLEM_CARD_DMA) {
+            card_dmas |= (1 << i);
+            if (card->io_dma_block) {
+                _clem_mmio_card_dma_block(clem, card, delta_mega2_cycles);
+                continue;
+            }
             //  run one dma per mega2 cycle - perhaps this is overkill given
             //  our use-case
             for (cyc = 0; cyc < delta_mega2_cycles; ++cyc) {
@@ -557,9 +619,14 @@ void clemens_emulate_mmio(ClemensMachine *clem, ClemensMMIO *mmio) {
 
     clem_vgc_sync(&mmio->vgc, &clock, clem->mem.mega2_bank_map[0], clem->mem.mega2_bank_map[1]);
     clem_iwm_glu_sync(&mmio->dev_iwm, &mmio->active_drives, &clem->tspec);
-    clem_scc_glu_sync(&mmio->dev_scc, &clock);
+    //  the SCC and paddles otherwise catch up when their registers are accessed
+    if (clock.ts >= clem_scc_glu_next_event_ts(&mmio->dev_scc)) {
+        clem_scc_glu_sync(&mmio->dev_scc, &clock);
+    }
     clem_sound_glu_sync(&mmio->dev_audio, &clock);
-    clem_gameport_sync(&mmio->dev_adb.gameport, &clock);
+    if (clock.ts >= clem_gameport_next_event_ts(&mmio->dev_adb.gameport)) {
+        clem_gameport_sync(&mmio->dev_adb.gameport, &clock);
+    }
 
     /* background execution of some async devices on the 60 hz timer */
     /* TODO: ADB autopoll should occur on the VBL, also mega2 cycles aren't 1us (close!)
@@ -582,6 +649,44 @@ void clemens_emulate_mmio(ClemensMachine *clem, ClemensMMIO *mmio) {
     mmio->nmi_line = card_nmis;
     clem_iwm_speed_disk_gate(mmio, &clem->tspec);
 
+    mmio->next_event_ts = _clem_mmio_next_event_ts(mmio, &clock, card_dmas);
+}
+
+void clemens_emulate_mmio(ClemensMachine *clem, ClemensMMIO *mmio) {
+    struct Clemens65C816 *cpu = &clem->cpu;
+    struct ClemensClock clock;
+    unsigned i;
+
+    if (!cpu->pins.resbIn) {
+        //  don't actually process MMIO until reset cycle has completed (resbIn==true)
+        mmio->state_type = kClemensMMIOStateType_Reset;
+        return;
+    }
+    if (mmio->state_type == kClemensMMIOStateType_Reset) {
+        clem_mmio_bind_machine(clem, mmio);
+        clem_disk_reset_drives(&mmio->active_drives);
+        clem_mmio_reset(mmio, &clem->tspec);
+        /* extension cards reset handling */
+        clem_iwm_speed_disk_gate(mmio, &clem->tspec);
+        clock.ts = clem->tspec.clocks_spent;
+        clock.ref_step = CLEM_CLOCKS_PHI0_CYCLE;
+        for (i = 0; i < CLEM_CARD_SLOT_COUNT; ++i) {
+            if (mmio->card_slot[i]) {
+                mmio->card_slot[i]->io_reset(&clock, mmio->card_slot[i]->context);
+            }
+        }
+        clem_iwm_speed_disk_gate(mmio, &clem->tspec);
+
+        mmio->state_type = kClemensMMIOStateType_Active;
+        return;
+    }
+    if (mmio->state_type != kClemensMMIOStateType_Active)
+        return;
+
+    if (clem->tspec.clocks_spent >= mmio->next_event_ts) {
+        _clem_mmio_sync(clem, mmio);
+    }
+
     cpu->pins.irqbIn = mmio->irq_line == 0;
     cpu->pins.nmibIn = mmio->nmi_line == 0;
 
@@ -29,6 +29,18 @@ bool clemens_is_mmio_initialized(const ClemensMMIO *mmio);
  */
 void clemens_emulate_mmio(ClemensMachine *clem, ClemensMMIO *mmio);
 
+/**
+ * @brief Returns the time of the next scheduled device event
+ *
+ * The CPU can run uninterrupted until this time (see clemens_emulate_cpu_until())
+ * provided it doesn't access I/O, after which clemens_emulate_mmio() must be
+ * called.
+ *
+ * @param mmio
+ * @return clem_clocks_time_t
+ */
+clem_clocks_time_t clemens_mmio_next_event_ts(const ClemensMMIO *mmio);
+
 /**
  * @brief Returns the emulated system's clocks per second
  *
@@ -291,6 +303,31 @@ ClemensVideo *clemens_get_text_video(ClemensVideo *video, ClemensMMIO *mmio);
 ClemensVideo *clemens_get_graphics_video(ClemensVideo *video, ClemensMachine *machine,
                                          ClemensMMIO *mmio);
 
+/**
+ * @brief Returns whether Mega II memory in a range was written since the last frame
+ *
+ * Writes to banks $E0 and $E1, whether direct or through shadowing, are tracked
+ * per 256 byte page.  Hosts can skip rendering text, hires and super hires
+ * regions that were not written, provided the video mode and monitor settings
+ * are also unchanged.
+ *
+ * @param machine
+ * @param bank      $E0 or $E1
+ * @param adr       start address of the range
+ * @param byte_cnt  size of the range in bytes (clipped to the end of the bank)
+ * @return true     if any page in the range is dirty
+ */
+bool clemens_is_mega2_memory_dirty(const ClemensMachine *machine, uint8_t bank, uint16_t adr,
+                                   unsigned byte_cnt);
+
+/**
+ * @brief After the host is done with the video frame, call this to reset the
+ * dirty page tracking used by clemens_is_mega2_memory_dirty()
+ *
+ * @param machine
+ */
+void clemens_video_next_frame(ClemensMachine *machine);
+
 /**
  * @brief Converts monitor coordinates to the specified video view window coordinates
  *
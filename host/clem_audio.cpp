@@ -20,26 +20,36 @@ void sokolLogger(const char *tag,              // e.g. 'sg'
                  void *);
 
 ClemensAudioDevice::ClemensAudioDevice()
-    : queuedFrameBuffer_(nullptr), queuedFrameHead_(0), queuedFrameTail_(0), queuedFrameLimit_(0),
-      queuedFrameStride_(0) {}
+    : queuedFrameBuffer_(nullptr), queuedFrameLimit_(0), queuedFrameStride_(0),
+      queuedFrameHead_(0), queuedFrameTail_(0), queuedFrameFlush_(0), underrunFrameCount_(0),
+      overrunFrameCount_(0) {}
 
 ClemensAudioDevice::~ClemensAudioDevice() { stop(); }
 
-void ClemensAudioDevice::start() {
+void ClemensAudioDevice::start(unsigned bufferFrames) {
     saudio_desc audioDesc = {};
     audioDesc.sample_rate = 48000;
     audioDesc.num_channels = 2;
-    audioDesc.buffer_frames = 2048;
+    audioDesc.buffer_frames = (int)bufferFrames;
     audioDesc.stream_userdata_cb = &ClemensAudioDevice::mixAudio;
     audioDesc.user_data = this;
     audioDesc.logger.func = sokolLogger;
+
+    //  the audio thread starts on setup, and sees an empty queue until frames are
+    //  published by queue()
+    queuedFrameHead_.store(0, std::memory_order_relaxed);
+    queuedFrameTail_.store(0, std::memory_order_relaxed);
+    queuedFrameFlush_.store(0, std::memory_order_relaxed);
+    underrunFrameCount_.store(0, std::memory_order_relaxed);
+    overrunFrameCount_.store(0, std::memory_order_relaxed);
     saudio_setup(audioDesc);
 
-    queuedFrameHead_ = 0;
-    queuedFrameTail_ = 0;
     if (saudio_isvalid()) {
         queuedFrameStride_ = 2 * sizeof(float);
-        queuedFrameLimit_ = saudio_sample_rate() / 2;
+        queuedFrameLimit_ = 1;
+        while (queuedFrameLimit_ < (uint32_t)saudio_sample_rate() / 2) {
+            queuedFrameLimit_ <<= 1;
+        }
         queuedFrameBuffer_ = new uint8_t[queuedFrameLimit_ * queuedFrameStride_];
         spdlog::info("ClemensAudioDevice queuedFrameBuffer {} khz, frame limit = {}, stride = {}",
                      audioDesc.sample_rate / 1000.0f, queuedFrameLimit_, queuedFrameStride_);
@@ -55,19 +65,32 @@ void ClemensAudioDevice::stop() {
         saudio_shutdown();
         delete[] queuedFrameBuffer_;
         queuedFrameBuffer_ = nullptr;
+        spdlog::info("ClemensAudioDevice underrun frames = {}, overrun frames = {}",
+                     getUnderrunFrameCount(), getOverrunFrameCount());
     }
 }
 
 unsigned ClemensAudioDevice::getAudioFrequency() const { return saudio_sample_rate(); }
 unsigned ClemensAudioDevice::getBufferStride() const { return queuedFrameStride_; }
 
+unsigned ClemensAudioDevice::getQueuedFrameCount() const {
+    uint32_t head = queuedFrameHead_.load(std::memory_order_acquire);
+    uint32_t flushTail = queuedFrameFlush_.load(std::memory_order_relaxed);
+    uint32_t tail = queuedFrameTail_.load(std::memory_order_relaxed);
+    //  flushed frames not yet skipped by the audio thread aren't counted
+    if ((int32_t)(flushTail - head) > 0) {
+        head = flushTail;
+    }
+    return tail - head;
+}
+
 unsigned ClemensAudioDevice::queue(const ClemensAudio &audio, bool flush) {
+    uint32_t tail = queuedFrameTail_.load(std::memory_order_relaxed);
+    if (flush) {
+        //  only the audio thread moves the head, so it discards the flushed frames
+        queuedFrameFlush_.store(tail, std::memory_order_release);
+    }
     if (!audio.frame_count || !queuedFrameBuffer_ || flush) {
-        if (flush) {
-            std::lock_guard<std::mutex> lk(queuedFrameMutex_);
-            queuedFrameTail_ = 0;
-            queuedFrameHead_ = 0;
-        }
         return 0;
     }
 
@@ -76,101 +99,62 @@ unsigned ClemensAudioDevice::queue(const ClemensAudio &audio, bool flush) {
     //  the actual mix.
     assert(audio.frame_stride == queuedFrameStride_);
 
-    //  update will mutex mixAudio, which is necessary when running the mixer
-    //  callbacks in the core audio thread.
-    unsigned audioInUsed = 0;
-    {
-        std::lock_guard<std::mutex> lk(queuedFrameMutex_);
-
-        //  the input comes from a flat buffer, so ignore the buffer frame limit.
-        //   TODO: Don't think we're going to support wraparound here, so look into better
-        //         ways for the API to illustrate this.
-        uint32_t audioInHead = audio.frame_start;
-        uint32_t audioInEnd = audio.frame_total;
-        uint32_t audioInTail = audio.frame_start + audio.frame_count;
-        if (audioInTail > audioInEnd) {
-            audioInTail -= audioInTail;
-        }
-        uint32_t audioInAvailable = audio.frame_count;
-        uint32_t audioOutAvailable = queuedFrameLimit_ - queuedFrameTail_;
-
-        assert(audioInTail >= audioInHead);
-
-        if (audioInAvailable > audioOutAvailable && queuedFrameHead_ > 0) {
-            //  adjust audioOut queue so that all frames *already* mixed are removed
-            //  which will free up some space
-            if (queuedFrameHead_ != queuedFrameTail_) {
-                memmove(queuedFrameBuffer_,
-                        queuedFrameBuffer_ + (queuedFrameHead_ * queuedFrameStride_),
-                        (queuedFrameTail_ - queuedFrameHead_) * queuedFrameStride_);
-                queuedFrameTail_ -= queuedFrameHead_;
-            } else {
-                queuedFrameTail_ = 0;
-            }
-            queuedFrameHead_ = 0;
-            audioOutAvailable = queuedFrameLimit_ - queuedFrameTail_;
-        }
-        if (audioInAvailable > audioOutAvailable) {
-            //  copy only the amount we can to the output - so we don't have to
-            //  bounds check against our queued output buffer when copying data.
-            audioInAvailable = audioOutAvailable;
-        }
-
-        //  copy occurs from at most two windows in the input (re: ring buffer), to
-        //  the single output window.
-        uint8_t *audioOut = queuedFrameBuffer_ + queuedFrameTail_ * queuedFrameStride_;
-        uint8_t *audioIn = audio.data + audioInHead * audio.frame_stride;
-
-        uint32_t audioInCount = audioInTail - audioInHead;
-        assert(audioInHead + audioInAvailable <= audioInEnd);
-        /*
-        if (audioInHead + audioInAvailable > audioInEnd) {
-            audioInCount = audioInEnd - audioInHead;
-            memcpy(audioOut, audioIn, audioInCount * audio.frame_stride);
-            queuedFrameTail_ += audioInCount;
-            audioOut = queuedFrameBuffer_ + queuedFrameTail_ * queuedFrameStride_;
-            audioIn = audio.data;
-            audioInAvailable -= audioInCount;
-            audioInUsed += audioInCount;
-            audioInHead = 0;
-        }
-        */
-        uint32_t framesOutCount = std::min(audioOutAvailable, audioInCount);
-        // memset(audioOut, 0xea, audioInCount * audio.frame_stride);
-        memcpy(audioOut, audioIn, framesOutCount * audio.frame_stride);
-        queuedFrameTail_ += framesOutCount;
-        audioInAvailable -= framesOutCount;
-        audioInUsed += framesOutCount;
-        if (audioInAvailable > 0) {
-            spdlog::info("ClemensAudioDevice: {} frames not queued for playback, output = {}",
-                         audioInAvailable, framesOutCount);
-        }
+    //  the input comes from a flat buffer, so ignore the buffer frame limit.
+    uint32_t audioInCount = audio.frame_count;
+    assert(audio.frame_start + audioInCount <= audio.frame_total);
+    const uint8_t *audioIn = audio.data + audio.frame_start * audio.frame_stride;
+
+    //  the head may only advance while copying, which leaves more room than counted
+    uint32_t head = queuedFrameHead_.load(std::memory_order_acquire);
+    uint32_t audioOutAvailable = queuedFrameLimit_ - (tail - head);
+    uint32_t framesOutCount = std::min(audioOutAvailable, audioInCount);
+
+    //  copy to at most two windows in the output ring
+    uint32_t audioOutIndex = tail & (queuedFrameLimit_ - 1);
+    uint32_t framesOutFirst = std::min(framesOutCount, queuedFrameLimit_ - audioOutIndex);
+    memcpy(queuedFrameBuffer_ + audioOutIndex * queuedFrameStride_, audioIn,
+           framesOutFirst * queuedFrameStride_);
+    memcpy(queuedFrameBuffer_, audioIn + framesOutFirst * queuedFrameStride_,
+           (framesOutCount - framesOutFirst) * queuedFrameStride_);
+    queuedFrameTail_.store(tail + framesOutCount, std::memory_order_release);
+
+    if (framesOutCount < audioInCount) {
+        overrunFrameCount_.fetch_add(audioInCount - framesOutCount, std::memory_order_relaxed);
     }
-
-    return audioInUsed;
+    return framesOutCount;
 }
 
 void ClemensAudioDevice::mixClemensAudio(float *audioOut, int num_frames, int num_channels) {
-    std::lock_guard<std::mutex> lk(queuedFrameMutex_);
     //  clemens generates an output mix == to the hardware mixer to avoid having
     //  to upsample here.
-    uint32_t queuedAvailable = queuedFrameTail_ - queuedFrameHead_;
+    uint32_t head = queuedFrameHead_.load(std::memory_order_relaxed);
+    //  the flush is read before the tail, so that the tail is at least the flushed one
+    uint32_t flushTail = queuedFrameFlush_.load(std::memory_order_acquire);
+    uint32_t tail = queuedFrameTail_.load(std::memory_order_acquire);
+    if ((int32_t)(flushTail - head) > 0) {
+        head = flushTail;
+    }
+    uint32_t queuedAvailable = tail - head;
     uint32_t remainingFrames = num_frames;
     float *frameOut = audioOut;
     if (queuedAvailable != 0) {
         auto frameLimit = std::min(queuedAvailable, (uint32_t)num_frames);
-        const uint8_t *inData = queuedFrameBuffer_ + queuedFrameHead_ * queuedFrameStride_;
+        uint32_t frameMask = queuedFrameLimit_ - 1;
 
         for (uint32_t frameIndex = 0; frameIndex < frameLimit; ++frameIndex) {
-            auto *frameIn = reinterpret_cast<const float *>(inData);
-            inData += queuedFrameStride_;
+            auto *frameIn = reinterpret_cast<const float *>(
+                queuedFrameBuffer_ + ((head + frameIndex) & frameMask) * queuedFrameStride_);
             frameOut[0] = frameIn[0];
             frameOut[1] = frameIn[1];
             frameOut += num_channels;
         }
-        queuedFrameHead_ += frameLimit;
+        head += frameLimit;
         remainingFrames -= frameLimit;
     }
+    queuedFrameHead_.store(head, std::memory_order_release);
+    if (remainingFrames > 0) {
+        underrunFrameCount_.fetch_add(remainingFrames, std::memory_order_relaxed);
+    }
     for (; remainingFrames > 0; --remainingFrames) {
         frameOut[0] = 0.0f;
         frameOut[1] = 0.0f;
@@ -3,9 +3,13 @@
 
 #include "clem_mmio_types.h"
 
-#include <mutex>
-#include <vector>
+#include <atomic>
+#include <cstdint>
 
+//  Frames rendered by the emulator thread are passed to the audio thread through a
+//  single producer, single consumer ring so that neither side ever blocks.  Frames
+//  that don't fit in the ring are dropped (overrun) and frames missing when the
+//  audio callback runs are played as silence (underrun.)
 class ClemensAudioDevice {
   public:
     ClemensAudioDevice();
@@ -14,23 +18,42 @@ class ClemensAudioDevice {
     unsigned getAudioFrequency() const;
     unsigned getBufferStride() const;
 
-    void start();
+    //  bufferFrames is the size of the host audio callback's buffer
+    void start(unsigned bufferFrames = 2048);
     void stop();
+    //  Must only be called from one thread at a time
     unsigned queue(const ClemensAudio &audio, bool flush);
 
+    //  Frame counts since start() - underruns include any time the emulator isn't
+    //  queueing audio
+    uint64_t getUnderrunFrameCount() const {
+        return underrunFrameCount_.load(std::memory_order_relaxed);
+    }
+    uint64_t getOverrunFrameCount() const {
+        return overrunFrameCount_.load(std::memory_order_relaxed);
+    }
+    //  Frames waiting for the audio callback, called from the thread calling queue()
+    unsigned getQueuedFrameCount() const;
+
   private:
     static void mixAudio(float *buffer, int num_frames, int num_channels, void *user_data);
 
     void mixClemensAudio(float *buffer, int num_frames, int num_channels);
 
-    // audio sent to the hardware mixer
+    // audio sent to the hardware mixer - the limit is a power of two
     uint8_t *queuedFrameBuffer_;
-    uint32_t queuedFrameHead_;
-    uint32_t queuedFrameTail_;
     uint32_t queuedFrameLimit_;
     uint32_t queuedFrameStride_;
 
-    std::mutex queuedFrameMutex_;
+    //  free running frame indices, where the head is only written by the audio
+    //  thread and the tail by the emulator thread.  A flush marks the tail at the
+    //  time of the flush, and the audio thread skips ahead to it.
+    std::atomic<uint32_t> queuedFrameHead_;
+    std::atomic<uint32_t> queuedFrameTail_;
+    std::atomic<uint32_t> queuedFrameFlush_;
+
+    std::atomic<uint64_t> underrunFrameCount_;
+    std::atomic<uint64_t> overrunFrameCount_;
 };
 
 #endif
@@ -8,6 +8,7 @@
 
 #include "clem_disk.h"
 #include "clem_host_platform.h"
+#include "clem_bus_trace.hpp"
 #include "clem_program_trace.hpp"
 
 #include "clem_device.h"
@@ -23,6 +24,7 @@
 #include "spdlog/common.h"
 #include "spdlog/spdlog.h"
 
+#include <algorithm>
 #include <charconv>
 #include <chrono>
 #include <ctime>
@@ -159,15 +161,46 @@ void ClemensRunSampler::update(clem_clocks_duration_t clocksSpent, unsigned cycl
     avgVBLsPerFrame = (double)sampledVblsSpent / vblsBuffer.size();
 }
 
+ClemensAudioRateController::ClemensAudioRateController() { reset(0); }
+
+void ClemensAudioRateController::reset(unsigned targetQueuedFrames) {
+    targetFrames = targetQueuedFrames;
+    integral = 0.0;
+    scalar = 1.0;
+    isPrimed = false;
+}
+
+unsigned ClemensAudioRateController::prime(unsigned queuedFrames) {
+    if (isPrimed)
+        return 0;
+    isPrimed = true;
+    return queuedFrames < targetFrames ? (unsigned)targetFrames - queuedFrames : 0;
+}
+
+double ClemensAudioRateController::update(unsigned queuedFrames, double dt) {
+    if (targetFrames <= 0.0)
+        return 1.0;
+    //  the error is relative to the target so that the gains don't depend on latency,
+    //  and the integral is clamped so that it can't wind up past the scalar limit
+    double error = (targetFrames - queuedFrames) / targetFrames;
+    integral = std::clamp(integral + error * dt, -kScalarLimit / kIntegralGain,
+                          kScalarLimit / kIntegralGain);
+    scalar = 1.0 + std::clamp(kProportionalGain * error + kIntegralGain * integral,
+                              -kScalarLimit, kScalarLimit);
+    return scalar;
+}
+
 ClemensBackend::ClemensBackend(std::string romPath, const Config &config)
     : config_(config), gsConfigUpdated_(false),
       interpreterData_(kInterpreterMemorySize),
       interpreter_(cinek::FixedStack(kInterpreterMemorySize, interpreterData_.data())),
       breakpoints_(std::move(config_.breakpoints)), logLevel_(config_.logLevel),
       debugMemoryPage_(0x00), areInstructionsLogged_(false), fastModeEnabled_(false), 
-      stepsRemaining_(0), clocksRemainingInTimeslice_(0) {
+      stepsRemaining_(0), clocksRemainingInTimeslice_(0), audioQueuedFrames_(0) {
 
     loggedInstructions_.reserve(10000);
+    audioRateController_.reset(config_.audioTargetQueuedFrames);
+    lastTimesliceTimePoint_ = std::chrono::high_resolution_clock::now();
 
     clemens_register();
 
@@ -177,11 +210,12 @@ ClemensBackend::ClemensBackend(std::string romPath, const Config &config)
         GS_->mount();
         break;
     }
+    syncBreakpoints();
 
     clipboardHead_ = 0;
 }
 
-ClemensBackend::~ClemensBackend() {}
+ClemensBackend::~ClemensBackend() { stopBusTrace(); }
 
 bool ClemensBackend::isRunning() const {
     return !stepsRemaining_.has_value() || *stepsRemaining_ > 0;
@@ -241,11 +275,46 @@ auto ClemensBackend::step(ClemensCommandQueue &commands) -> ClemensCommandQueue:
         auto lastClocksSpent = machine.tspec.clocks_spent;
         machine.cpu.cycles_spent = 0;
 
+        //  When running freely, the CPU executes in batches up to the next device
+        //  event.  The emulator stops a batch early on instructions that may hit a
+        //  breakpoint (see syncBreakpoints()).
+        GS_->enableDebugBreak(!breakpoints_.empty());
+
+        //  With audio rate control, a timeslice is the wall clock time since the last
+        //  one, scaled by the controller to keep the audio queue near its target.
+        //  Otherwise (and when stepping or in fast mode) it's a number of VBLs.
+        auto timesliceTimePoint = std::chrono::high_resolution_clock::now();
+        double dtTimeslice =
+            std::chrono::duration<double>(timesliceTimePoint - lastTimesliceTimePoint_).count();
+        lastTimesliceTimePoint_ = timesliceTimePoint;
+        bool isTimesliced = config_.audioTargetQueuedFrames > 0 && !stepsRemaining_.has_value() &&
+                            !runSampler_.fastModeEnabled;
+        if (isTimesliced) {
+            //  long stalls (i.e. a window drag) aren't caught up
+            constexpr double kTimesliceLimitSecs = 0.1;
+            dtTimeslice = std::min(dtTimeslice, kTimesliceLimitSecs);
+            double rate = audioRateController_.update(audioQueuedFrames_, dtTimeslice);
+            clocksRemainingInTimeslice_ += (int64_t)(dtTimeslice * kClocksPerSecond * rate);
+            if (config_.GS.audioSamplesPerSecond > 0) {
+                clocksRemainingInTimeslice_ +=
+                    (int64_t)(audioRateController_.prime(audioQueuedFrames_) * kClocksPerSecond /
+                              config_.GS.audioSamplesPerSecond);
+            }
+        } else {
+            clocksRemainingInTimeslice_ = 0;
+        }
+
         unsigned emulatorVblCounter = runSampler_.emulatorVblsPerFrame;
-        while (emulatorVblCounter > 0 && isRunning()) {
-            auto machineResult = GS_->stepMachine();
+        while ((isTimesliced ? clocksRemainingInTimeslice_ > 0 : emulatorVblCounter > 0) &&
+               isRunning()) {
+            auto batchClocksSpent = machine.tspec.clocks_spent;
+            auto machineResult =
+                stepsRemaining_.has_value() ? GS_->stepMachine() : GS_->runMachine();
             if (test(machineResult, ClemensAppleIIGS::ResultFlags::Resetting)) {
                 lastClocksSpent = machine.tspec.clocks_spent; // clocks being reset
+            } else {
+                clocksRemainingInTimeslice_ -=
+                    (int64_t)(machine.tspec.clocks_spent - batchClocksSpent);
             }
             if (test(machineResult, ClemensAppleIIGS::ResultFlags::VerticalBlank)) {
                 if (clipboardHead_ < clipboardText_.size()) {
@@ -278,9 +347,14 @@ auto ClemensBackend::step(ClemensCommandQueue &commands) -> ClemensCommandQueue:
         }
 
         GS_->enableOpcodeLogging(false);
+        GS_->enableDebugBreak(false);
 
         runSampler_.update((clem_clocks_duration_t)(machine.tspec.clocks_spent - lastClocksSpent),
                            machine.cpu.cycles_spent);
+        //  leaving fast mode flushes the audio queue
+        if (runSampler_.fastModeDisabledThisFrame) {
+            audioRateController_.reset(config_.audioTargetQueuedFrames);
+        }
         clocksInSecondPeriod_ += machine.tspec.clocks_spent - lastClocksSpent;
     }
 
@@ -289,6 +363,8 @@ auto ClemensBackend::step(ClemensCommandQueue &commands) -> ClemensCommandQueue:
     if (isMachineRunning != isRunning()) {
         if (!isMachineRunning) {
             runSampler_.reset();
+            audioRateController_.reset(config_.audioTargetQueuedFrames);
+            lastTimesliceTimePoint_ = std::chrono::high_resolution_clock::now();
         }
     }
     return result;
@@ -299,6 +375,10 @@ std::pair<ClemensAudio, bool> ClemensBackend::renderAudioFrame() {
     return out;
 }
 
+void ClemensBackend::updateAudioQueueLevel(unsigned queuedFrames) {
+    audioQueuedFrames_ = queuedFrames;
+}
+
 void ClemensBackend::post(ClemensBackendState &backendState) {
     auto &machine = GS_->getMachine();
     auto &mmio = GS_->getMMIO();
@@ -361,47 +441,102 @@ void ClemensBackend::post(ClemensBackendState &backendState) {
 #endif
 #endif
 
+//  The emulator reports the breakpoint hit by the last instruction from its
+//  breakpoint hash and watched pages (see syncBreakpoints()), which is looked up
+//  in breakpoints_ (sorted by address).  IRQ breakpoints aren't mirrored into the
+//  emulator and are checked here on interrupt entry.
 std::optional<unsigned> ClemensBackend::checkHitBreakpoint() {
     auto &machine = GS_->getMachine();
-    for (auto it = breakpoints_.begin(); it != breakpoints_.end(); ++it) {
-        uint16_t b_adr = (uint16_t)(it->address & 0xffff);
-        uint8_t b_bank = (uint8_t)(it->address >> 16);
-        unsigned index = (unsigned)(it - breakpoints_.begin());
+    if (irqBreakpoint_.has_value() && machine.cpu.state_type == kClemensCPUStateType_IRQ) {
+        return irqBreakpoint_;
+    }
+    uint32_t key = clemens_debug_breakpoint_hit(&machine);
+    if (!key)
+        return std::nullopt;
+
+    ClemensBackendBreakpoint hit{};
+    switch (key >> 24) {
+    case kClemensDebugBreakpoint_Execute:
+        hit.type = ClemensBackendBreakpoint::Execute;
+        break;
+    case kClemensDebugBreakpoint_DataRead:
+        hit.type = ClemensBackendBreakpoint::DataRead;
+        break;
+    case kClemensDebugBreakpoint_Write:
+        hit.type = ClemensBackendBreakpoint::Write;
+        break;
+    case kClemensDebugBreakpoint_BRK:
+        return brkBreakpoint_;
+    default:
+        return std::nullopt;
+    }
+    hit.address = key & 0xffffff;
+    auto range = std::equal_range(
+        breakpoints_.begin(), breakpoints_.end(), hit,
+        [](const ClemensBackendBreakpoint &bp0, const ClemensBackendBreakpoint &bp1) {
+            return bp0.address < bp1.address;
+        });
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->type == hit.type)
+            return (unsigned)(it - breakpoints_.begin());
+    }
+    return std::nullopt;
+}
+
+//  Mirrors breakpoints_ into the emulator so that only instructions that may hit
+//  one issue the debug break callback.  IRQ breakpoints are checked between
+//  runMachine() calls since interrupts always return control to the host.
+//  Breakpoints past the emulator's limit are reported and removed, so that the
+//  debugger doesn't list breakpoints that can't be hit.
+void ClemensBackend::syncBreakpoints() {
+    auto &machine = GS_->getMachine();
+    clemens_debug_clear_breakpoints(&machine);
+    irqBreakpoint_ = std::nullopt;
+    brkBreakpoint_ = std::nullopt;
+    std::stable_sort(
+        breakpoints_.begin(), breakpoints_.end(),
+        [](const ClemensBackendBreakpoint &bp0, const ClemensBackendBreakpoint &bp1) {
+            return bp0.address < bp1.address;
+        });
+    auto it = breakpoints_.begin();
+    while (it != breakpoints_.end()) {
+        bool armed = true;
         switch (it->type) {
         case ClemensBackendBreakpoint::Execute:
-            if (machine.cpu.regs.PBR == b_bank && machine.cpu.regs.PC == b_adr) {
-                return index;
-            }
+            armed = clemens_debug_add_breakpoint(&machine, kClemensDebugBreakpoint_Execute,
+                                                 it->address);
             break;
         case ClemensBackendBreakpoint::DataRead:
+            armed = clemens_debug_add_breakpoint(&machine, kClemensDebugBreakpoint_DataRead,
+                                                 it->address);
+            break;
         case ClemensBackendBreakpoint::Write:
-            if (machine.cpu.pins.bank == b_bank && machine.cpu.pins.adr == b_adr) {
-                if (machine.cpu.pins.vdaOut) {
-                    if (it->type == ClemensBackendBreakpoint::DataRead && machine.cpu.pins.rwbOut) {
-                        return index;
-                    } else if (it->type == ClemensBackendBreakpoint::Write &&
-                               !machine.cpu.pins.rwbOut) {
-                        return index;
-                    }
-                }
-            }
+            armed = clemens_debug_add_breakpoint(&machine, kClemensDebugBreakpoint_Write,
+                                                 it->address);
             break;
         case ClemensBackendBreakpoint::IRQ:
-            if (machine.cpu.state_type == kClemensCPUStateType_IRQ) {
-                return index;
+            if (!irqBreakpoint_.has_value()) {
+                irqBreakpoint_ = (unsigned)(it - breakpoints_.begin());
             }
             break;
         case ClemensBackendBreakpoint::BRK:
-            if (machine.cpu.regs.IR == CLEM_OPC_BRK) {
-                return index;
+            armed = clemens_debug_add_breakpoint(&machine, kClemensDebugBreakpoint_BRK, 0);
+            if (armed && !brkBreakpoint_.has_value()) {
+                brkBreakpoint_ = (unsigned)(it - breakpoints_.begin());
             }
             break;
         default:
-            assert(false);
             break;
         }
+        if (!armed) {
+            localLog(CLEM_DEBUG_LOG_WARN,
+                     "Breakpoint at ${:06X} removed (the limit is {} breakpoints).", it->address,
+                     CLEM_DEBUG_BREAKPOINT_LIMIT);
+            it = breakpoints_.erase(it);
+        } else {
+            ++it;
+        }
     }
-    return std::nullopt;
 }
 
 void ClemensBackend::assignPropertyToU32(MachineProperty property, uint32_t value) {
@@ -553,11 +688,14 @@ bool ClemensBackend::unserialize(const std::string &path) {
         });
     if (!gs)
         return false;
+    //  the capture belongs to the machine being replaced
+    stopBusTrace();
     GS_->unmount();
     GS_ = std::move(gs);
     updateRTC();
     GS_->mount();
     breakpoints_ = std::move(breakpoints);
+    syncBreakpoints();
     return true;
 }
 
@@ -601,8 +739,10 @@ void ClemensBackend::onClemensSystemWriteConfig(const ClemensAppleIIGS::Config &
     gsConfigUpdated_ = true;
 }
 
-//  If enabled, this emulator issues this callback per instruction
-//  This is great for debugging but should be disabled otherwise (see TODO)
+//  If enabled, the emulator issues this callback after instructions that may have hit
+//  one of the breakpoints mirrored by syncBreakpoints()
+bool ClemensBackend::onClemensDebugBreak() { return checkHitBreakpoint().has_value(); }
+
 void ClemensBackend::onClemensInstruction(struct ClemensInstruction *inst, const char *operand) {
     if (programTrace_) {
         programTrace_->addExecutedInstruction(nextTraceSeq_++, *inst, operand, GS_->getMachine());
@@ -641,18 +781,21 @@ void ClemensBackend::onCommandAddBreakpoint(const ClemensBackendBreakpoint &brea
     }
     if (range.first == range.second) {
         breakpoints_.emplace(range.second, breakpoint);
+        syncBreakpoints();
     }
 }
 
 bool ClemensBackend::onCommandRemoveBreakpoint(int index) {
     if (index < 0) {
         breakpoints_.clear();
+        syncBreakpoints();
         return true;
     }
     if (index >= (int)breakpoints_.size()) {
         return false;
     }
     breakpoints_.erase(breakpoints_.begin() + index);
+    syncBreakpoints();
     return true;
 }
 
@@ -699,7 +842,36 @@ void ClemensBackend::onCommandDebugMemoryWrite(uint16_t addr, uint8_t value) {
 
 void ClemensBackend::onCommandDebugLogLevel(int logLevel) { logLevel_ = logLevel; }
 
+void ClemensBackend::stopBusTrace() {
+    if (!busTrace_)
+        return;
+    busTrace_->stop(GS_->getMachine());
+    fmt::print("Bus trace stopped after {} cycles ({} dropped)\n", busTrace_->getRecordCount(),
+               busTrace_->getDroppedCount());
+    busTrace_ = nullptr;
+}
+
 bool ClemensBackend::onCommandDebugProgramTrace(std::string_view op, std::string_view path) {
+    //  bus capture runs independently of the program trace, toggled by 'bus'
+    if (op == "bus") {
+        if (busTrace_) {
+            stopBusTrace();
+            return true;
+        }
+        if (path.empty()) {
+            fmt::print("ERROR: bus trace requires an output file.\n");
+            return false;
+        }
+        auto exportPath = std::filesystem::path(config_.traceRootPath) / path;
+        busTrace_ = std::make_unique<ClemensBusTraceWriter>();
+        if (!busTrace_->start(GS_->getMachine(), exportPath.string().c_str())) {
+            fmt::print("ERROR: failed to open bus trace '{}'.\n", exportPath.string());
+            busTrace_ = nullptr;
+            return false;
+        }
+        fmt::print("Bus trace writing to '{}'.\n", exportPath.string());
+        return true;
+    }
     if (programTrace_ == nullptr && op == "on") {
         nextTraceSeq_ = 0;
         programTrace_ = std::make_unique<ClemensProgramTrace>();
@@ -20,6 +20,7 @@
 
 //  Forward Decls
 class ClemensProgramTrace;
+class ClemensBusTraceWriter;
 
 //
 //  ClemensRunSampler controls the execution rate of and provides metrics for the
@@ -62,6 +63,35 @@ struct ClemensRunSampler {
     void disableFastMode();
 };
 
+//
+//  ClemensAudioRateController is a PI controller that scales the emulation rate by
+//  fractions of a percent so that the host's audio queue stays near a target fill
+//  level.  This absorbs drift between the host's audio and system clocks without
+//  dropping or flushing audio.
+//
+struct ClemensAudioRateController {
+    //  the scalar never strays further than this from 1.0
+    static constexpr double kScalarLimit = 0.005;
+    static constexpr double kProportionalGain = 0.005;
+    static constexpr double kIntegralGain = 0.002;
+
+    double targetFrames;
+    double integral;
+    double scalar;
+    bool isPrimed;
+
+    ClemensAudioRateController();
+
+    //  the next update will prime the queue
+    void reset(unsigned targetQueuedFrames);
+    //  returns the frames needed to bring the queue up to the target after a reset,
+    //  where the queue may have been flushed or drained
+    unsigned prime(unsigned queuedFrames);
+    //  returns the emulation rate scalar given the queue level and the seconds since
+    //  the last update
+    double update(unsigned queuedFrames, double dt);
+};
+
 struct ClemensBackendConfig {
     int logLevel;
     std::string dataRootPath;
@@ -70,6 +100,9 @@ struct ClemensBackendConfig {
     std::string traceRootPath;
     std::vector<ClemensBackendBreakpoint> breakpoints;
     bool enableFastEmulation;
+    //  if non-zero, emulation is paced by wall clock time and nudged by the audio
+    //  queue level reported with updateAudioQueueLevel() towards this many frames
+    unsigned audioTargetQueuedFrames;
 
     enum class Type { Apple2GS };
     Type type;
@@ -96,6 +129,9 @@ class ClemensBackend : public ClemensSystemListener, ClemensCommandQueueListener
     ClemensCommandQueue::DispatchResult step(ClemensCommandQueue& commands);
     //  Obtain current audio frame (following calls to step())
     std::pair<ClemensAudio, bool> renderAudioFrame();
+    //  Report the number of frames waiting in the host's audio queue (following
+    //  renderAudioFrame())
+    void updateAudioQueueLevel(unsigned queuedFrames);
     //  Populate a backend state
     void post(ClemensBackendState& backendState);
 
@@ -118,6 +154,7 @@ class ClemensBackend : public ClemensSystemListener, ClemensCommandQueueListener
     void onClemensSystemLocalLog(int logLevel, const char *msg) final;
     void onClemensSystemWriteConfig(const ClemensAppleIIGS::Config &config) final;
     void onClemensInstruction(struct ClemensInstruction *inst, const char *operand);
+    bool onClemensDebugBreak() final;
 
     //  ClemensCommandQueueListener
     void onCommandReset() final;
@@ -150,6 +187,8 @@ class ClemensBackend : public ClemensSystemListener, ClemensCommandQueueListener
     //  internal
     bool isRunning() const;
     std::optional<unsigned> checkHitBreakpoint();
+    void syncBreakpoints();
+    void stopBusTrace();
     template <typename... Args> void localLog(int log_level, const char *msg, Args... args);
 
     bool serialize(const std::string &path, const ClemensCommandMinizPNG* pngData) const;
@@ -170,9 +209,13 @@ class ClemensBackend : public ClemensSystemListener, ClemensCommandQueueListener
     std::vector<ClemensBackendBreakpoint> breakpoints_;
     std::vector<ClemensBackendExecutedInstruction> loggedInstructions_;
     std::optional<unsigned> hitBreakpoint_;
+    //  indices into breakpoints_ of the first IRQ and BRK breakpoints
+    std::optional<unsigned> irqBreakpoint_;
+    std::optional<unsigned> brkBreakpoint_;
 
     uint64_t nextTraceSeq_;
     std::unique_ptr<ClemensProgramTrace> programTrace_;
+    std::unique_ptr<ClemensBusTraceWriter> busTrace_;
 
     int logLevel_;
     uint8_t debugMemoryPage_;
@@ -185,6 +228,10 @@ class ClemensBackend : public ClemensSystemListener, ClemensCommandQueueListener
     int64_t clocksRemainingInTimeslice_;
     uint64_t clocksInSecondPeriod_;
 
+    ClemensAudioRateController audioRateController_;
+    std::chrono::high_resolution_clock::time_point lastTimesliceTimePoint_;
+    unsigned audioQueuedFrames_;
+
     std::string clipboardText_;
     unsigned clipboardHead_;
 };
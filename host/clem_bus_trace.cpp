@@ -0,0 +1,89 @@
+#include "clem_bus_trace.hpp"
+
+#include "emulator.h"
+
+#include <chrono>
+
+namespace {
+
+constexpr char kFileMagic[8] = {'C', 'L', 'E', 'M', 'B', 'U', 'S', '\0'};
+constexpr uint32_t kFileVersion = 1;
+constexpr unsigned kDrainBatchSize = 4096;
+
+void writeU32(FILE *fp, uint32_t v) {
+    uint8_t bytes[4] = {uint8_t(v), uint8_t(v >> 8), uint8_t(v >> 16), uint8_t(v >> 24)};
+    fwrite(bytes, 1, sizeof(bytes), fp);
+}
+
+} // namespace
+
+ClemensBusTraceWriter::ClemensBusTraceWriter(unsigned capacity)
+    : fp_(nullptr), draining_(false), recordCount_(0) {
+    unsigned actualCapacity = 1;
+    while (actualCapacity < capacity) {
+        actualCapacity <<= 1;
+    }
+    records_.resize(actualCapacity);
+    clemens_bus_trace_init(&trace_, records_.data(), actualCapacity);
+}
+
+ClemensBusTraceWriter::~ClemensBusTraceWriter() {
+    //  the owner should have stopped the trace with its machine - the thread is
+    //  still shut down so it doesn't outlive the ring
+    if (drainThread_.joinable()) {
+        draining_ = false;
+        drainThread_.join();
+    }
+    if (fp_) {
+        fclose(fp_);
+    }
+}
+
+bool ClemensBusTraceWriter::start(ClemensMachine &machine, const char *filename) {
+    if (fp_)
+        return false;
+    fp_ = fopen(filename, "wb");
+    if (!fp_)
+        return false;
+    fwrite(kFileMagic, 1, sizeof(kFileMagic), fp_);
+    writeU32(fp_, kFileVersion);
+    writeU32(fp_, sizeof(ClemensBusTraceRecord));
+
+    clemens_bus_trace_init(&trace_, records_.data(), unsigned(records_.size()));
+    recordCount_ = 0;
+    draining_ = true;
+    drainThread_ = std::thread(&ClemensBusTraceWriter::drain, this);
+    clemens_bus_trace_attach(&machine, &trace_);
+    return true;
+}
+
+void ClemensBusTraceWriter::stop(ClemensMachine &machine) {
+    if (!fp_)
+        return;
+    //  detaching publishes the remaining records, which the thread drains before
+    //  exiting
+    clemens_bus_trace_attach(&machine, nullptr);
+    draining_ = false;
+    drainThread_.join();
+    fclose(fp_);
+    fp_ = nullptr;
+}
+
+void ClemensBusTraceWriter::drain() {
+    std::vector<ClemensBusTraceRecord> batch(kDrainBatchSize);
+    for (;;) {
+        //  read the flag before the ring so that the final records published by
+        //  stop() are picked up by the last pass
+        bool draining = draining_;
+        unsigned count = clemens_bus_trace_read(&trace_, batch.data(), kDrainBatchSize);
+        if (count > 0) {
+            fwrite(batch.data(), sizeof(ClemensBusTraceRecord), count, fp_);
+            recordCount_.fetch_add(count, std::memory_order_relaxed);
+        } else if (draining) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        } else {
+            break;
+        }
+    }
+    fflush(fp_);
+}
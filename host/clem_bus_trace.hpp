@@ -0,0 +1,48 @@
+#ifndef CLEM_HOST_BUS_TRACE_HPP
+#define CLEM_HOST_BUS_TRACE_HPP
+
+#include "clem_types.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+//  Captures every CPU bus cycle to a binary file.  The emulator appends records
+//  to a ring that a background thread drains, so that capture doesn't stall
+//  the emulator thread.
+//
+//  File layout
+//      8 bytes     "CLEMBUS\0"
+//      uint32      format version (1), little endian
+//      uint32      record size (sizeof(ClemensBusTraceRecord)), little endian
+//      records     ClemensBusTraceRecord as laid out in memory, until the end
+//                  of the file
+//
+class ClemensBusTraceWriter {
+  public:
+    //  capacity is in records and is rounded up to a power of two
+    explicit ClemensBusTraceWriter(unsigned capacity = 1U << 20);
+    ~ClemensBusTraceWriter();
+
+    //  These must be called from the thread running the emulator
+    bool start(ClemensMachine &machine, const char *filename);
+    void stop(ClemensMachine &machine);
+
+    bool isActive() const { return fp_ != nullptr; }
+    uint64_t getRecordCount() const { return recordCount_.load(std::memory_order_relaxed); }
+    uint32_t getDroppedCount() const { return trace_.dropped; }
+
+  private:
+    void drain();
+
+    std::vector<ClemensBusTraceRecord> records_;
+    ClemensBusTrace trace_;
+    FILE *fp_;
+    std::thread drainThread_;
+    std::atomic<bool> draining_;
+    std::atomic<uint64_t> recordCount_;
+};
+
+#endif
@@ -67,7 +67,8 @@ ClemensConfiguration findConfiguration() {
 
 ClemensConfiguration::ClemensConfiguration()
     : majorVersion(0), minorVersion(0), logLevel(CLEM_DEBUG_LOG_INFO), viewMode(ViewMode::Windowed),
-      poweredOn(false), hybridInterfaceEnabled(false), fastEmulationEnabled(true), isDirty(true) {
+      poweredOn(false), hybridInterfaceEnabled(false), fastEmulationEnabled(true),
+      audioRateControlEnabled(false), isDirty(true) {
     gs.audioSamplesPerSecond = 0;
     gs.memory = CLEM_EMULATOR_RAM_DEFAULT;
     gs.cardNames[6] = kClemensCardHardDiskName;
@@ -104,6 +105,7 @@ void ClemensConfiguration::copyFrom(const ClemensConfiguration &other) {
 
     hybridInterfaceEnabled = other.hybridInterfaceEnabled;
     fastEmulationEnabled = other.fastEmulationEnabled;
+    audioRateControlEnabled = other.audioRateControlEnabled;
     isDirty = true;
 }
 
@@ -133,9 +135,11 @@ bool ClemensConfiguration::save() {
                "[emulator]\n"
                "romfile={}\n"
                "fastiwm={}\n"
+               "audioratecontrol={}\n"
                "gs.ramkb={}\n"
                "gs.audio_samples={}\n",
-               romFilename, fastEmulationEnabled ? 1 : 0, gs.memory, gs.audioSamplesPerSecond);
+               romFilename, fastEmulationEnabled ? 1 : 0, audioRateControlEnabled ? 1 : 0,
+               gs.memory, gs.audioSamplesPerSecond);
     for (unsigned i = 0; i < (unsigned)gs.diskImagePaths.size(); i++) {
         auto driveType = static_cast<ClemensDriveType>(i);
         fmt::print(fp, "gs.disk.{}={}\n", ClemensDiskUtilities::getDriveName(driveType),
@@ -203,6 +207,8 @@ int ClemensConfiguration::handler(void *user, const char *section, const char *n
             config->romFilename = value;
         } else if (strncmp(name, "fastiwm", 16) == 0) {
             config->fastEmulationEnabled = atoi(value) > 0;
+        } else if (strncmp(name, "audioratecontrol", 32) == 0) {
+            config->audioRateControlEnabled = atoi(value) > 0;
         } else if (strncmp(name, "gs.ramkb", 16) == 0) {
             config->gs.memory = (unsigned)atoi(value);
         } else if (strncmp(name, "gs.audio_samples", 32) == 0) {
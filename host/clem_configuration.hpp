@@ -53,6 +53,9 @@ struct ClemensConfiguration {
     ClemensAppleIIGSConfig gs;
 
     bool fastEmulationEnabled;
+    //  paces emulation by the audio queue's fill level, which allows a smaller
+    //  (lower latency) audio buffer
+    bool audioRateControlEnabled;
 
     ClemensConfiguration();
     ClemensConfiguration(std::string pathname, std::string datadir);
@@ -1310,6 +1310,9 @@ void ClemensDebugger::cmdTrace(std::string_view operand) {
                 CLEM_TERM_COUT.format(Info, "Trace will be saved to {}", path);
             }
         }
+    } else if (params[0] == "bus") {
+        //  toggles capture of every bus cycle to a binary file, apart from tracing
+        CLEM_TERM_COUT.print(Info, "Toggling bus trace.");
     } else if (frameState_->isTracing) {
         if (params[0] == "iwm") {
             if (frameState_->isIWMTracing) {
@@ -1616,6 +1619,8 @@ void ClemensDebugger::cmdHelp(std::string_view operand) {
                                "     <filename>, {bin|hex}    output format");
     CLEM_TERM_COUT.print(Info,
                          "trace {on|off},<pathname>   - toggle program tracing and output to file");
+    CLEM_TERM_COUT.print(Info,
+                         "trace bus,<pathname>        - toggle binary capture of all bus cycles");
     CLEM_TERM_COUT.print(
         Info, "save <pathname>             - saves a snapshot into the snapshots folder");
     CLEM_TERM_COUT.print(
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <iterator>
 
 void ClemensBackendState::reset() {
     config.reset();
@@ -135,8 +136,7 @@ void ADBStatus::copyFrom(ClemensMMIO &mmio) {
     }
 }
 
-void FrameState::copyState(const ClemensBackendState &state, LastCommandState &commandState,
-                           cinek::FixedStack &frameMemory) {
+void FrameState::copyState(const ClemensBackendState &state, cinek::FixedStack &frameMemory) {
     frameMemory.reset();
 
     emulatorClock.ts = state.machine->tspec.clocks_spent;
@@ -225,54 +225,11 @@ void FrameState::copyState(const ClemensBackendState &state, LastCommandState &c
 
     breakpointCount = (unsigned)(state.bpBufferEnd - state.bpBufferStart);
     breakpoints = frameMemory.allocateArray<ClemensBackendBreakpoint>(breakpointCount);
-
-    auto *bpDest = breakpoints;
-    for (auto *bpCur = state.bpBufferStart; bpCur != state.bpBufferEnd; ++bpCur, ++bpDest) {
-        *bpDest = *bpCur;
-        if (state.bpHitIndex.has_value() && !commandState.hitBreakpoint.has_value()) {
-            if (unsigned(bpCur - state.bpBufferStart) == *state.bpHitIndex) {
-                commandState.hitBreakpoint = *state.bpHitIndex;
-            }
-        }
-    }
+    std::copy(state.bpBufferStart, state.bpBufferEnd, breakpoints);
 
     logLevel = state.logLevel;
-    for (auto *logItem = state.logBufferStart; logItem != state.logBufferEnd; ++logItem) {
-        LogOutputNode *logMemory = reinterpret_cast<LogOutputNode *>(frameMemory.allocate(
-            sizeof(LogOutputNode) + CK_ALIGN_SIZE_TO_ARCH(logItem->text.size())));
-        logMemory->logLevel = logItem->level;
-        logMemory->sz = unsigned(logItem->text.size());
-        logItem->text.copy(reinterpret_cast<char *>(logMemory) + sizeof(LogOutputNode),
-                           std::string::npos);
-        logMemory->next = nullptr;
-        if (!commandState.logNode) {
-            commandState.logNode = logMemory;
-        } else {
-            commandState.logNodeTail->next = logMemory;
-        }
-        commandState.logNodeTail = logMemory;
-    }
-
-    if (state.logInstructionStart != state.logInstructionEnd) {
-        size_t instructionCount = state.logInstructionEnd - state.logInstructionStart;
-        LogInstructionNode *logInstMemory = reinterpret_cast<LogInstructionNode *>(
-            frameMemory.allocate(sizeof(LogInstructionNode)));
-        logInstMemory->begin =
-            frameMemory.allocateArray<ClemensBackendExecutedInstruction>(instructionCount);
-        logInstMemory->end = logInstMemory->begin + instructionCount;
-        logInstMemory->next = nullptr;
-        memcpy(logInstMemory->begin, state.logInstructionStart,
-               instructionCount * sizeof(ClemensBackendExecutedInstruction));
-        if (!commandState.logInstructionNode) {
-            commandState.logInstructionNode = logInstMemory;
-        } else {
-            commandState.logInstructionNodeTail->next = logInstMemory;
-        }
-        commandState.logInstructionNodeTail = logInstMemory;
-    }
-
-    commandState.isFastEmulationOn = state.fastEmulationOn;
-    commandState.isFastModeOn = state.fastModeEnabled;
+    isFastEmulationOn = state.fastEmulationOn;
+    isFastModeOn = state.fastModeEnabled;
 
     machineSpeedMhz = state.machineSpeedMhz;
     emulationSpeedMhz = state.emulationSpeedMhz;
@@ -290,9 +247,78 @@ void FrameState::copyState(const ClemensBackendState &state, LastCommandState &c
     if (state.message.has_value()) {
         fmt::print("debug message: {}\n", *state.message);
     }
+}
+
+bool FrameEvents::isEmpty() const {
+    return results.empty() && logs.empty() && instructions.empty() && !hitBreakpoint.has_value() &&
+           !gsConfig.has_value();
+}
+
+void FrameEvents::clear() {
+    results.clear();
+    logs.clear();
+    instructions.clear();
+    hitBreakpoint.reset();
+    gsConfig.reset();
+}
+
+void FrameEvents::append(const ClemensBackendState &state) {
+    if (state.bpHitIndex.has_value() && !hitBreakpoint.has_value()) {
+        if (*state.bpHitIndex < unsigned(state.bpBufferEnd - state.bpBufferStart)) {
+            hitBreakpoint = *state.bpHitIndex;
+        }
+    }
+    logs.insert(logs.end(), state.logBufferStart, state.logBufferEnd);
+    instructions.insert(instructions.end(), state.logInstructionStart, state.logInstructionEnd);
     if (state.config.has_value()) {
-        commandState.gsConfig = state.config;
+        gsConfig = state.config;
+    }
+}
+
+void LastCommandState::append(FrameEvents &events, cinek::FixedStack &eventMemory) {
+    std::move(events.results.begin(), events.results.end(), std::back_inserter(results));
+    if (events.hitBreakpoint.has_value() && !hitBreakpoint.has_value()) {
+        hitBreakpoint = events.hitBreakpoint;
+    }
+    if (events.gsConfig.has_value()) {
+        gsConfig = std::move(events.gsConfig);
+    }
+
+    for (auto &logItem : events.logs) {
+        LogOutputNode *logMemory = reinterpret_cast<LogOutputNode *>(eventMemory.allocate(
+            sizeof(LogOutputNode) + CK_ALIGN_SIZE_TO_ARCH(logItem.text.size())));
+        logMemory->logLevel = logItem.level;
+        logMemory->sz = unsigned(logItem.text.size());
+        logItem.text.copy(reinterpret_cast<char *>(logMemory) + sizeof(LogOutputNode),
+                          std::string::npos);
+        logMemory->next = nullptr;
+        if (!logNode) {
+            logNode = logMemory;
+        } else {
+            logNodeTail->next = logMemory;
+        }
+        logNodeTail = logMemory;
     }
+
+    if (!events.instructions.empty()) {
+        size_t instructionCount = events.instructions.size();
+        LogInstructionNode *logInstMemory = reinterpret_cast<LogInstructionNode *>(
+            eventMemory.allocate(sizeof(LogInstructionNode)));
+        logInstMemory->begin =
+            eventMemory.allocateArray<ClemensBackendExecutedInstruction>(instructionCount);
+        logInstMemory->end = logInstMemory->begin + instructionCount;
+        logInstMemory->next = nullptr;
+        memcpy(logInstMemory->begin, events.instructions.data(),
+               instructionCount * sizeof(ClemensBackendExecutedInstruction));
+        if (!logInstructionNode) {
+            logInstructionNode = logInstMemory;
+        } else {
+            logInstructionNodeTail->next = logInstMemory;
+        }
+        logInstructionNodeTail = logInstMemory;
+    }
+
+    events.clear();
 }
 
 } // namespace ClemensFrame
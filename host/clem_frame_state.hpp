@@ -121,6 +121,21 @@ struct ADBStatus {
     void copyFrom(ClemensMMIO &mmio);
 };
 
+//  Events raised by the backend since its last published frame.  These are
+//  queued to the UI separately from FrameState so that none are lost when the UI
+//  skips frames.
+struct FrameEvents {
+    std::vector<ClemensBackendResult> results;
+    std::vector<ClemensBackendOutputText> logs;
+    std::vector<ClemensBackendExecutedInstruction> instructions;
+    std::optional<unsigned> hitBreakpoint;
+    std::optional<ClemensAppleIIGSConfig> gsConfig;
+
+    bool isEmpty() const;
+    void clear();
+    void append(const ClemensBackendState &state);
+};
+
 //  This state sticks around until processed by the UI frame - a hacky solution
 //  to the problem mentioned with FrameState.  In some cases we want to know
 //  when an event happened (command failed, termination, breakpoint hit, etc)
@@ -135,6 +150,8 @@ struct LastCommandState {
     LogInstructionNode *logInstructionNodeTail = nullptr;
     bool isFastEmulationOn = false;
     bool isFastModeOn = false;
+
+    void append(FrameEvents &events, cinek::FixedStack &eventMemory);
 };
 
 // This state comes in for any update to the emulator per frame.  As such
@@ -174,9 +191,10 @@ struct FrameState {
     bool isTracing = false;
     bool isIWMTracing = false;
     bool isRunning = false;
+    bool isFastEmulationOn = false;
+    bool isFastModeOn = false;
 
-    void copyState(const ClemensBackendState &state, LastCommandState &commandState,
-                   cinek::FixedStack &frameMemory);
+    void copyState(const ClemensBackendState &state, cinek::FixedStack &frameMemory);
 };
 } // namespace ClemensFrame
 
@@ -39,11 +39,13 @@
 
 #include <cfloat>
 #include <charconv>
+#include <chrono>
 #include <cmath>
 #include <filesystem>
+#include <iterator>
 #include <memory>
-#include <mutex>
 #include <optional>
+#include <thread>
 #include <tuple>
 
 #include "cinek/equation.inl"
@@ -137,6 +139,12 @@ constexpr double kMachineFrameDuration = 1.0 / 60.00;
 //  Kept this value here since I think it's better UX
 constexpr float kClemensRebootDelayDuration = 1.0f;
 
+//  With audio rate control, the host audio buffer can be much smaller since the
+//  emulator keeps the queue feeding it a few buffers ahead
+constexpr unsigned kAudioBufferFrames = 2048;
+constexpr unsigned kAudioRateControlBufferFrames = 512;
+constexpr unsigned kAudioRateControlTargetBuffers = 3;
+
 //  TODO: move into clemens library
 struct ClemensIODescriptor {
     char readLabel[16];
@@ -590,9 +598,9 @@ ClemensFrontend::ClemensFrontend(ClemensConfiguration &config,
                                  const cinek::ByteBuffer &systemFontHiBuffer)
     : config_(config), displayProvider_(systemFontLoBuffer, systemFontHiBuffer),
       display_(displayProvider_), audio_(), logLevel_(CLEM_DEBUG_LOG_INFO),
-      dtEmulatorNextUpdateInterval_(0.0), frameSeqNo_(kFrameSeqNoInvalid),
-      frameLastSeqNo_(kFrameSeqNoInvalid),
-      frameReadMemory_(kFrameMemorySize, malloc(kFrameMemorySize)), lastFrameCPUPins_{},
+      dtEmulatorNextUpdateInterval_(0.0), framePublishedIndex_(1), frameWriteIndex_(0),
+      frameReadIndex_(2), frameSeqNo_(kFrameSeqNoInvalid),
+      frameEventMemory_(kFrameMemorySize, malloc(kFrameMemorySize)), lastFrameCPUPins_{},
       lastFrameCPURegs_{}, lastFrameIWM_{}, lastFrameIRQs_(0), lastFrameNMIs_(0),
       emulatorShouldHaveKeyboardFocus_(false), emulatorHasKeyboardFocus_(false),
       emulatorHasMouseFocus_(false), mouseInEmulatorScreen_(false),
@@ -601,6 +609,10 @@ ClemensFrontend::ClemensFrontend(ClemensConfiguration &config,
       helpMode_(HelpMode::None), appTime_(0.0), nextUIFlashCycleAppTime_(0.0), uiFlashAlpha_(1.0f),
       debugger_(backendQueue_, *this), settingsView_(config_) {
 
+    for (auto &frameBuffer : frameBuffers_) {
+        frameBuffer.memory = cinek::FixedStack(kFrameMemorySize, malloc(kFrameMemorySize));
+    }
+
     ClemensTraceExecutedInstruction::initialize();
 
     clem_temp_generate_ascii_to_adb_table();
@@ -608,7 +620,8 @@ ClemensFrontend::ClemensFrontend(ClemensConfiguration &config,
     initDebugIODescriptors();
     clem_joystick_open_devices(CLEM_HOST_JOYSTICK_PROVIDER_DEFAULT);
 
-    audio_.start();
+    audio_.start(config_.audioRateControlEnabled ? kAudioRateControlBufferFrames
+                                                 : kAudioBufferFrames);
     if (config_.gs.audioSamplesPerSecond == 0) {
         config_.gs.audioSamplesPerSecond = audio_.getAudioFrequency();
     }
@@ -638,7 +651,10 @@ ClemensFrontend::~ClemensFrontend() {
     config_.poweredOn = poweredOn;
     config_.save();
 
-    free(frameReadMemory_.getHead());
+    for (auto &frameBuffer : frameBuffers_) {
+        free(frameBuffer.memory.getHead());
+    }
+    free(frameEventMemory_.getHead());
 }
 
 void ClemensFrontend::input(ClemensInputEvent input) {
@@ -694,6 +710,10 @@ void ClemensFrontend::startBackend() {
     backendConfig.traceRootPath =
         (std::filesystem::path(config_.dataDirectory) / CLEM_HOST_TRACES_DIR).string();
     backendConfig.enableFastEmulation = config_.fastEmulationEnabled;
+    backendConfig.audioTargetQueuedFrames =
+        config_.audioRateControlEnabled
+            ? kAudioRateControlBufferFrames * kAudioRateControlTargetBuffers
+            : 0;
     backendConfig.logLevel = logLevel_;
     backendConfig.type = ClemensBackendConfig::Type::Apple2GS;
     backendConfig.breakpoints = debugger_.copyBreakpoints();
@@ -711,7 +731,14 @@ void ClemensFrontend::startBackend() {
 
 void ClemensFrontend::runBackend(std::unique_ptr<ClemensBackend> backend) {
     ClemensCommandQueue::DispatchResult results{};
-    backendState_.reset();
+    ClemensCommandQueue commands;
+    ClemensBackendState backendState;
+    ClemensFrame::FrameEvents pendingEvents;
+    uint64_t seqNo = 0;
+
+    const auto frameDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(kMachineFrameDuration));
+    auto nextFrameTimePoint = std::chrono::steady_clock::now();
 
 #ifdef CLEMENS_HOST_PROFILE_ENABLED
     std::chrono::high_resolution_clock::time_point f_start;
@@ -721,17 +748,32 @@ void ClemensFrontend::runBackend(std::unique_ptr<ClemensBackend> backend) {
 #endif
 
     while (!results.second) {
-        std::unique_lock<std::mutex> lk(frameMutex_);
-        backend->post(backendState_);
-        std::copy(results.first.begin(), results.first.end(),
-                  std::back_inserter(lastCommandState_.results));
-        frameSeqNo_++;
-        readyForFrame_.wait(lk, [this]() { return frameLastSeqNo_ == frameSeqNo_; });
-        lk.unlock();
+        backendState.reset();
+        backend->post(backendState);
+
+        //  events are queued before their frame is published so that the UI has them
+        //  once it picks up the frame.  if the UI has fallen behind, they're held
+        //  here until there's room.
+        std::move(results.first.begin(), results.first.end(),
+                  std::back_inserter(pendingEvents.results));
+        pendingEvents.append(backendState);
+        if (!pendingEvents.isEmpty() && frameEvents_.push(std::move(pendingEvents))) {
+            pendingEvents.clear();
+        }
+        publishBackendFrame(backendState, ++seqNo);
+
+        //  a slot is released only when all of its commands have been taken
+        while (!stagedBackendQueues_.isEmpty()) {
+            auto &stagedCommands = stagedBackendQueues_.at(0);
+            commands.queue(stagedCommands);
+            if (!stagedCommands.isEmpty())
+                break;
+            stagedBackendQueues_.pop();
+        }
 #ifdef CLEMENS_HOST_PROFILE_ENABLED
         f_start = std::chrono::high_resolution_clock::now();
 #endif
-        results = backend->step(stagedBackendQueue_);
+        results = backend->step(commands);
 #ifdef CLEMENS_HOST_PROFILE_ENABLED
         f_end = std::chrono::high_resolution_clock::now();
         f_cumulative += (f_end - f_start);
@@ -749,9 +791,20 @@ void ClemensFrontend::runBackend(std::unique_ptr<ClemensBackend> backend) {
         // sync audio
         auto audioFrame = backend->renderAudioFrame();
         audio_.queue(audioFrame.first, audioFrame.second);
+        backend->updateAudioQueueLevel(audio_.getQueuedFrameCount());
+
+        //  the backend paces itself at the machine frame rate.  frames that ran
+        //  late aren't caught up.
+        nextFrameTimePoint += frameDuration;
+        auto frameTimePoint = std::chrono::steady_clock::now();
+        if (nextFrameTimePoint > frameTimePoint) {
+            std::this_thread::sleep_until(nextFrameTimePoint);
+        } else {
+            nextFrameTimePoint = frameTimePoint;
+        }
     }
 
-    std::lock_guard<std::mutex> lk(frameMutex_);
+    //  stopBackend() picks this up once the thread has been joined
     ClemensAppleIIGSConfig config;
     if (backend->queryConfig(config)) {
         lastCommandState_.gsConfig = config;
@@ -760,11 +813,23 @@ void ClemensFrontend::runBackend(std::unique_ptr<ClemensBackend> backend) {
     }
 }
 
+void ClemensFrontend::publishBackendFrame(const ClemensBackendState &backendState,
+                                          uint64_t seqNo) {
+    auto &frameBuffer = frameBuffers_[frameWriteIndex_];
+    frameBuffer.state.copyState(backendState, frameBuffer.memory);
+    frameBuffer.seqNo = seqNo;
+    frameWriteIndex_ = framePublishedIndex_.exchange(frameWriteIndex_ | kFrameBufferFresh,
+                                                     std::memory_order_acq_rel) &
+                       kFrameBufferIndexMask;
+}
+
 void ClemensFrontend::stopBackend() {
     if (backendThread_.joinable()) {
         backendQueue_.terminate();
-        syncBackend(false);
-        readyForFrame_.notify_one();
+        while (!backendQueue_.isEmpty()) {
+            syncBackend(false);
+            std::this_thread::yield();
+        }
         backendThread_.join();
     }
     backendThread_ = std::thread();
@@ -871,7 +936,6 @@ auto ClemensFrontend::frame(int width, int height, double deltaTime, ClemensHost
     dtEmulatorNextUpdateInterval_ -= deltaTime;
     if (dtEmulatorNextUpdateInterval_ <= 0.0) {
         isNewFrame = syncBackend(true);
-        readyForFrame_.notify_one();
         dtEmulatorNextUpdateInterval_ =
             std::max(0.0, dtEmulatorNextUpdateInterval_ + kMachineFrameDuration);
     }
@@ -1149,14 +1213,10 @@ void ClemensFrontend::setGUIMode(GUIMode guiMode) {
 }
 
 bool ClemensFrontend::syncBackend(bool copyState) {
-    //  check if a new frame of data is available.  if none available, we'll
+    //  pick up the latest frame published by the backend.  if none available, we'll
     //  wait another UI frame (slow emulator)
     bool newFrame = false;
-    std::lock_guard<std::mutex> frameLock(frameMutex_);
-    if (frameLastSeqNo_ != frameSeqNo_ && copyState) {
-        //  new frame data located in the write frame, obtained from the
-        //  backendState_ which is guaranteed to remain untouched until
-        //  the last frame sequence number is updated.
+    if (copyState && (framePublishedIndex_.load(std::memory_order_relaxed) & kFrameBufferFresh)) {
         debugger_.lastFrame(frameReadState_);
 
         lastFrameCPURegs_ = frameReadState_.cpu.regs;
@@ -1169,8 +1229,23 @@ bool ClemensFrontend::syncBackend(bool copyState) {
             memcpy(lastFrameIORegs_, frameReadState_.ioPage, 256);
         }
 
-        frameReadState_.copyState(backendState_, lastCommandState_, frameReadMemory_);
-        backendState_.reset();
+        //  the previous read buffer goes back to the backend, so frameReadState_ must
+        //  not be referenced until it's replaced below
+        frameReadIndex_ =
+            framePublishedIndex_.exchange(frameReadIndex_, std::memory_order_acq_rel) &
+            kFrameBufferIndexMask;
+        auto &frameBuffer = frameBuffers_[frameReadIndex_];
+        frameReadState_ = frameBuffer.state;
+        frameSeqNo_ = frameBuffer.seqNo;
+
+        //  log nodes from the last sync were consumed by the debugger
+        frameEventMemory_.reset();
+        ClemensFrame::FrameEvents events;
+        while (frameEvents_.pop(events)) {
+            lastCommandState_.append(events, frameEventMemory_);
+        }
+        lastCommandState_.isFastEmulationOn = frameReadState_.isFastEmulationOn;
+        lastCommandState_.isFastModeOn = frameReadState_.isFastModeOn;
 
         if (debugger_.thisFrame(lastCommandState_, frameReadState_)) {
             emulatorHasMouseFocus_ = false;
@@ -1193,8 +1268,14 @@ bool ClemensFrontend::syncBackend(bool copyState) {
         newFrame = true;
     }
 
-    stagedBackendQueue_.queue(backendQueue_);
-    frameLastSeqNo_ = frameSeqNo_;
+    //  if all slots are taken, commands remain in the backendQueue until next time
+    if (!backendQueue_.isEmpty()) {
+        auto *stagedCommands = stagedBackendQueues_.acquireTail();
+        if (stagedCommands) {
+            stagedCommands->queue(backendQueue_);
+            stagedBackendQueues_.push();
+        }
+    }
     return newFrame;
 }
 
@@ -1938,6 +2019,15 @@ void ClemensFrontend::doMachineDiagnosticsDisplay() {
     unsigned seconds = ((emulatorTime % 3600000) % 60000) / 1000;
     unsigned milliseconds = ((emulatorTime % 3600000) % 60000) % 1000;
     ImGui::Text("%02u:%02u:%02u.%01u", hours, minutes, seconds, milliseconds);
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted("");
+    ImGui::TableNextColumn();
+    ImGui::Text("AUD");
+    ImGui::TableNextColumn();
+    ImGui::Text("%llu under, %llu over",
+                (unsigned long long)audio_.getUnderrunFrameCount(),
+                (unsigned long long)audio_.getOverrunFrameCount());
     ImGui::EndTable();
 }
 
@@ -18,6 +18,7 @@
 #include "clem_ui_settings.hpp"
 
 #include "cinek/buffer.hpp"
+#include "cinek/circular_buffer.hpp"
 #include "cinek/equation.hpp"
 #include "cinek/fixedstack.hpp"
 #include "clem_audio.hpp"
@@ -25,10 +26,9 @@
 #include "imgui.h"
 
 #include <array>
-#include <condition_variable>
+#include <atomic>
 #include <deque>
 #include <memory>
-#include <mutex>
 #include <optional>
 #include <thread>
 #include <vector>
@@ -70,6 +70,7 @@ class ClemensFrontend : public ClemensHostView, ClemensDebuggerListener {
     void runBackend(std::unique_ptr<ClemensBackend> backend);
     void stopBackend();
     bool syncBackend(bool copyState);
+    void publishBackendFrame(const ClemensBackendState &backendState, uint64_t seqNo);
     bool isBackendRunning() const;
 
     //  the backend state delegate is run on a separate thread and notifies
@@ -120,40 +121,50 @@ class ClemensFrontend : public ClemensHostView, ClemensDebuggerListener {
 
     ClemensDisplay display_;
     ClemensAudioDevice audio_;
-    ClemensBackendState backendState_;
     ClemensCommandQueue::DispatchResult backendCommandResutls_;
 
     std::unique_ptr<ClemensBackend> backend_;
     int logLevel_;
 
     //  Handles synchronization between the emulator and the UI(main) thread
-    //  The backendQueue is filled by the UI.  It will "stage" these commands
-    //  every UI frame and report its timestamp.
+    //  The backendQueue is filled by the UI.  Every UI frame, it's moved into a
+    //  slot in stagedBackendQueues_, which the worker drains before stepping the
+    //  emulator.  If the worker falls behind, commands wait in the backendQueue.
     //
-    //  The worker will handle commands as long as the frameTimestamp changes.
-    //  It uses this timestamp to make sure it doesn't emulate frames beyond
-    //  those that are needed to keep in sync with the UI.  This should more or
-    //  less work with fast emulation enabled, since frames are reported back to
-    //  the frontend based on the UI's framerate using this counter.
+    //  The worker runs at its own cadence (kMachineFrameDuration) and publishes
+    //  each emulated frame without waiting on the UI, which always picks up the
+    //  latest complete frame.  Neither thread blocks on the other.
     std::thread backendThread_;
     ClemensCommandQueue backendQueue_;
-    ClemensCommandQueue stagedBackendQueue_;
+    cinek::CircularBuffer<ClemensCommandQueue, 4> stagedBackendQueues_;
     double dtEmulatorNextUpdateInterval_;
 
-    // These counters are used to identify unique frames between the two threads
-    // frameSeqNo is updated per executed emulator frame.  The UI thread will
-    // check frameSeqNo against frameLastSeqNo during the synchronization phase
-    // and if they differ, then the UI has data for a new emulator state.
-    uint64_t frameSeqNo_, frameLastSeqNo_;
+    //  Frames are published through a triple buffer.  The worker fills its write
+    //  buffer and exchanges it with the published one, marking it fresh.  The UI
+    //  exchanges its read buffer with the published one only when it's fresh.
+    //  Each buffer owns the frame memory its FrameState points into.
+    struct FrameBuffer {
+        cinek::FixedStack memory;
+        ClemensFrame::FrameState state;
+        uint64_t seqNo = 0;
+    };
+    static constexpr unsigned kFrameBufferIndexMask = 0x3;
+    static constexpr unsigned kFrameBufferFresh = 0x4;
+    std::array<FrameBuffer, 3> frameBuffers_;
+    std::atomic<unsigned> framePublishedIndex_;
+    unsigned frameWriteIndex_; // owned by the worker
+    unsigned frameReadIndex_;  // owned by the UI
+
+    //  Events raised per frame (logs, command results, etc) are queued so that
+    //  they reach the UI even when it skips frames.  The worker accumulates them
+    //  while the queue is full.
+    cinek::CircularBuffer<ClemensFrame::FrameEvents, 8> frameEvents_;
+
+    // frameSeqNo is the sequence number of the last frame picked up by the UI.
+    uint64_t frameSeqNo_;
     static const uint64_t kFrameSeqNoInvalid;
 
-    // Synchronization - UI thread will notify the emulator of new commands and
-    // timestamp.  The worker will wait until the timestamp changes and
-    // execute frames to maintain sync with the UI thread.
-    std::condition_variable readyForFrame_;
-    std::mutex frameMutex_;
-
-    cinek::FixedStack frameReadMemory_;
+    cinek::FixedStack frameEventMemory_;
     ClemensFrame::FrameState frameReadState_;
     ClemensFrame::LastCommandState lastCommandState_;
     cinek::ByteBuffer thisFrameAudioBuffer_;
@@ -545,6 +545,24 @@ auto ClemensAppleIIGS::stepMachine() -> ResultFlags {
     return resultFlags;
 }
 
+auto ClemensAppleIIGS::runMachine() -> ResultFlags {
+    auto resultFlags = ResultFlags::None;
+    auto vblStarted = mmio_.vgc.vbl_started;
+
+    clemens_emulate_cpu_until(&machine_, clemens_mmio_next_event_ts(&mmio_));
+    clemens_emulate_mmio(&machine_, &mmio_);
+
+    if (clemens_is_resetting(&machine_)) {
+        resultFlags = resultFlags | ResultFlags::Resetting;
+    }
+    if (vblStarted && !mmio_.vgc.vbl_started) {
+        resultFlags = resultFlags | ResultFlags::VerticalBlank;
+    }
+    status_ = machine_.cpu.enabled ? Status::Online : Status::Offline;
+
+    return resultFlags;
+}
+
 ClemensAudio ClemensAppleIIGS::renderAudio() {
     ClemensAudio audio{};
     if (clemens_get_audio(&audio, &mmio_)) {
@@ -582,6 +600,7 @@ void ClemensAppleIIGS::finishFrame(Frame &frame) {
     if (!isOk())
         return;
     clemens_audio_next_frame(&mmio_, frame.audio.frame_count);
+    clemens_video_next_frame(&machine_);
 }
 
 void ClemensAppleIIGS::enableOpcodeLogging(bool enable) {
@@ -595,6 +614,16 @@ void ClemensAppleIIGS::emulatorOpcodeCallback(struct ClemensInstruction *inst, c
     host->listener_.onClemensInstruction(inst, operand);
 }
 
+void ClemensAppleIIGS::enableDebugBreak(bool enable) {
+    clemens_debug_break_callback(&machine_,
+                                 enable ? &ClemensAppleIIGS::emulatorDebugBreakCallback : NULL);
+}
+
+bool ClemensAppleIIGS::emulatorDebugBreakCallback(void *this_ptr) {
+    auto *host = reinterpret_cast<ClemensAppleIIGS *>(this_ptr);
+    return host->listener_.onClemensDebugBreak();
+}
+
 unsigned ClemensAppleIIGS::consume_utf8_input(const char *in, const char *inEnd) {
     const char *cur = clemens_clipboard_push_utf8_atom(&mmio_, in, inEnd);
     return (unsigned)(cur - in);
@@ -78,6 +78,9 @@ class ClemensAppleIIGS {
     void input(const ClemensInputEvent &input);
     //  Executes a single emulation step
     ResultFlags stepMachine();
+    //  Executes CPU instructions until the next scheduled device event, an I/O
+    //  access, an interrupt or a debugger break, then syncs devices once
+    ResultFlags runMachine();
     //  Render current audio frame.  This will not advance the audio frame buffer
     //  which is done by finishFrame().  This should be done after rendering a sufficient number 
     //  of 'frames' - which may be VBL frames, or whatever the application decides
@@ -91,6 +94,9 @@ class ClemensAppleIIGS {
     void saveConfig();
     //  Enables opcode logging
     void enableOpcodeLogging(bool enable);
+    //  Enables breakpoint checks while running via runMachine().  Breakpoints are
+    //  added to the machine with clemens_debug_add_breakpoint()
+    void enableDebugBreak(bool enable);
     //  Sends a UTF8 character from the input stream
     unsigned consume_utf8_input(const char* in, const char* inEnd);
     //  Performs batch memory operations on the GS using current memory/IO settings
@@ -108,6 +114,7 @@ class ClemensAppleIIGS {
     static uint8_t *unserializerAllocateHook(unsigned type, unsigned sz, void *context);
     static void emulatorOpcodeCallback(struct ClemensInstruction *inst, const char *operand,
                                        void *this_ptr);
+    static bool emulatorDebugBreakCallback(void *this_ptr);
 
     template <typename... Args> void localLog(int log_level, const char *msg, Args... args);
 
@@ -141,6 +148,7 @@ class ClemensSystemListener {
     virtual void onClemensSystemLocalLog(int logLevel, const char *msg) = 0;
     virtual void onClemensSystemWriteConfig(const ClemensAppleIIGS::Config &config) = 0;
     virtual void onClemensInstruction(struct ClemensInstruction *inst, const char *operand) = 0;
+    virtual bool onClemensDebugBreak() = 0;
 };
 
 inline ClemensAppleIIGS::ResultFlags operator|(ClemensAppleIIGS::ResultFlags l,
@@ -270,6 +270,8 @@ void ClemensTestHarness::onClemensInstruction(struct ClemensInstruction *inst,
     fmt::print(execColor, "[{:<16}][EXEC  ] {} {}\n", execCounter_, inst->desc->name, operand);
 }
 
+bool ClemensTestHarness::onClemensDebugBreak() { return false; }
+
 void ClemensTestHarness::onClemensSystemMachineLog(int logLevel, const ClemensMachine *,
                                                    const char *msg) {
     fmt::print(logLevel >= CLEM_DEBUG_LOG_WARN ? stderr : stdout, "[{:<16}][CLEM ] {}\n",
@@ -23,6 +23,7 @@ class ClemensTestHarness : public ClemensSystemListener {
     void onClemensSystemLocalLog(int logLevel, const char *msg) final;
     void onClemensSystemWriteConfig(const ClemensAppleIIGS::Config &config) final;
     void onClemensInstruction(struct ClemensInstruction *inst, const char *operand) final;
+    bool onClemensDebugBreak() final;
 
   private:
     bool reset();
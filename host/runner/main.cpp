@@ -0,0 +1,127 @@
+#include "runner.hpp"
+
+#include "core/clem_disk_utils.hpp"
+
+#include "fmt/format.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+static constexpr double kDefaultSecondsLimit = 10.0;
+
+static void printUsage(const char *exeName) {
+    fmt::print(stderr,
+               "usage: {} [options]\n"
+               "  --rom <path>            ROM image (required without --snapshot)\n"
+               "  --snapshot <path>       start from a snapshot instead of a reset\n"
+               "  --disk <drive>=<path>   insert a disk (s5d1, s5d2, s6d1, s6d2)\n"
+               "  --smartport <path>      assign a SmartPort disk (new machines only)\n"
+               "  --ram <kb>              RAM size (default {})\n"
+               "  --seconds <n>           emulated seconds to run\n"
+               "  --vbls <n>              emulated vertical blanks to run\n"
+               "  --audio <path>          write audio to a 32-bit float WAV file\n"
+               "  --audio-rate <hz>       audio frames per second (default {})\n"
+               "  --save <path>           save a snapshot when the run completes\n"
+               "The run ends at the first limit reached.  Without limits, {} seconds are run.\n",
+               exeName, ClemensHeadlessRunner::Config().memory,
+               ClemensHeadlessRunner::Config().audioSamplesPerSecond, kDefaultSecondsLimit);
+}
+
+static bool parseDisk(ClemensHeadlessRunner::Config &config, std::string_view param) {
+    auto sepPos = param.find('=');
+    if (sepPos == std::string_view::npos)
+        return false;
+    auto driveType = ClemensDiskUtilities::getDriveType(param.substr(0, sepPos));
+    if (driveType == kClemensDrive_Invalid)
+        return false;
+    config.diskImagePaths[driveType] = std::string(param.substr(sepPos + 1));
+    return true;
+}
+
+int main(int argc, const char *argv[]) {
+    ClemensHeadlessRunner::Config config;
+    unsigned smartPortCount = 0;
+
+    for (int argIndex = 1; argIndex < argc; ++argIndex) {
+        std::string_view option = argv[argIndex];
+        if (option == "--help" || option == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (argIndex + 1 >= argc) {
+            fmt::print(stderr, "Argument {} expects a value.\n", option);
+            return 1;
+        }
+        const char *value = argv[++argIndex];
+        bool valueOk = true;
+        if (option == "--rom") {
+            config.romPath = value;
+        } else if (option == "--snapshot") {
+            config.snapshotPath = value;
+        } else if (option == "--disk") {
+            valueOk = parseDisk(config, value);
+        } else if (option == "--smartport") {
+            valueOk = smartPortCount < kClemensSmartPortDiskLimit;
+            if (valueOk) {
+                config.smartPortImagePaths[smartPortCount++] = value;
+            }
+        } else if (option == "--ram") {
+            config.memory = (unsigned)strtoul(value, nullptr, 10);
+            valueOk = config.memory > 0;
+        } else if (option == "--seconds") {
+            config.emulatedSecondsLimit = strtod(value, nullptr);
+            valueOk = config.emulatedSecondsLimit > 0.0;
+        } else if (option == "--vbls") {
+            config.vblLimit = strtoull(value, nullptr, 10);
+            valueOk = config.vblLimit > 0;
+        } else if (option == "--audio") {
+            config.audioPath = value;
+        } else if (option == "--audio-rate") {
+            config.audioSamplesPerSecond = (unsigned)strtoul(value, nullptr, 10);
+            valueOk = config.audioSamplesPerSecond > 0;
+        } else if (option == "--save") {
+            config.saveSnapshotPath = value;
+        } else {
+            fmt::print(stderr, "Unknown argument {}.\n", option);
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (!valueOk) {
+            fmt::print(stderr, "Invalid value {} for argument {}.\n", value, option);
+            return 1;
+        }
+    }
+    if (config.romPath.empty() && config.snapshotPath.empty()) {
+        fmt::print(stderr, "A ROM is required to start a new machine.\n");
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (config.emulatedSecondsLimit <= 0.0 && config.vblLimit == 0) {
+        config.emulatedSecondsLimit = kDefaultSecondsLimit;
+    }
+
+    ClemensHeadlessRunner runner(config);
+    if (!runner.run()) {
+        fmt::print(stderr, "FAILED\n");
+        return 1;
+    }
+
+    auto &stats = runner.getStats();
+    double emulatedMhz = stats.hostSeconds > 0.0 ? stats.cycles / (stats.hostSeconds * 1e6) : 0.0;
+    double speedRatio = stats.hostSeconds > 0.0 ? stats.emulatedSeconds / stats.hostSeconds : 0.0;
+    fmt::print("vbls:             {}\n", stats.vbls);
+    fmt::print("emulated time:    {:.3f} s\n", stats.emulatedSeconds);
+    fmt::print("host time:        {:.3f} s\n", stats.hostSeconds);
+    fmt::print("cycles:           {}\n", stats.cycles);
+    fmt::print("emulated speed:   {:.3f} MHz ({:.2f}x realtime)\n", emulatedMhz, speedRatio);
+    if (!config.audioPath.empty()) {
+        fmt::print("audio frames:     {}\n", stats.audioFrames);
+    }
+
+    if (!config.saveSnapshotPath.empty() && !runner.save()) {
+        fmt::print(stderr, "FAILED\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,250 @@
+#include "runner.hpp"
+
+#include "core/clem_apple2gs.hpp"
+#include "core/clem_snapshot.hpp"
+
+#include "emulator.h"
+#include "emulator_mmio.h"
+
+#include "external/mpack.h"
+#include "fmt/format.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+constexpr clem_clocks_time_t kClocksPerSecond =
+    1e9 * CLEM_CLOCKS_14MHZ_CYCLE / CLEM_14MHZ_CYCLE_NS;
+
+//  RIFF WAVE header for 32-bit float stereo - sizes are patched in when the
+//  file is closed.
+constexpr unsigned kWAVHeaderSize = 44;
+constexpr unsigned kWAVFormatFloat = 3;
+constexpr unsigned kWAVChannelCount = 2;
+
+void writeU32(uint8_t *out, uint32_t v) {
+    out[0] = uint8_t(v & 0xff);
+    out[1] = uint8_t((v >> 8) & 0xff);
+    out[2] = uint8_t((v >> 16) & 0xff);
+    out[3] = uint8_t((v >> 24) & 0xff);
+}
+
+void writeU16(uint8_t *out, uint16_t v) {
+    out[0] = uint8_t(v & 0xff);
+    out[1] = uint8_t((v >> 8) & 0xff);
+}
+
+void writeWAVHeader(FILE *fp, unsigned framesPerSecond, uint64_t frameCount) {
+    constexpr unsigned kBytesPerFrame = kWAVChannelCount * sizeof(float);
+    uint8_t header[kWAVHeaderSize];
+    uint32_t dataSize = uint32_t(frameCount * kBytesPerFrame);
+    memcpy(header, "RIFF", 4);
+    writeU32(header + 4, 36 + dataSize);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    writeU32(header + 16, 16);
+    writeU16(header + 20, kWAVFormatFloat);
+    writeU16(header + 22, kWAVChannelCount);
+    writeU32(header + 24, framesPerSecond);
+    writeU32(header + 28, framesPerSecond * kBytesPerFrame);
+    writeU16(header + 32, kBytesPerFrame);
+    writeU16(header + 34, sizeof(float) * 8);
+    memcpy(header + 36, "data", 4);
+    writeU32(header + 40, dataSize);
+    fwrite(header, sizeof(header), 1, fp);
+}
+
+} // namespace
+
+ClemensHeadlessRunner::ClemensHeadlessRunner(const Config &config)
+    : config_(config), audioFile_(nullptr), failed_(false) {
+    clemens_register();
+
+    if (!config_.snapshotPath.empty()) {
+        failed_ = !load(config_.snapshotPath);
+    } else if (!std::ifstream(config_.romPath, std::ios::binary).is_open()) {
+        //  the machine would otherwise run a stub ROM in its place
+        localLog(CLEM_DEBUG_LOG_FATAL, "ROM {} could not be opened.", config_.romPath);
+        failed_ = true;
+    } else {
+        ClemensAppleIIGS::Config gsConfig{};
+        gsConfig.memory = config_.memory;
+        //  the mixer is disabled unless audio is written
+        gsConfig.audioSamplesPerSecond =
+            config_.audioPath.empty() ? 0 : config_.audioSamplesPerSecond;
+        gsConfig.diskImagePaths = config_.diskImagePaths;
+        gsConfig.smartPortImagePaths = config_.smartPortImagePaths;
+        //  a SmartPort disk requires the hard drive card, as with the emulator
+        //  defaults
+        gsConfig.cardNames[6] = kClemensCardHardDiskName;
+        a2gs_ = std::make_unique<ClemensAppleIIGS>(config_.romPath, gsConfig, *this);
+        if (a2gs_->isOk()) {
+            a2gs_->mount();
+            a2gs_->reset();
+        } else {
+            localLog(CLEM_DEBUG_LOG_FATAL, "Machine failed to initialize.");
+            failed_ = true;
+        }
+    }
+}
+
+ClemensHeadlessRunner::~ClemensHeadlessRunner() {
+    closeAudioFile();
+    if (a2gs_) {
+        a2gs_->unmount();
+    }
+}
+
+bool ClemensHeadlessRunner::load(const std::string &path) {
+    ClemensSnapshot snapshot(path);
+    //  the emulator's debugger state is skipped
+    a2gs_ = snapshot.unserialize(*this, [](mpack_reader_t *reader, ClemensAppleIIGS &) -> bool {
+        mpack_discard(reader);
+        return mpack_reader_error(reader) == mpack_ok;
+    });
+    if (!a2gs_) {
+        localLog(CLEM_DEBUG_LOG_FATAL, "Snapshot {} failed to load.", path);
+        return false;
+    }
+    a2gs_->mount();
+    //  disks named on the command line replace the ones in the snapshot
+    for (unsigned driveIndex = 0; driveIndex < kClemensDrive_Count; ++driveIndex) {
+        auto &imagePath = config_.diskImagePaths[driveIndex];
+        if (imagePath.empty())
+            continue;
+        auto driveType = static_cast<ClemensDriveType>(driveIndex);
+        a2gs_->getStorage().ejectDisk(a2gs_->getMMIO(), driveType);
+        if (!a2gs_->getStorage().insertDisk(a2gs_->getMMIO(), driveType, imagePath)) {
+            localLog(CLEM_DEBUG_LOG_FATAL, "Disk {} failed to insert.", imagePath);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ClemensHeadlessRunner::run() {
+    if (failed_)
+        return false;
+    if (!config_.audioPath.empty() && !openAudioFile()) {
+        failed_ = true;
+        return false;
+    }
+
+    auto &machine = a2gs_->getMachine();
+    ClemensAppleIIGS::Frame frame;
+    auto clocksLimit = clem_clocks_time_t(config_.emulatedSecondsLimit * kClocksPerSecond);
+    clem_clocks_time_t clocksSpent = 0;
+    auto startTimePoint = std::chrono::steady_clock::now();
+
+    stats_ = Stats();
+    machine.cpu.cycles_spent = 0;
+    while (a2gs_->getStatus() != ClemensAppleIIGS::Status::Stopped) {
+        if (config_.vblLimit > 0 && stats_.vbls >= config_.vblLimit)
+            break;
+        if (clocksLimit > 0 && clocksSpent >= clocksLimit)
+            break;
+        auto batchClocksSpent = machine.tspec.clocks_spent;
+        auto result = a2gs_->runMachine();
+        if (!test(result, ClemensAppleIIGS::ResultFlags::Resetting)) {
+            clocksSpent += machine.tspec.clocks_spent - batchClocksSpent;
+        }
+        if (!test(result, ClemensAppleIIGS::ResultFlags::VerticalBlank))
+            continue;
+
+        //  each VBL is a frame as far as the host is concerned.  no video is
+        //  rendered, but disks and the audio buffer are serviced as the emulator's
+        //  frontend does.
+        if (audioFile_) {
+            writeAudio(a2gs_->renderAudio());
+        }
+        a2gs_->getFrame(frame);
+        a2gs_->finishFrame(frame);
+        stats_.cycles += machine.cpu.cycles_spent;
+        machine.cpu.cycles_spent = 0;
+        ++stats_.vbls;
+    }
+    stats_.cycles += machine.cpu.cycles_spent;
+    machine.cpu.cycles_spent = 0;
+
+    stats_.hostSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTimePoint).count();
+    stats_.emulatedSeconds = double(clocksSpent) / kClocksPerSecond;
+
+    closeAudioFile();
+    return true;
+}
+
+bool ClemensHeadlessRunner::save() {
+    if (failed_)
+        return false;
+    ClemensSnapshot snapshot(config_.saveSnapshotPath);
+    //  written so that the emulator can load this snapshot (no breakpoints)
+    bool success = snapshot.serialize(*a2gs_, ClemensSnapshotPNG{},
+                                      [](mpack_writer_t *writer, ClemensAppleIIGS &) -> bool {
+                                          mpack_start_map(writer, 1);
+                                          mpack_write_cstr(writer, "breakpoints");
+                                          mpack_start_array(writer, 0);
+                                          mpack_finish_array(writer);
+                                          mpack_finish_map(writer);
+                                          return mpack_writer_error(writer) == mpack_ok;
+                                      });
+    if (!success) {
+        localLog(CLEM_DEBUG_LOG_FATAL, "Snapshot {} failed to save.", config_.saveSnapshotPath);
+    }
+    return success;
+}
+
+bool ClemensHeadlessRunner::openAudioFile() {
+    audioFile_ = fopen(config_.audioPath.c_str(), "wb");
+    if (!audioFile_) {
+        localLog(CLEM_DEBUG_LOG_FATAL, "Audio file {} could not be opened.", config_.audioPath);
+        return false;
+    }
+    writeWAVHeader(audioFile_, a2gs_->getMMIO().dev_audio.mix_buffer.frames_per_second, 0);
+    return true;
+}
+
+void ClemensHeadlessRunner::writeAudio(const ClemensAudio &audio) {
+    if (!audio.frame_count)
+        return;
+    //  the mix buffer is always 32-bit float stereo, as with the WAV
+    const uint8_t *audioIn = audio.data + audio.frame_start * audio.frame_stride;
+    fwrite(audioIn, audio.frame_stride, audio.frame_count, audioFile_);
+    stats_.audioFrames += audio.frame_count;
+}
+
+void ClemensHeadlessRunner::closeAudioFile() {
+    if (!audioFile_)
+        return;
+    fseek(audioFile_, 0, SEEK_SET);
+    writeWAVHeader(audioFile_, a2gs_->getMMIO().dev_audio.mix_buffer.frames_per_second,
+                   stats_.audioFrames);
+    fclose(audioFile_);
+    audioFile_ = nullptr;
+}
+
+template <typename... Args>
+void ClemensHeadlessRunner::localLog(int logLevel, const char *msg, Args... args) {
+    auto text = fmt::format(msg, args...);
+    onClemensSystemLocalLog(logLevel, text.c_str());
+}
+
+void ClemensHeadlessRunner::onClemensSystemMachineLog(int logLevel, const ClemensMachine *,
+                                                      const char *msg) {
+    if (logLevel < CLEM_DEBUG_LOG_WARN)
+        return;
+    fmt::print(stderr, "[CLEM ] {}\n", msg);
+}
+
+void ClemensHeadlessRunner::onClemensSystemLocalLog(int logLevel, const char *msg) {
+    if (logLevel < CLEM_DEBUG_LOG_WARN)
+        return;
+    fmt::print(stderr, "[A2GS ] {}\n", msg);
+}
+
+void ClemensHeadlessRunner::onClemensSystemWriteConfig(const ClemensAppleIIGS::Config &) {}
+
+void ClemensHeadlessRunner::onClemensInstruction(struct ClemensInstruction *, const char *) {}
+
+bool ClemensHeadlessRunner::onClemensDebugBreak() { return false; }
@@ -0,0 +1,72 @@
+#ifndef CLEM_HOST_RUNNER_HPP
+#define CLEM_HOST_RUNNER_HPP
+
+#include "core/clem_apple2gs.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+//  Runs the emulator without a display or audio device as fast as the host
+//  allows.  Used for batch regression runs and benchmarking.
+class ClemensHeadlessRunner : public ClemensSystemListener {
+  public:
+    struct Config {
+        std::string romPath;
+        std::string snapshotPath;
+        std::array<std::string, kClemensDrive_Count> diskImagePaths;
+        std::array<std::string, kClemensSmartPortDiskLimit> smartPortImagePaths;
+        unsigned memory = 4096;
+        //  the run ends at whichever limit is reached first (0 = no limit)
+        double emulatedSecondsLimit = 0.0;
+        uint64_t vblLimit = 0;
+        //  optional outputs (empty = disabled)
+        std::string audioPath;
+        std::string saveSnapshotPath;
+        unsigned audioSamplesPerSecond = 48000;
+    };
+
+    struct Stats {
+        uint64_t vbls = 0;
+        uint64_t cycles = 0;
+        uint64_t audioFrames = 0;
+        double emulatedSeconds = 0.0;
+        double hostSeconds = 0.0;
+    };
+
+    ClemensHeadlessRunner(const Config &config);
+    ~ClemensHeadlessRunner();
+
+    bool hasFailed() const { return failed_; }
+
+    bool run();
+    bool save();
+
+    const Stats &getStats() const { return stats_; }
+
+  private:
+    void onClemensSystemMachineLog(int logLevel, const ClemensMachine *machine,
+                                   const char *msg) final;
+    void onClemensSystemLocalLog(int logLevel, const char *msg) final;
+    void onClemensSystemWriteConfig(const ClemensAppleIIGS::Config &config) final;
+    void onClemensInstruction(struct ClemensInstruction *inst, const char *operand) final;
+    bool onClemensDebugBreak() final;
+
+  private:
+    bool load(const std::string &path);
+    bool openAudioFile();
+    void writeAudio(const ClemensAudio &audio);
+    void closeAudioFile();
+
+    template <typename... Args> void localLog(int logLevel, const char *msg, Args... args);
+
+    Config config_;
+    std::unique_ptr<ClemensAppleIIGS> a2gs_;
+    FILE *audioFile_;
+    Stats stats_;
+    bool failed_;
+};
+
+#endif
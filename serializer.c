@@ -914,6 +914,7 @@ mpack_reader_t *clemens_unserialize_machine(mpack_reader_t *reader, ClemensMachi
     mpack_done_map(reader);
 
     memset(&machine->mem.bank_page_map, 0, sizeof(machine->mem.bank_page_map));
+    memset(machine->mem.mega2_dirty_pages, 0xff, sizeof(machine->mem.mega2_dirty_pages));
 
     return reader;
 }
@@ -0,0 +1,103 @@
+/*  CPU dispatch benchmark
+
+    Runs a synthetic 16-bit workload (load, shift, add and store over a 4K
+    table) on an otherwise empty Apple IIgs, and reports instructions per second
+    for the two host loops:
+
+    step:   clemens_emulate_cpu() and clemens_emulate_mmio() per instruction
+    batch:  clemens_emulate_cpu_until() to the next MMIO event
+
+    Usage: bench_cpu [seconds of emulated time, default 10]
+*/
+#include "emulator.h"
+#include "emulator_mmio.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_ROM_BANK_COUNT 2
+#define BENCH_RAM_BANK_COUNT 4
+
+static const uint8_t bench_program[] = {
+    0x18,             /* F000 CLC             */
+    0xFB,             /* F001 XCE             */
+    0xC2, 0x30,       /* F002 REP #$30        */
+    0xA2, 0x00, 0x00, /* F004 LDX #$0000      */
+    0xBD, 0x00, 0x20, /* F007 LDA $2000,X     */
+    0x0A,             /* F00A ASL             */
+    0x7D, 0x00, 0x30, /* F00B ADC $3000,X     */
+    0x9D, 0x00, 0x20, /* F00E STA $2000,X     */
+    0xE8,             /* F011 INX             */
+    0xE8,             /* F012 INX             */
+    0xE0, 0x00, 0x10, /* F013 CPX #$1000      */
+    0xD0, 0xEF,       /* F016 BNE $F007       */
+    0xA2, 0x00, 0x00, /* F018 LDX #$0000      */
+    0x4C, 0x07, 0xF0  /* F01B JMP $F007       */
+};
+
+struct BenchMachine {
+    ClemensMachine machine;
+    ClemensMMIO mmio;
+};
+
+static void bench_setup(struct BenchMachine *bench, uint8_t *rom) {
+    memset(bench, 0, sizeof(*bench));
+    clemens_init(&bench->machine, CLEM_CLOCKS_PHI0_CYCLE, CLEM_CLOCKS_PHI2_FAST_CYCLE, rom,
+                 BENCH_ROM_BANK_COUNT, calloc(1, CLEM_IIGS_BANK_SIZE),
+                 calloc(1, CLEM_IIGS_BANK_SIZE), calloc(BENCH_RAM_BANK_COUNT, CLEM_IIGS_BANK_SIZE),
+                 BENCH_RAM_BANK_COUNT);
+    clem_mmio_init(&bench->mmio, &bench->machine.dev_debug, bench->machine.mem.bank_page_map,
+                   calloc(7, 2048), BENCH_RAM_BANK_COUNT, BENCH_ROM_BANK_COUNT,
+                   bench->machine.mem.mega2_bank_map[0], bench->machine.mem.mega2_bank_map[1],
+                   &bench->machine.tspec);
+    bench->machine.cpu.pins.resbIn = false;
+    bench->machine.resb_counter = 3;
+}
+
+static void bench_report(const char *name, unsigned long long instructions, clock_t start) {
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("%-6s %12llu instructions %8.3f s %8.2f M instructions/s\n", name, instructions,
+           seconds, seconds > 0.0 ? instructions / seconds / 1e6 : 0.0);
+}
+
+int main(int argc, char *argv[]) {
+    static struct BenchMachine bench;
+    uint8_t *rom = calloc(BENCH_ROM_BANK_COUNT, CLEM_IIGS_BANK_SIZE);
+    uint8_t *rom_ff = rom + CLEM_IIGS_BANK_SIZE * (BENCH_ROM_BANK_COUNT - 1);
+    double emulated_seconds = argc > 1 ? atof(argv[1]) : 10.0;
+    clem_clocks_time_t duration;
+    unsigned long long instructions;
+    clock_t start;
+
+    clemens_register();
+    memcpy(rom_ff + 0xF000, bench_program, sizeof(bench_program));
+    rom_ff[0xFFFC] = 0x00;
+    rom_ff[0xFFFD] = 0xF0;
+
+    //  one 14.318MHz reference cycle is CLEM_CLOCKS_14MHZ_CYCLE clocks
+    duration = (clem_clocks_time_t)(emulated_seconds * 14318180.0) * CLEM_CLOCKS_14MHZ_CYCLE;
+
+    bench_setup(&bench, rom);
+    instructions = 0;
+    start = clock();
+    while (bench.machine.tspec.clocks_spent < duration) {
+        clemens_emulate_cpu(&bench.machine);
+        clemens_emulate_mmio(&bench.machine, &bench.mmio);
+        ++instructions;
+    }
+    bench_report("step", instructions, start);
+
+    bench_setup(&bench, rom);
+    instructions = 0;
+    start = clock();
+    while (bench.machine.tspec.clocks_spent < duration) {
+        instructions += clemens_emulate_cpu_until(&bench.machine,
+                                                  clemens_mmio_next_event_ts(&bench.mmio));
+        clemens_emulate_mmio(&bench.machine, &bench.mmio);
+    }
+    bench_report("batch", instructions, start);
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include "clem_device.h"
+#include "clem_mmio_defs.h"
+#include "clem_mmio_types.h"
+#include "unity.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//  The DOC steps its oscillators analytically through long syncs and runs short
+//  syncs cycle by cycle.  Syncing randomized DOC states in large steps must leave
+//  the same oscillator state, interrupts and mixed audio as syncing them one
+//  Mega II cycle at a time.
+
+#define TEST_AUDIO_FRAME_COUNT 1024
+
+static struct ClemensDeviceAudio glu;
+static struct ClemensDeviceAudio ref_glu;
+static float mix_frames[TEST_AUDIO_FRAME_COUNT * 2];
+static float ref_mix_frames[TEST_AUDIO_FRAME_COUNT * 2];
+
+static uint32_t seed;
+
+static uint32_t fixture_random(void) {
+    seed = seed * 1664525 + 1013904223;
+    return seed >> 8;
+}
+
+static void fixture_randomize(struct ClemensDeviceAudio *audio, unsigned frames_per_second) {
+    struct ClemensDeviceEnsoniq *doc = &audio->doc;
+    unsigned osc_index, i;
+    uint8_t ctl;
+
+    memset(audio, 0, sizeof(*audio));
+    audio->mix_buffer.frames_per_second = frames_per_second;
+    audio->mix_buffer.frame_count = TEST_AUDIO_FRAME_COUNT;
+    audio->mix_buffer.stride = 2 * sizeof(float);
+    audio->volume = 15;
+    clem_sound_reset(audio);
+
+    for (i = 0; i < sizeof(doc->sound_ram); ++i) {
+        //  zero bytes halt oscillators, so they're kept rare
+        doc->sound_ram[i] = (fixture_random() & 0x7f) ? (uint8_t)(fixture_random() | 1) : 0;
+    }
+    doc->reg[CLEM_ENSONIQ_REG_OSC_ENABLE] = (uint8_t)((fixture_random() % 33) * 2);
+    for (osc_index = 0; osc_index < 32; ++osc_index) {
+        //  low frequencies leave the mix unchanged for many passes
+        if (fixture_random() & 1) {
+            doc->reg[CLEM_ENSONIQ_REG_OSC_FCLOW + osc_index] = (uint8_t)(fixture_random() & 0x3f);
+            doc->reg[CLEM_ENSONIQ_REG_OSC_FCHI + osc_index] = 0;
+        } else {
+            doc->reg[CLEM_ENSONIQ_REG_OSC_FCLOW + osc_index] = (uint8_t)fixture_random();
+            doc->reg[CLEM_ENSONIQ_REG_OSC_FCHI + osc_index] = (uint8_t)(fixture_random() & 0x0f);
+        }
+        doc->reg[CLEM_ENSONIQ_REG_OSC_VOLUME + osc_index] = (uint8_t)fixture_random();
+        doc->reg[CLEM_ENSONIQ_REG_OSC_DATA + osc_index] = (uint8_t)fixture_random();
+        doc->reg[CLEM_ENSONIQ_REG_OSC_PTR + osc_index] = (uint8_t)fixture_random();
+        doc->reg[CLEM_ENSONIQ_REG_OSC_SIZE + osc_index] = (uint8_t)(fixture_random() & 0x3f);
+        ctl = (uint8_t)(fixture_random() & 0xfe);
+        if (!(fixture_random() & 3)) {
+            ctl |= CLEM_ENSONIQ_OSC_CTL_HALT;
+        }
+        doc->reg[CLEM_ENSONIQ_REG_OSC_CTRL + osc_index] = ctl;
+        doc->acc[osc_index] = fixture_random() & 0x00ffffff;
+        doc->ptr[osc_index] = (uint16_t)fixture_random();
+    }
+    //  the oscillator order restarts when the cycle counter wraps
+    doc->cycle = (fixture_random() & 1) ? fixture_random() : 0U - (fixture_random() & 0xfff);
+    doc->dt_budget = fixture_random() % CLEM_CLOCKS_PHI0_CYCLE;
+}
+
+static void fixture_check(unsigned trial, clem_clocks_time_t ts) {
+    struct ClemensDeviceEnsoniq *doc = &glu.doc;
+    struct ClemensDeviceEnsoniq *ref_doc = &ref_glu.doc;
+    char msg[64];
+
+    snprintf(msg, sizeof(msg), "trial %u ts %llu", trial, (unsigned long long)ts);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(ref_doc->cycle, doc->cycle, msg);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(ref_doc->dt_budget, doc->dt_budget, msg);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(ref_doc->reg, doc->reg, sizeof(doc->reg), msg);
+    TEST_ASSERT_EQUAL_HEX32_ARRAY_MESSAGE(ref_doc->acc, doc->acc, 32, msg);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY_MESSAGE(ref_doc->ptr, doc->ptr, 32, msg);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(ref_doc->osc_flags, doc->osc_flags, 32, msg);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(ref_doc->osc_stack, doc->osc_stack, 32, msg);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(ref_glu.irq_line, glu.irq_line, msg);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(ref_glu.mix_frame_index, glu.mix_frame_index, msg);
+    if (ref_glu.mix_frame_index > 0) {
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(ref_mix_frames, mix_frames,
+                                         ref_glu.mix_frame_index * 2 * sizeof(float), msg);
+    }
+}
+
+static void fixture_compare(unsigned trial, unsigned frames_per_second) {
+    const clem_clocks_time_t ts_end = 8 * CLEM_CLOCKS_PHI0_CYCLE * 1023;
+    struct ClemensClock clock, ref_clock;
+    clem_clocks_time_t next_ts;
+    char msg[64];
+
+    fixture_randomize(&glu, frames_per_second);
+    glu.mix_buffer.data = (uint8_t *)mix_frames;
+    memcpy(&ref_glu, &glu, sizeof(ref_glu));
+    ref_glu.mix_buffer.data = (uint8_t *)ref_mix_frames;
+    memset(mix_frames, 0, sizeof(mix_frames));
+    memset(ref_mix_frames, 0, sizeof(ref_mix_frames));
+
+    clock.ts = 0;
+    clock.ref_step = CLEM_CLOCKS_PHI0_CYCLE;
+    ref_clock = clock;
+    while (clock.ts < ts_end) {
+        clock.ts += CLEM_CLOCKS_PHI0_CYCLE * (1 + fixture_random() % 2048);
+        if (clock.ts > ts_end) {
+            clock.ts = ts_end;
+        }
+        clem_sound_glu_sync(&glu, &clock);
+        //  the reference is stepped one Mega II cycle at a time, and no interrupt
+        //  may occur before the time it was predicted
+        while (ref_clock.ts < clock.ts) {
+            next_ts = ref_glu.irq_line ? 0 : clem_sound_glu_next_event_ts(&ref_glu);
+            ref_clock.ts += CLEM_CLOCKS_PHI0_CYCLE;
+            clem_sound_glu_sync(&ref_glu, &ref_clock);
+            if (ref_glu.irq_line && ref_clock.ts < next_ts) {
+                snprintf(msg, sizeof(msg), "trial %u interrupt at %llu before %llu", trial,
+                         (unsigned long long)ref_clock.ts, (unsigned long long)next_ts);
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+        fixture_check(trial, clock.ts);
+    }
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_clem_doc_sync_matches_cycle_steps(void) {
+    unsigned trial;
+    seed = 0x5eed0d0c;
+    for (trial = 0; trial < 200; ++trial) {
+        fixture_compare(trial, 0);
+    }
+}
+
+void test_clem_doc_mix_matches_cycle_steps(void) {
+    unsigned trial;
+    seed = 0x0d0c5eed;
+    for (trial = 0; trial < 200; ++trial) {
+        fixture_compare(trial, 48000);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_clem_doc_sync_matches_cycle_steps);
+    RUN_TEST(test_clem_doc_mix_matches_cycle_steps);
+    return UNITY_END();
+}
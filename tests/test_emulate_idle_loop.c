@@ -0,0 +1,100 @@
+#include "emulator.h"
+#include "emulator_mmio.h"
+#include "unity.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+//  A loop polling an I/O register without side effects is fast-forwarded by
+//  clemens_emulate_cpu_until() to its deadline.  The result must match running
+//  every iteration, which a debug break callback forces.
+
+#define TEST_ROM_BANK_COUNT 2
+#define TEST_RAM_BANK_COUNT 4
+
+static const uint8_t kKeyboardPoll[] = {
+    0xAD, 0x00, 0xC0, /* F000 LDA $C000       */
+    0x10, 0xFB,       /* F003 BPL $F000       */
+    0x80, 0xFE        /* F005 BRA $F005       */
+};
+
+struct TestMachine {
+    ClemensMachine machine;
+    ClemensMMIO mmio;
+};
+
+static struct TestMachine test_machine;
+static struct TestMachine ref_machine;
+static uint8_t *rom;
+
+static bool fixture_debug_break(void *user_ptr) {
+    (void)user_ptr;
+    return false;
+}
+
+static void fixture_setup(struct TestMachine *test) {
+    memset(test, 0, sizeof(*test));
+    clemens_init(&test->machine, CLEM_CLOCKS_PHI0_CYCLE, CLEM_CLOCKS_PHI2_FAST_CYCLE, rom,
+                 TEST_ROM_BANK_COUNT, calloc(1, CLEM_IIGS_BANK_SIZE),
+                 calloc(1, CLEM_IIGS_BANK_SIZE), calloc(TEST_RAM_BANK_COUNT, CLEM_IIGS_BANK_SIZE),
+                 TEST_RAM_BANK_COUNT);
+    clem_mmio_init(&test->mmio, &test->machine.dev_debug, test->machine.mem.bank_page_map,
+                   calloc(7, 2048), TEST_RAM_BANK_COUNT, TEST_ROM_BANK_COUNT,
+                   test->machine.mem.mega2_bank_map[0], test->machine.mem.mega2_bank_map[1],
+                   &test->machine.tspec);
+    test->machine.cpu.pins.resbIn = false;
+    test->machine.resb_counter = 3;
+    //  run the reset sequence up to the first instruction
+    while (!test->machine.cpu.pins.resbIn ||
+           test->machine.cpu.state_type != kClemensCPUStateType_Execute) {
+        clemens_emulate_cpu(&test->machine);
+        clemens_emulate_mmio(&test->machine, &test->mmio);
+    }
+}
+
+void setUp(void) {
+    uint8_t *rom_ff;
+    rom = calloc(TEST_ROM_BANK_COUNT, CLEM_IIGS_BANK_SIZE);
+    rom_ff = rom + CLEM_IIGS_BANK_SIZE * (TEST_ROM_BANK_COUNT - 1);
+    memcpy(rom_ff + 0xF000, kKeyboardPoll, sizeof(kKeyboardPoll));
+    rom_ff[0xFFFC] = 0x00;
+    rom_ff[0xFFFD] = 0xF0;
+    clemens_register();
+    fixture_setup(&test_machine);
+    fixture_setup(&ref_machine);
+    clemens_debug_break_callback(&ref_machine.machine, &fixture_debug_break);
+}
+
+void tearDown(void) {}
+
+void test_clem_idle_loop_io_poll(void) {
+    //  one frame of 262 scanlines of 65 PHI0 cycles, with no key pressed
+    clem_clocks_time_t deadline =
+        test_machine.machine.tspec.clocks_spent + 262 * 65 * CLEM_CLOCKS_PHI0_CYCLE;
+    unsigned ref_steps, steps;
+
+    TEST_ASSERT_EQUAL_HEX16(0xF000, test_machine.machine.cpu.regs.PC);
+    steps = clemens_emulate_cpu_until(&test_machine.machine, deadline);
+    ref_steps = clemens_emulate_cpu_until(&ref_machine.machine, deadline);
+
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(deadline, test_machine.machine.tspec.clocks_spent);
+    TEST_ASSERT_EQUAL_UINT64(ref_machine.machine.tspec.clocks_spent,
+                             test_machine.machine.tspec.clocks_spent);
+    TEST_ASSERT_EQUAL_UINT64(ref_machine.machine.tspec.clocks_next_phi0,
+                             test_machine.machine.tspec.clocks_next_phi0);
+    TEST_ASSERT_EQUAL_UINT(ref_machine.machine.tspec.mega2_scanline_ctr,
+                           test_machine.machine.tspec.mega2_scanline_ctr);
+    TEST_ASSERT_EQUAL_UINT32(ref_machine.machine.cpu.cycles_spent,
+                             test_machine.machine.cpu.cycles_spent);
+    TEST_ASSERT_EQUAL_MEMORY(&ref_machine.machine.cpu.regs, &test_machine.machine.cpu.regs,
+                             sizeof(test_machine.machine.cpu.regs));
+    //  the polling reads didn't return control to the host on each iteration,
+    //  and most of the iterations were skipped
+    TEST_ASSERT_LESS_THAN_UINT(ref_steps / 8, steps);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_clem_idle_loop_io_poll);
+    return UNITY_END();
+}
@@ -214,6 +214,28 @@ void test_clem_gameport_paddle_23(void) {
                          CLEM_GAMEPORT_PADDLE_AXIS_VALUE_MAX);
 }
 
+void test_clem_gameport_paddle_long_sync(void) {
+    struct ClemensInputEvent input;
+    uint8_t result;
+
+    input.type = kClemensInputType_Paddle;
+    input.value_a = CLEM_GAMEPORT_PADDLE_AXIS_VALUE_MAX;
+    input.value_b = CLEM_GAMEPORT_PADDLE_AXIS_VALUE_MAX;
+    input.gameport_button_mask = CLEM_GAMEPORT_BUTTON_MASK_JOYSTICK_0;
+    clem_adb_device_input(&adb_device, &input);
+    clem_adb_read_switch(&adb_device, CLEM_MMIO_REG_PTRIG, 0);
+    result = clem_adb_read_switch(&adb_device, CLEM_MMIO_REG_PADDL0, 0);
+    TEST_ASSERT_BIT_HIGH(7, result);
+
+    //  a sync after an interval longer than 32 bits of clocks must still time out
+    //  the paddle
+    emulator_ref_ts += (1ULL << 32) + CLEM_CLOCKS_PHI0_CYCLE;
+    gameport_sync(0);
+    TEST_ASSERT_EQUAL_UINT32(0, _test_util_get_paddle_time_ns(0));
+    result = clem_adb_read_switch(&adb_device, CLEM_MMIO_REG_PADDL0, 0);
+    TEST_ASSERT_BIT_LOW(7, result);
+}
+
 int main(void) {
     UNITY_BEGIN();
     RUN_TEST(test_clem_gameport_reset);
@@ -221,5 +243,6 @@ int main(void) {
     RUN_TEST(test_clem_gameport_buttons_23);
     RUN_TEST(test_clem_gameport_paddle_01);
     RUN_TEST(test_clem_gameport_paddle_23);
+    RUN_TEST(test_clem_gameport_paddle_long_sync);
     return UNITY_END();
 }
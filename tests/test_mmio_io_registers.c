@@ -0,0 +1,654 @@
+#include "clem_types.h"
+#include "unity.h"
+
+#include "clem_debug.h"
+#include "clem_mmio.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//  I/O registers are dispatched through per-register handler tables.  Each
+//  register is read and written from a fresh reset.  The values read, which
+//  accesses took a Mega II cycle, the number of messages logged and a panel of
+//  status registers after each access are compared against values recorded
+//  with the switch statements that the handler tables replaced.
+
+#define TEST_STATUS_COUNT 25
+#define TEST_PANEL_COUNT  6
+
+struct RegisterTrace {
+    uint8_t reads[4];                //  no-op read, read, two reads after the writes
+    uint8_t mega2;                   //  bits 0-1 reads, 2-5 writes, 6-7 final reads
+    uint8_t logs;                    //  messages logged
+    uint8_t status[TEST_PANEL_COUNT][TEST_STATUS_COUNT];
+    uint32_t mmap[TEST_PANEL_COUNT]; //  mmap_register with each panel
+};
+
+//  A status register or memory map value that differs from the reset panel after
+//  an access to ioreg.  A status index of TEST_STATUS_COUNT is the memory map.
+struct StatusChange {
+    uint8_t ioreg;
+    uint8_t panel;
+    uint8_t status;
+    uint32_t value;
+};
+
+struct RegisterExpected {
+    uint8_t reads[4];
+    uint8_t mega2;
+    uint8_t logs;
+};
+
+static ClemensMMIO mmio;
+static ClemensMachine machine;
+static struct ClemensTimeSpec tspec;
+
+static uint8_t e0_bank[64 * 1024];
+static uint8_t e1_bank[64 * 1024];
+static uint8_t slot_expansion_rom[CLEM_CARD_SLOT_COUNT * 2048];
+
+static struct RegisterTrace trace;
+static unsigned trace_access;
+
+static const uint8_t kStatusRegisters[TEST_STATUS_COUNT] = {
+    CLEM_MMIO_REG_LC_BANK_TEST,      CLEM_MMIO_REG_ROM_RAM_TEST,      CLEM_MMIO_REG_RAMRD_TEST,
+    CLEM_MMIO_REG_RAMWRT_TEST,       CLEM_MMIO_REG_READCXROM,         CLEM_MMIO_REG_RDALTZP_TEST,
+    CLEM_MMIO_REG_READC3ROM,         CLEM_MMIO_REG_80COLSTORE_TEST,   CLEM_MMIO_REG_TXT_TEST,
+    CLEM_MMIO_REG_MIXED_TEST,        CLEM_MMIO_REG_TXTPAGE2_TEST,     CLEM_MMIO_REG_HIRES_TEST,
+    CLEM_MMIO_REG_ALTCHARSET_TEST,   CLEM_MMIO_REG_80COLUMN_TEST,     CLEM_MMIO_REG_VGC_IRQ_BYTE,
+    CLEM_MMIO_REG_ADB_STATUS,        CLEM_MMIO_REG_NEWVIDEO,          CLEM_MMIO_REG_LANGSEL,
+    CLEM_MMIO_REG_SLOTROMSEL,        CLEM_MMIO_REG_RTC_CTL,           CLEM_MMIO_REG_SHADOW,
+    CLEM_MMIO_REG_SPEED,             CLEM_MMIO_REG_MEGA2_INTEN,       CLEM_MMIO_REG_DIAG_INTTYPE,
+    CLEM_MMIO_REG_STATEREG};
+
+static const char *const kPanelNames[TEST_PANEL_COUNT] = {
+    "the reads", "write 0", "write 1", "write 2", "write 3", "the final reads"};
+
+static const uint8_t kWriteValues[] = {0x00, 0xff, 0x5a, 0xa5};
+
+//  NEWVIDEO asserts on bits that aren't emulated
+#define TEST_NEWVIDEO_WRITE_MASK 0xc1
+
+//  The ADB GLU accepts a command and then only the data bytes it expects before
+//  the microcontroller runs the command.  SET_CONFIG takes three.
+#define TEST_ADB_CMD_SET_CONFIG 0x06
+
+//  Recorded from the switch statement dispatch
+static const uint8_t kResetStatus[TEST_STATUS_COUNT] = {
+    0x80, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x80,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+    0x00, 0x00, 0x08, 0xc0, 0x00, 0x00, 0x0d};
+
+static const uint32_t kResetMMap = 0x01000600;
+
+static const struct RegisterExpected kExpectedRegisters[256] = {
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C000
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C001
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C002
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C003
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C004
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C005
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C006
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C007
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C008
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C009
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C00A
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C00B
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C00C
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C00D
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C00E
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C00F
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C010
+    {{0x80, 0x80, 0x80, 0x80}, 0xff, 0}, // C011
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C012
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C013
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C014
+    {{0x80, 0x80, 0x80, 0x80}, 0xff, 0}, // C015
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C016
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C017
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C018
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C019
+    {{0x80, 0x80, 0x80, 0x80}, 0xff, 0}, // C01A
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C01B
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C01C
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C01D
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C01E
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C01F
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 8}, // C020
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 6}, // C021
+    {{0xf6, 0xf6, 0xa5, 0xa5}, 0xff, 0}, // C022
+    {{0x00, 0x00, 0x04, 0x04}, 0xff, 0}, // C023
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 4}, // C024
+    {{0x20, 0x20, 0x20, 0x20}, 0xff, 4}, // C025
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 3}, // C026
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 2}, // C027
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C028
+    {{0x01, 0x01, 0x81, 0x81}, 0xff, 5}, // C029
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C02A
+    {{0x00, 0x00, 0xa0, 0xa0}, 0xff, 0}, // C02B
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C02C
+    {{0x00, 0x00, 0xa4, 0xa4}, 0x3c, 0}, // C02D
+    {{0x7d, 0x7d, 0x7e, 0x7e}, 0xff, 8}, // C02E
+    {{0x00, 0x40, 0x40, 0x41}, 0xff, 8}, // C02F
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C030
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 5}, // C031
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C032
+    {{0x00, 0x00, 0xa5, 0xa5}, 0xff, 0}, // C033
+    {{0x00, 0x00, 0x25, 0x25}, 0xff, 1}, // C034
+    {{0x08, 0x08, 0x25, 0x25}, 0x00, 0}, // C035
+    {{0xc0, 0xc0, 0x85, 0x85}, 0x00, 3}, // C036
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C037
+    {{0x00, 0x44, 0x44, 0x44}, 0xff, 2}, // C038
+    {{0x00, 0x44, 0x44, 0x44}, 0xff, 2}, // C039
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 7}, // C03A
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 7}, // C03B
+    {{0x00, 0x00, 0x25, 0x25}, 0xff, 0}, // C03C
+    {{0x00, 0x00, 0xa5, 0xa5}, 0xff, 0}, // C03D
+    {{0x00, 0x00, 0xa5, 0xa5}, 0xff, 0}, // C03E
+    {{0x00, 0x00, 0xa5, 0xa5}, 0xff, 0}, // C03F
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C040
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 6}, // C041
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C042
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C043
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 11}, // C044
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 11}, // C045
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C046
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C047
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C048
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C049
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C04A
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C04B
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C04C
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C04D
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C04E
+    {{0x00, 0x00, 0xce, 0x01}, 0xff, 0}, // C04F
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C050
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C051
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C052
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C053
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C054
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C055
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C056
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C057
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 4}, // C058
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 4}, // C059
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 4}, // C05A
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 4}, // C05B
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 4}, // C05C
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 4}, // C05D
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 4}, // C05E
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 4}, // C05F
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 8}, // C060
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 8}, // C061
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 8}, // C062
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 8}, // C063
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 4}, // C064
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 4}, // C065
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 4}, // C066
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 4}, // C067
+    {{0x0d, 0x0d, 0xa5, 0xa5}, 0x00, 2}, // C068
+    {{0x00, 0x00, 0x00, 0x00}, 0x00, 0}, // C069
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C06A
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C06B
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C06C
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C06D
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C06E
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 14}, // C06F
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C070
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C071
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C072
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C073
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C074
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C075
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C076
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C077
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C078
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C079
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C07A
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C07B
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C07C
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C07D
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C07E
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 10}, // C07F
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C080
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C081
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C082
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C083
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C084
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C085
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C086
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C087
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C088
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C089
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C08A
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C08B
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C08C
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C08D
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C08E
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C08F
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C090
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C091
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C092
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C093
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C094
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C095
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C096
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C097
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C098
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C099
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C09A
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C09B
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C09C
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C09D
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C09E
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C09F
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0A0
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0A1
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0A2
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0A3
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0A4
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0A5
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0A6
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0A7
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0A8
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0A9
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0AA
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0AB
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0AC
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0AD
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0AE
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0AF
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0B0
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0B1
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0B2
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0B3
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0B4
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0B5
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0B6
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0B7
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0B8
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0B9
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0BA
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0BB
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0BC
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0BD
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0BE
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0BF
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0C0
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0C1
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0C2
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0C3
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0C4
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0C5
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0C6
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0C7
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0C8
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0C9
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0CA
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0CB
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0CC
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0CD
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0CE
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0CF
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0D0
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0D1
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0D2
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0D3
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0D4
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0D5
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0D6
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0D7
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0D8
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0D9
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0DA
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0DB
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0DC
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0DD
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0DE
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0DF
+    {{0xff, 0xff, 0xff, 0xff}, 0xff, 0}, // C0E0
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0E1
+    {{0xff, 0xff, 0xff, 0xff}, 0xff, 0}, // C0E2
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0E3
+    {{0xff, 0xff, 0xff, 0xff}, 0xff, 0}, // C0E4
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0E5
+    {{0xff, 0xff, 0xff, 0xff}, 0xff, 0}, // C0E6
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0E7
+    {{0xff, 0xff, 0xff, 0xff}, 0xff, 0}, // C0E8
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 1}, // C0E9
+    {{0xff, 0xff, 0xff, 0xff}, 0xff, 0}, // C0EA
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0EB
+    {{0xff, 0xff, 0xff, 0xff}, 0xff, 0}, // C0EC
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0ED
+    {{0xff, 0xff, 0xff, 0xff}, 0xff, 0}, // C0EE
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0EF
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0F0
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0F1
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0F2
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0F3
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0F4
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0F5
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0F6
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0F7
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0F8
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0F9
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0FA
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0FB
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0FC
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0FD
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0FE
+    {{0x00, 0x00, 0x00, 0x00}, 0xff, 0}, // C0FF
+};
+
+static const struct StatusChange kExpectedStatusChanges[] = {
+    {0x01, 1, 7, 0x80}, {0x01, 1, 25, 0x01000608}, {0x01, 2, 7, 0x80},
+    {0x01, 2, 25, 0x01000608}, {0x01, 3, 7, 0x80}, {0x01, 3, 25, 0x01000608},
+    {0x01, 4, 7, 0x80}, {0x01, 4, 25, 0x01000608}, {0x01, 5, 7, 0x80},
+    {0x01, 5, 25, 0x01000608}, {0x03, 1, 2, 0x80}, {0x03, 1, 24, 0x2d},
+    {0x03, 1, 25, 0x01000602}, {0x03, 2, 2, 0x80}, {0x03, 2, 24, 0x2d},
+    {0x03, 2, 25, 0x01000602}, {0x03, 3, 2, 0x80}, {0x03, 3, 24, 0x2d},
+    {0x03, 3, 25, 0x01000602}, {0x03, 4, 2, 0x80}, {0x03, 4, 24, 0x2d},
+    {0x03, 4, 25, 0x01000602}, {0x03, 5, 2, 0x80}, {0x03, 5, 24, 0x2d},
+    {0x03, 5, 25, 0x01000602}, {0x05, 1, 3, 0x80}, {0x05, 1, 24, 0x1d},
+    {0x05, 1, 25, 0x01000604}, {0x05, 2, 3, 0x80}, {0x05, 2, 24, 0x1d},
+    {0x05, 2, 25, 0x01000604}, {0x05, 3, 3, 0x80}, {0x05, 3, 24, 0x1d},
+    {0x05, 3, 25, 0x01000604}, {0x05, 4, 3, 0x80}, {0x05, 4, 24, 0x1d},
+    {0x05, 4, 25, 0x01000604}, {0x05, 5, 3, 0x80}, {0x05, 5, 24, 0x1d},
+    {0x05, 5, 25, 0x01000604}, {0x06, 1, 4, 0x00}, {0x06, 1, 24, 0x0c},
+    {0x06, 1, 25, 0x01080600}, {0x06, 2, 4, 0x00}, {0x06, 2, 24, 0x0c},
+    {0x06, 2, 25, 0x01080600}, {0x06, 3, 4, 0x00}, {0x06, 3, 24, 0x0c},
+    {0x06, 3, 25, 0x01080600}, {0x06, 4, 4, 0x00}, {0x06, 4, 24, 0x0c},
+    {0x06, 4, 25, 0x01080600}, {0x06, 5, 4, 0x00}, {0x06, 5, 24, 0x0c},
+    {0x06, 5, 25, 0x01080600}, {0x09, 1, 5, 0x80}, {0x09, 1, 24, 0x8d},
+    {0x09, 1, 25, 0x01000601}, {0x09, 2, 5, 0x80}, {0x09, 2, 24, 0x8d},
+    {0x09, 2, 25, 0x01000601}, {0x09, 3, 5, 0x80}, {0x09, 3, 24, 0x8d},
+    {0x09, 3, 25, 0x01000601}, {0x09, 4, 5, 0x80}, {0x09, 4, 24, 0x8d},
+    {0x09, 4, 25, 0x01000601}, {0x09, 5, 5, 0x80}, {0x09, 5, 24, 0x8d},
+    {0x09, 5, 25, 0x01000601}, {0x0b, 1, 6, 0x80}, {0x0b, 1, 25, 0x01004600},
+    {0x0b, 2, 6, 0x80}, {0x0b, 2, 25, 0x01004600}, {0x0b, 3, 6, 0x80},
+    {0x0b, 3, 25, 0x01004600}, {0x0b, 4, 6, 0x80}, {0x0b, 4, 25, 0x01004600},
+    {0x0b, 5, 6, 0x80}, {0x0b, 5, 25, 0x01004600}, {0x0d, 1, 13, 0x80},
+    {0x0d, 2, 13, 0x80}, {0x0d, 3, 13, 0x80}, {0x0d, 4, 13, 0x80},
+    {0x0d, 5, 13, 0x80}, {0x0f, 1, 12, 0x80}, {0x0f, 2, 12, 0x80},
+    {0x0f, 3, 12, 0x80}, {0x0f, 4, 12, 0x80}, {0x0f, 5, 12, 0x80},
+    {0x23, 2, 14, 0x06}, {0x23, 3, 14, 0x02}, {0x23, 4, 14, 0x04},
+    {0x23, 5, 14, 0x04}, {0x24, 0, 15, 0x02}, {0x24, 1, 15, 0x02},
+    {0x24, 2, 15, 0x02}, {0x24, 3, 15, 0x02}, {0x24, 4, 15, 0x02},
+    {0x24, 5, 15, 0x02}, {0x26, 1, 15, 0x01}, {0x26, 2, 15, 0x01},
+    {0x26, 3, 15, 0x01}, {0x26, 4, 15, 0x01}, {0x26, 5, 15, 0x01},
+    {0x27, 2, 15, 0x50}, {0x27, 3, 15, 0x50}, {0x29, 1, 16, 0x00},
+    {0x29, 2, 16, 0xc1}, {0x29, 3, 16, 0x40}, {0x29, 4, 16, 0x81},
+    {0x29, 5, 16, 0x81}, {0x2b, 2, 17, 0xf8}, {0x2b, 3, 17, 0x58},
+    {0x2b, 4, 17, 0xa0}, {0x2b, 5, 17, 0xa0}, {0x2d, 2, 18, 0xf6},
+    {0x2d, 2, 25, 0x0107b600}, {0x2d, 3, 18, 0x52}, {0x2d, 3, 25, 0x01029600},
+    {0x2d, 4, 18, 0xa4}, {0x2d, 4, 25, 0x01052600}, {0x2d, 5, 18, 0xa4},
+    {0x2d, 5, 25, 0x01052600}, {0x34, 2, 19, 0x7f}, {0x34, 3, 19, 0x5a},
+    {0x34, 4, 19, 0x25}, {0x34, 5, 19, 0x25}, {0x35, 1, 20, 0x00},
+    {0x35, 1, 25, 0x00000600}, {0x35, 2, 20, 0x7f}, {0x35, 2, 25, 0x07f00600},
+    {0x35, 3, 20, 0x5a}, {0x35, 3, 25, 0x07400600}, {0x35, 4, 20, 0x25},
+    {0x35, 4, 25, 0x00b00600}, {0x35, 5, 20, 0x25}, {0x35, 5, 25, 0x00b00600},
+    {0x36, 1, 21, 0x00}, {0x36, 2, 21, 0xdf}, {0x36, 3, 21, 0x5a},
+    {0x36, 4, 21, 0x85}, {0x36, 5, 21, 0x85}, {0x41, 2, 22, 0x18},
+    {0x41, 3, 22, 0x18}, {0x50, 0, 8, 0x00}, {0x50, 1, 8, 0x00},
+    {0x50, 2, 8, 0x00}, {0x50, 3, 8, 0x00}, {0x50, 4, 8, 0x00},
+    {0x50, 5, 8, 0x00}, {0x53, 0, 9, 0x80}, {0x53, 1, 9, 0x80},
+    {0x53, 2, 9, 0x80}, {0x53, 3, 9, 0x80}, {0x53, 4, 9, 0x80},
+    {0x53, 5, 9, 0x80}, {0x55, 0, 10, 0x80}, {0x55, 0, 24, 0x4d},
+    {0x55, 0, 25, 0x01000610}, {0x55, 1, 10, 0x80}, {0x55, 1, 24, 0x4d},
+    {0x55, 1, 25, 0x01000610}, {0x55, 2, 10, 0x80}, {0x55, 2, 24, 0x4d},
+    {0x55, 2, 25, 0x01000610}, {0x55, 3, 10, 0x80}, {0x55, 3, 24, 0x4d},
+    {0x55, 3, 25, 0x01000610}, {0x55, 4, 10, 0x80}, {0x55, 4, 24, 0x4d},
+    {0x55, 4, 25, 0x01000610}, {0x55, 5, 10, 0x80}, {0x55, 5, 24, 0x4d},
+    {0x55, 5, 25, 0x01000610}, {0x57, 0, 11, 0x80}, {0x57, 1, 11, 0x80},
+    {0x57, 2, 11, 0x80}, {0x57, 3, 11, 0x80}, {0x57, 4, 11, 0x80},
+    {0x57, 5, 11, 0x80}, {0x68, 1, 0, 0x00}, {0x68, 1, 1, 0x80},
+    {0x68, 1, 4, 0x00}, {0x68, 1, 24, 0x00}, {0x68, 1, 25, 0x01080300},
+    {0x68, 2, 2, 0x80}, {0x68, 2, 3, 0x80}, {0x68, 2, 5, 0x80},
+    {0x68, 2, 10, 0x80}, {0x68, 2, 24, 0xfd}, {0x68, 2, 25, 0x01000617},
+    {0x68, 3, 0, 0x00}, {0x68, 3, 3, 0x80}, {0x68, 3, 4, 0x00},
+    {0x68, 3, 10, 0x80}, {0x68, 3, 24, 0x58}, {0x68, 3, 25, 0x01080214},
+    {0x68, 4, 1, 0x80}, {0x68, 4, 2, 0x80}, {0x68, 4, 5, 0x80},
+    {0x68, 4, 24, 0xa5}, {0x68, 4, 25, 0x01000703}, {0x68, 5, 1, 0x80},
+    {0x68, 5, 2, 0x80}, {0x68, 5, 5, 0x80}, {0x68, 5, 24, 0xa5},
+    {0x68, 5, 25, 0x01000703}, {0x80, 0, 1, 0x80}, {0x80, 0, 24, 0x05},
+    {0x80, 0, 25, 0x01000700}, {0x80, 1, 1, 0x80}, {0x80, 1, 24, 0x05},
+    {0x80, 1, 25, 0x01000700}, {0x80, 2, 1, 0x80}, {0x80, 2, 24, 0x05},
+    {0x80, 2, 25, 0x01000700}, {0x80, 3, 1, 0x80}, {0x80, 3, 24, 0x05},
+    {0x80, 3, 25, 0x01000700}, {0x80, 4, 1, 0x80}, {0x80, 4, 24, 0x05},
+    {0x80, 4, 25, 0x01000700}, {0x80, 5, 1, 0x80}, {0x80, 5, 24, 0x05},
+    {0x80, 5, 25, 0x01000700}, {0x83, 0, 1, 0x80}, {0x83, 0, 24, 0x05},
+    {0x83, 0, 25, 0x01000700}, {0x83, 1, 1, 0x80}, {0x83, 1, 24, 0x05},
+    {0x83, 1, 25, 0x01000700}, {0x83, 2, 1, 0x80}, {0x83, 2, 24, 0x05},
+    {0x83, 2, 25, 0x01000700}, {0x83, 3, 1, 0x80}, {0x83, 3, 24, 0x05},
+    {0x83, 3, 25, 0x01000700}, {0x83, 4, 1, 0x80}, {0x83, 4, 24, 0x05},
+    {0x83, 4, 25, 0x01000700}, {0x83, 5, 1, 0x80}, {0x83, 5, 24, 0x05},
+    {0x83, 5, 25, 0x01000700}, {0x84, 0, 1, 0x80}, {0x84, 0, 24, 0x05},
+    {0x84, 0, 25, 0x01000700}, {0x84, 1, 1, 0x80}, {0x84, 1, 24, 0x05},
+    {0x84, 1, 25, 0x01000700}, {0x84, 2, 1, 0x80}, {0x84, 2, 24, 0x05},
+    {0x84, 2, 25, 0x01000700}, {0x84, 3, 1, 0x80}, {0x84, 3, 24, 0x05},
+    {0x84, 3, 25, 0x01000700}, {0x84, 4, 1, 0x80}, {0x84, 4, 24, 0x05},
+    {0x84, 4, 25, 0x01000700}, {0x84, 5, 1, 0x80}, {0x84, 5, 24, 0x05},
+    {0x84, 5, 25, 0x01000700}, {0x87, 0, 1, 0x80}, {0x87, 0, 24, 0x05},
+    {0x87, 0, 25, 0x01000700}, {0x87, 1, 1, 0x80}, {0x87, 1, 24, 0x05},
+    {0x87, 1, 25, 0x01000700}, {0x87, 2, 1, 0x80}, {0x87, 2, 24, 0x05},
+    {0x87, 2, 25, 0x01000700}, {0x87, 3, 1, 0x80}, {0x87, 3, 24, 0x05},
+    {0x87, 3, 25, 0x01000700}, {0x87, 4, 1, 0x80}, {0x87, 4, 24, 0x05},
+    {0x87, 4, 25, 0x01000700}, {0x87, 5, 1, 0x80}, {0x87, 5, 24, 0x05},
+    {0x87, 5, 25, 0x01000700}, {0x88, 0, 0, 0x00}, {0x88, 0, 1, 0x80},
+    {0x88, 0, 24, 0x01}, {0x88, 0, 25, 0x01000300}, {0x88, 1, 0, 0x00},
+    {0x88, 1, 1, 0x80}, {0x88, 1, 24, 0x01}, {0x88, 1, 25, 0x01000300},
+    {0x88, 2, 0, 0x00}, {0x88, 2, 1, 0x80}, {0x88, 2, 24, 0x01},
+    {0x88, 2, 25, 0x01000300}, {0x88, 3, 0, 0x00}, {0x88, 3, 1, 0x80},
+    {0x88, 3, 24, 0x01}, {0x88, 3, 25, 0x01000300}, {0x88, 4, 0, 0x00},
+    {0x88, 4, 1, 0x80}, {0x88, 4, 24, 0x01}, {0x88, 4, 25, 0x01000300},
+    {0x88, 5, 0, 0x00}, {0x88, 5, 1, 0x80}, {0x88, 5, 24, 0x01},
+    {0x88, 5, 25, 0x01000300}, {0x89, 0, 0, 0x00}, {0x89, 0, 24, 0x09},
+    {0x89, 0, 25, 0x01000200}, {0x89, 1, 0, 0x00}, {0x89, 1, 24, 0x09},
+    {0x89, 1, 25, 0x01000200}, {0x89, 2, 0, 0x00}, {0x89, 2, 24, 0x09},
+    {0x89, 2, 25, 0x01000200}, {0x89, 3, 0, 0x00}, {0x89, 3, 24, 0x09},
+    {0x89, 3, 25, 0x01000200}, {0x89, 4, 0, 0x00}, {0x89, 4, 24, 0x09},
+    {0x89, 4, 25, 0x01000200}, {0x89, 5, 0, 0x00}, {0x89, 5, 24, 0x09},
+    {0x89, 5, 25, 0x01000200}, {0x8a, 0, 0, 0x00}, {0x8a, 0, 24, 0x09},
+    {0x8a, 0, 25, 0x01000200}, {0x8a, 1, 0, 0x00}, {0x8a, 1, 24, 0x09},
+    {0x8a, 1, 25, 0x01000200}, {0x8a, 2, 0, 0x00}, {0x8a, 2, 24, 0x09},
+    {0x8a, 2, 25, 0x01000200}, {0x8a, 3, 0, 0x00}, {0x8a, 3, 24, 0x09},
+    {0x8a, 3, 25, 0x01000200}, {0x8a, 4, 0, 0x00}, {0x8a, 4, 24, 0x09},
+    {0x8a, 4, 25, 0x01000200}, {0x8a, 5, 0, 0x00}, {0x8a, 5, 24, 0x09},
+    {0x8a, 5, 25, 0x01000200}, {0x8b, 0, 0, 0x00}, {0x8b, 0, 1, 0x80},
+    {0x8b, 0, 24, 0x01}, {0x8b, 0, 25, 0x01000300}, {0x8b, 1, 0, 0x00},
+    {0x8b, 1, 1, 0x80}, {0x8b, 1, 24, 0x01}, {0x8b, 1, 25, 0x01000300},
+    {0x8b, 2, 0, 0x00}, {0x8b, 2, 1, 0x80}, {0x8b, 2, 24, 0x01},
+    {0x8b, 2, 25, 0x01000300}, {0x8b, 3, 0, 0x00}, {0x8b, 3, 1, 0x80},
+    {0x8b, 3, 24, 0x01}, {0x8b, 3, 25, 0x01000300}, {0x8b, 4, 0, 0x00},
+    {0x8b, 4, 1, 0x80}, {0x8b, 4, 24, 0x01}, {0x8b, 4, 25, 0x01000300},
+    {0x8b, 5, 0, 0x00}, {0x8b, 5, 1, 0x80}, {0x8b, 5, 24, 0x01},
+    {0x8b, 5, 25, 0x01000300}, {0x8c, 0, 0, 0x00}, {0x8c, 0, 1, 0x80},
+    {0x8c, 0, 24, 0x01}, {0x8c, 0, 25, 0x01000300}, {0x8c, 1, 0, 0x00},
+    {0x8c, 1, 1, 0x80}, {0x8c, 1, 24, 0x01}, {0x8c, 1, 25, 0x01000300},
+    {0x8c, 2, 0, 0x00}, {0x8c, 2, 1, 0x80}, {0x8c, 2, 24, 0x01},
+    {0x8c, 2, 25, 0x01000300}, {0x8c, 3, 0, 0x00}, {0x8c, 3, 1, 0x80},
+    {0x8c, 3, 24, 0x01}, {0x8c, 3, 25, 0x01000300}, {0x8c, 4, 0, 0x00},
+    {0x8c, 4, 1, 0x80}, {0x8c, 4, 24, 0x01}, {0x8c, 4, 25, 0x01000300},
+    {0x8c, 5, 0, 0x00}, {0x8c, 5, 1, 0x80}, {0x8c, 5, 24, 0x01},
+    {0x8c, 5, 25, 0x01000300}, {0x8d, 0, 0, 0x00}, {0x8d, 0, 24, 0x09},
+    {0x8d, 0, 25, 0x01000200}, {0x8d, 1, 0, 0x00}, {0x8d, 1, 24, 0x09},
+    {0x8d, 1, 25, 0x01000200}, {0x8d, 2, 0, 0x00}, {0x8d, 2, 24, 0x09},
+    {0x8d, 2, 25, 0x01000200}, {0x8d, 3, 0, 0x00}, {0x8d, 3, 24, 0x09},
+    {0x8d, 3, 25, 0x01000200}, {0x8d, 4, 0, 0x00}, {0x8d, 4, 24, 0x09},
+    {0x8d, 4, 25, 0x01000200}, {0x8d, 5, 0, 0x00}, {0x8d, 5, 24, 0x09},
+    {0x8d, 5, 25, 0x01000200}, {0x8e, 0, 0, 0x00}, {0x8e, 0, 24, 0x09},
+    {0x8e, 0, 25, 0x01000200}, {0x8e, 1, 0, 0x00}, {0x8e, 1, 24, 0x09},
+    {0x8e, 1, 25, 0x01000200}, {0x8e, 2, 0, 0x00}, {0x8e, 2, 24, 0x09},
+    {0x8e, 2, 25, 0x01000200}, {0x8e, 3, 0, 0x00}, {0x8e, 3, 24, 0x09},
+    {0x8e, 3, 25, 0x01000200}, {0x8e, 4, 0, 0x00}, {0x8e, 4, 24, 0x09},
+    {0x8e, 4, 25, 0x01000200}, {0x8e, 5, 0, 0x00}, {0x8e, 5, 24, 0x09},
+    {0x8e, 5, 25, 0x01000200}, {0x8f, 0, 0, 0x00}, {0x8f, 0, 1, 0x80},
+    {0x8f, 0, 24, 0x01}, {0x8f, 0, 25, 0x01000300}, {0x8f, 1, 0, 0x00},
+    {0x8f, 1, 1, 0x80}, {0x8f, 1, 24, 0x01}, {0x8f, 1, 25, 0x01000300},
+    {0x8f, 2, 0, 0x00}, {0x8f, 2, 1, 0x80}, {0x8f, 2, 24, 0x01},
+    {0x8f, 2, 25, 0x01000300}, {0x8f, 3, 0, 0x00}, {0x8f, 3, 1, 0x80},
+    {0x8f, 3, 24, 0x01}, {0x8f, 3, 25, 0x01000300}, {0x8f, 4, 0, 0x00},
+    {0x8f, 4, 1, 0x80}, {0x8f, 4, 24, 0x01}, {0x8f, 4, 25, 0x01000300},
+    {0x8f, 5, 0, 0x00}, {0x8f, 5, 1, 0x80}, {0x8f, 5, 24, 0x01},
+    {0x8f, 5, 25, 0x01000300},
+};
+
+static void fixture_log(int level, ClemensMachine *clem, const char *msg) {
+    (void)level;
+    (void)clem;
+    (void)msg;
+    ++trace.logs;
+}
+
+static void fixture_reset(void) {
+    tspec.clocks_spent = 0;
+    tspec.clocks_step_fast = CLEM_CLOCKS_PHI2_FAST_CYCLE;
+    tspec.clocks_step = CLEM_CLOCKS_PHI0_CYCLE;
+
+    memset(&machine, 0, sizeof(machine));
+    memset(&mmio, 0, sizeof(mmio));
+    memset(e0_bank, 0, sizeof(e0_bank));
+    memset(e1_bank, 0, sizeof(e1_bank));
+    memset(&trace, 0, sizeof(trace));
+    trace_access = 0;
+    machine.logger_fn = &fixture_log;
+    machine.mem.mega2_bank_map[0] = e0_bank;
+    machine.mem.mega2_bank_map[1] = e1_bank;
+    clem_debug_context(&machine);
+    clem_mmio_init(&mmio, &machine.dev_debug, machine.mem.bank_page_map, slot_expansion_rom, 4,
+                   2, e0_bank, e1_bank, &tspec);
+}
+
+static uint8_t fixture_read_status(uint8_t ioreg) {
+    bool mega2_access = false;
+    uint8_t data = clem_mmio_read(&mmio, &tspec, CLEM_MMIO_MAKE_IO_ADDRESS(ioreg), 0,
+                                  &mega2_access);
+    tspec.clocks_spent += tspec.clocks_step;
+    return data;
+}
+
+static uint8_t fixture_read(uint8_t ioreg, uint8_t flags) {
+    bool mega2_access = false;
+    uint8_t data = clem_mmio_read(&mmio, &tspec, CLEM_MMIO_MAKE_IO_ADDRESS(ioreg), flags,
+                                  &mega2_access);
+    if (mega2_access) {
+        trace.mega2 |= (uint8_t)(1 << trace_access);
+    }
+    ++trace_access;
+    tspec.clocks_spent += tspec.clocks_step;
+    return data;
+}
+
+static void fixture_write(uint8_t ioreg, uint8_t data) {
+    bool mega2_access = false;
+    clem_mmio_write(&mmio, &tspec, data, CLEM_MMIO_MAKE_IO_ADDRESS(ioreg), 0, &mega2_access);
+    if (mega2_access) {
+        trace.mega2 |= (uint8_t)(1 << trace_access);
+    }
+    ++trace_access;
+    tspec.clocks_spent += tspec.clocks_step;
+}
+
+static void fixture_status(unsigned panel) {
+    unsigned i;
+    for (i = 0; i < TEST_STATUS_COUNT; ++i) {
+        trace.status[panel][i] = fixture_read_status(kStatusRegisters[i]);
+    }
+    trace.mmap[panel] = mmio.mmap_register;
+}
+
+static uint8_t fixture_write_value(uint8_t ioreg, unsigned index) {
+    if (ioreg == CLEM_MMIO_REG_NEWVIDEO)
+        return kWriteValues[index] & TEST_NEWVIDEO_WRITE_MASK;
+    if (ioreg == CLEM_MMIO_REG_ADB_CMD_DATA && index == 0)
+        return TEST_ADB_CMD_SET_CONFIG;
+    return kWriteValues[index];
+}
+
+static void fixture_trace_register(uint8_t ioreg) {
+    unsigned i;
+    fixture_reset();
+    trace.reads[0] = fixture_read(ioreg, CLEM_OP_IO_NO_OP);
+    trace.reads[1] = fixture_read(ioreg, 0);
+    fixture_status(0);
+    for (i = 0; i < sizeof(kWriteValues); ++i) {
+        fixture_write(ioreg, fixture_write_value(ioreg, i));
+        fixture_status(i + 1);
+    }
+    trace.reads[2] = fixture_read(ioreg, 0);
+    trace.reads[3] = fixture_read(ioreg, 0);
+    fixture_status(TEST_PANEL_COUNT - 1);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_clem_mmio_io_registers_reset_status(void) {
+    char msg[64];
+    unsigned i;
+    fixture_reset();
+    fixture_status(0);
+    for (i = 0; i < TEST_STATUS_COUNT; ++i) {
+        snprintf(msg, sizeof(msg), "status C0%02X", kStatusRegisters[i]);
+        TEST_ASSERT_EQUAL_HEX8_MESSAGE(kResetStatus[i], trace.status[0][i], msg);
+    }
+    TEST_ASSERT_EQUAL_HEX32_MESSAGE(kResetMMap, trace.mmap[0], "memory map");
+}
+
+void test_clem_mmio_io_registers_match_switch_dispatch(void) {
+    static const char *const kReadNames[4] = {"no-op read", "read", "first final read",
+                                              "second final read"};
+    uint8_t status[TEST_PANEL_COUNT][TEST_STATUS_COUNT];
+    uint32_t mmap[TEST_PANEL_COUNT];
+    const struct RegisterExpected *expected;
+    const struct StatusChange *change;
+    unsigned ioreg, panel, i;
+    char msg[96];
+
+    for (ioreg = 0; ioreg < 256; ++ioreg) {
+        fixture_trace_register((uint8_t)ioreg);
+        expected = &kExpectedRegisters[ioreg];
+        for (i = 0; i < 4; ++i) {
+            snprintf(msg, sizeof(msg), "C0%02X %s", ioreg, kReadNames[i]);
+            TEST_ASSERT_EQUAL_HEX8_MESSAGE(expected->reads[i], trace.reads[i], msg);
+        }
+        snprintf(msg, sizeof(msg), "C0%02X Mega II accesses", ioreg);
+        TEST_ASSERT_EQUAL_HEX8_MESSAGE(expected->mega2, trace.mega2, msg);
+        snprintf(msg, sizeof(msg), "C0%02X messages logged", ioreg);
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected->logs, trace.logs, msg);
+
+        for (panel = 0; panel < TEST_PANEL_COUNT; ++panel) {
+            memcpy(status[panel], kResetStatus, sizeof(kResetStatus));
+            mmap[panel] = kResetMMap;
+        }
+        for (i = 0; i < sizeof(kExpectedStatusChanges) / sizeof(kExpectedStatusChanges[0]);
+             ++i) {
+            change = &kExpectedStatusChanges[i];
+            if (change->ioreg != ioreg)
+                continue;
+            if (change->status < TEST_STATUS_COUNT) {
+                status[change->panel][change->status] = (uint8_t)change->value;
+            } else {
+                mmap[change->panel] = change->value;
+            }
+        }
+        for (panel = 0; panel < TEST_PANEL_COUNT; ++panel) {
+            for (i = 0; i < TEST_STATUS_COUNT; ++i) {
+                snprintf(msg, sizeof(msg), "C0%02X after %s, status C0%02X", ioreg,
+                         kPanelNames[panel], kStatusRegisters[i]);
+                TEST_ASSERT_EQUAL_HEX8_MESSAGE(status[panel][i], trace.status[panel][i], msg);
+            }
+            snprintf(msg, sizeof(msg), "C0%02X after %s, memory map", ioreg,
+                     kPanelNames[panel]);
+            TEST_ASSERT_EQUAL_HEX32_MESSAGE(mmap[panel], trace.mmap[panel], msg);
+        }
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_clem_mmio_io_registers_reset_status);
+    RUN_TEST(test_clem_mmio_io_registers_match_switch_dispatch);
+    return UNITY_END();
+}
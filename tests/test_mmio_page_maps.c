@@ -0,0 +1,133 @@
+#include "clem_types.h"
+#include "unity.h"
+
+#include "clem_mmio.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//  Soft switch changes install page map sets built incrementally from the
+//  previous state, or reuse a set built earlier for the same state.  These
+//  must match the maps built from scratch for the same state on a restore.
+
+static ClemensMMIO mmio;
+static ClemensMachine machine;
+static struct ClemensTimeSpec tspec;
+
+static ClemensMMIO ref_mmio;
+static ClemensMachine ref_machine;
+
+static uint8_t e0_bank[64 * 1024];
+static uint8_t e1_bank[64 * 1024];
+static uint8_t slot_expansion_rom[CLEM_CARD_SLOT_COUNT * 2048];
+
+static const uint8_t kMappedBanks[] = {0x00, 0x01, 0xe0, 0xe1};
+
+void setUp(void) {
+    tspec.clocks_spent = 0;
+    tspec.clocks_step_fast = CLEM_CLOCKS_PHI2_FAST_CYCLE;
+    tspec.clocks_step = CLEM_CLOCKS_PHI0_CYCLE;
+
+    memset(&machine, 0, sizeof(machine));
+    memset(&mmio, 0, sizeof(mmio));
+    machine.mem.mega2_bank_map[0] = e0_bank;
+    machine.mem.mega2_bank_map[1] = e1_bank;
+    clem_mmio_init(&mmio, &machine.dev_debug, machine.mem.bank_page_map, slot_expansion_rom, 4,
+                   2, e0_bank, e1_bank, &tspec);
+}
+
+void tearDown(void) {}
+
+static void fixture_check_page_maps(unsigned step) {
+    struct ClemensMemoryPageMap *page_map, *ref_page_map;
+    struct ClemensMemoryPageInfo *page, *ref_page;
+    unsigned bank_idx, page_idx;
+    char msg[64];
+
+    memcpy(&ref_mmio, &mmio, sizeof(ref_mmio));
+    memset(&ref_machine, 0, sizeof(ref_machine));
+    ref_machine.mem.mega2_bank_map[0] = e0_bank;
+    ref_machine.mem.mega2_bank_map[1] = e1_bank;
+    clem_mmio_restore(&ref_machine, &ref_mmio);
+    TEST_ASSERT_EQUAL_HEX32(mmio.mmap_register, ref_mmio.mmap_register);
+
+    for (bank_idx = 0; bank_idx < sizeof(kMappedBanks); ++bank_idx) {
+        page_map = machine.mem.bank_page_map[kMappedBanks[bank_idx]];
+        ref_page_map = ref_machine.mem.bank_page_map[kMappedBanks[bank_idx]];
+        snprintf(msg, sizeof(msg), "step %u bank %02X", step, kMappedBanks[bank_idx]);
+        TEST_ASSERT_EQUAL_MESSAGE(ref_page_map->shadow_map != NULL, page_map->shadow_map != NULL,
+                                  msg);
+        if (page_map->shadow_map) {
+            TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(ref_page_map->shadow_map->pages,
+                                                 page_map->shadow_map->pages, 256, msg);
+        }
+        for (page_idx = 0; page_idx < 256; ++page_idx) {
+            page = &page_map->pages[page_idx];
+            ref_page = &ref_page_map->pages[page_idx];
+            snprintf(msg, sizeof(msg), "step %u bank %02X page %02X", step,
+                     kMappedBanks[bank_idx], page_idx);
+            TEST_ASSERT_EQUAL_HEX8_MESSAGE(ref_page->read, page->read, msg);
+            TEST_ASSERT_EQUAL_HEX8_MESSAGE(ref_page->write, page->write, msg);
+            TEST_ASSERT_EQUAL_HEX8_MESSAGE(ref_page->bank_read, page->bank_read, msg);
+            TEST_ASSERT_EQUAL_HEX8_MESSAGE(ref_page->bank_write, page->bank_write, msg);
+            TEST_ASSERT_EQUAL_HEX32_MESSAGE(ref_page->flags, page->flags, msg);
+        }
+    }
+}
+
+void test_clem_mmio_page_map_sets_random_switches(void) {
+    //  writes to these switch the mapping state (LC switches are reads)
+    static const uint8_t kWriteSwitches[] = {
+        CLEM_MMIO_REG_80STOREOFF_WRITE, CLEM_MMIO_REG_80STOREON_WRITE, CLEM_MMIO_REG_RDMAINRAM,
+        CLEM_MMIO_REG_RDCARDRAM,        CLEM_MMIO_REG_WRMAINRAM,       CLEM_MMIO_REG_WRCARDRAM,
+        CLEM_MMIO_REG_SLOTCXROM,        CLEM_MMIO_REG_INTCXROM,        CLEM_MMIO_REG_STDZP,
+        CLEM_MMIO_REG_ALTZP,            CLEM_MMIO_REG_INTC3ROM,        CLEM_MMIO_REG_SLOTC3ROM,
+        CLEM_MMIO_REG_TXTPAGE1,         CLEM_MMIO_REG_TXTPAGE2,        CLEM_MMIO_REG_LORES,
+        CLEM_MMIO_REG_HIRES};
+    uint32_t seed = 0x2badcafe;
+    bool mega2_access;
+    unsigned step;
+
+    for (step = 0; step < 4000; ++step) {
+        uint8_t data, ioreg;
+        seed = seed * 1664525 + 1013904223;
+        data = (uint8_t)(seed >> 8);
+        switch ((seed >> 24) % 6) {
+        case 0:
+        case 1:
+            ioreg = kWriteSwitches[(seed >> 16) % sizeof(kWriteSwitches)];
+            clem_mmio_write(&mmio, &tspec, data, CLEM_MMIO_MAKE_IO_ADDRESS(ioreg), 0,
+                            &mega2_access);
+            break;
+        case 2:
+            //  language card switches twice in a row for write enables
+            ioreg = CLEM_MMIO_REG_LC2_RAM_WP + ((seed >> 16) & 0xf);
+            clem_mmio_read(&mmio, &tspec, CLEM_MMIO_MAKE_IO_ADDRESS(ioreg), 0, &mega2_access);
+            if (seed & 0x10000000) {
+                clem_mmio_read(&mmio, &tspec, CLEM_MMIO_MAKE_IO_ADDRESS(ioreg), 0,
+                               &mega2_access);
+            }
+            break;
+        case 3:
+            clem_mmio_write(&mmio, &tspec, data, CLEM_MMIO_MAKE_IO_ADDRESS(CLEM_MMIO_REG_SHADOW),
+                            0, &mega2_access);
+            break;
+        case 4:
+            clem_mmio_write(&mmio, &tspec, data,
+                            CLEM_MMIO_MAKE_IO_ADDRESS(CLEM_MMIO_REG_STATEREG), 0, &mega2_access);
+            break;
+        case 5:
+            clem_mmio_write(&mmio, &tspec, data,
+                            CLEM_MMIO_MAKE_IO_ADDRESS(CLEM_MMIO_REG_SLOTROMSEL), 0,
+                            &mega2_access);
+            break;
+        }
+        fixture_check_page_maps(step);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_clem_mmio_page_map_sets_random_switches);
+    return UNITY_END();
+}